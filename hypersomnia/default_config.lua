@@ -39,12 +39,52 @@ return {
 	num_udp_command_ports = 5,
 
 	sleep_ms = 8,
+	reserialize_once_every_secs = 0.25,
 	server_list_port = 8420,
 
 	cert_pem_path = "",
 	key_pem_path = "",
   },
 
+  spectator_relay = {
+	upstream = {
+	  address = "127.0.0.1",
+	  default_port = 8412
+	},
+
+	ip = "0.0.0.0",
+	port = 8414,
+	max_spectators = 64,
+
+	nickname = "[Relay]",
+	broadcast_delay_secs = 0,
+
+	sleep_ms = 1
+  },
+
+  load_test_swarm = {
+	target = {
+	  address = "127.0.0.1",
+	  default_port = 8412
+	},
+
+	num_clients = 16,
+	duration_secs = 60,
+
+	nickname_prefix = "Bot",
+	seed = 1337,
+
+	report_once_every_secs = 5,
+	sleep_ms = 1,
+
+	disabled_network_simulator = {
+      latency_ms = 50,
+      jitter_ms = 10,
+      loss_percent = 1,
+	  duplicates_percent = 0,
+	}
+  },
+
   float_consistency_test = {
 	  passes = 5000
 	  , report_filename = ""
@@ -660,6 +700,9 @@ return {
     sleep_mult = 0.1,
     log_performance_once_every_secs = 1,
 
+	logic_workers = 0,
+	verify_parallel_solve = false,
+
 	kick_if_no_messages_for_secs = 10,
 	kick_if_away_from_keyboard_for_secs = 180,
 	time_limit_to_enter_game_since_connection = 15,
@@ -677,6 +720,7 @@ return {
 
 	max_buffered_client_commands = 1280,
 	state_hash_once_every_tick = 1,
+	pool_hashes_once_every_tick = 64,
     send_net_statistics_update_once_every_secs = 1,
 
     auto_authorize_loopback_for_rcon = true,
@@ -690,7 +734,7 @@ return {
   },
 
   dedicated_server = {
-
+    num_arenas = 1
   },
 
   client = {
@@ -701,7 +745,9 @@ return {
 	  jitter = {
 	  	buffer_at_least_steps = 3,
 		buffer_at_least_ms = 20,
-		max_commands_to_squash_at_once = 255
+		max_commands_to_squash_at_once = 255,
+		max_adaptive_steps = 4,
+		stretch_catch_up = true
 	  }
 	},
 
@@ -109,6 +109,7 @@ private:
 
 	friend class physics_world_cache;
 	friend class b2DynamicTree;
+	friend class b2World;
 
 	void BufferMove(int32 proxyId);
 	void UnBufferMove(int32 proxyId);
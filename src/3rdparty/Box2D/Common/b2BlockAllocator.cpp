@@ -21,6 +21,8 @@
 #include <climits>
 #include <cstring>
 #include <memory>
+#include <algorithm>
+#include <functional>
 
 #include "augs/build_settings/setting_debug_physics_world_cache_copy.h"
 
@@ -66,6 +68,10 @@ b2BlockAllocator::b2BlockAllocator()
 
 	m_chunkSpace = b2_chunkArrayIncrement;
 	m_chunkCount = 0;
+
+	m_arena = NULL;
+	m_arenaChunkCount = 0;
+	m_largeAllocationCount = 0;
 	m_chunks = (b2Chunk*)b2Alloc(m_chunkSpace * sizeof(b2Chunk));
 
 	memset(m_chunks, 0, m_chunkSpace * sizeof(b2Chunk));
@@ -93,13 +99,30 @@ b2BlockAllocator::b2BlockAllocator()
 }
 
 b2BlockAllocator::~b2BlockAllocator()
+{
+	FreeChunks();
+	b2Free(m_chunks);
+}
+
+bool b2BlockAllocator::IsInArena(const b2Chunk& chunk) const
+{
+	const int8* blocks = (const int8*)chunk.blocks;
+	return m_arena && m_arena <= blocks && blocks < m_arena + m_arenaChunkCount * b2_chunkSize;
+}
+
+void b2BlockAllocator::FreeChunks()
 {
 	for (int32 i = 0; i < m_chunkCount; ++i)
 	{
-		b2Free(m_chunks[i].blocks);
+		if (!IsInArena(m_chunks[i]))
+		{
+			b2Free(m_chunks[i].blocks);
+		}
 	}
 
-	b2Free(m_chunks);
+	b2Free(m_arena);
+	m_arena = NULL;
+	m_arenaChunkCount = 0;
 }
 
 void* b2BlockAllocator::Allocate(int32 size)
@@ -115,6 +138,7 @@ void* b2BlockAllocator::Allocate(int32 size)
 
 	if (size > b2_maxBlockSize)
 	{
+		++m_largeAllocationCount;
 		return b2Alloc(size);
 	}
 
@@ -179,6 +203,7 @@ void b2BlockAllocator::Free(void* p, int32 size)
 
 	if (size > b2_maxBlockSize)
 	{
+		--m_largeAllocationCount;
 		b2Free(p);
 		return;
 	}
@@ -219,13 +244,104 @@ void b2BlockAllocator::Free(void* p, int32 size)
 
 void b2BlockAllocator::Clear()
 {
-	for (int32 i = 0; i < m_chunkCount; ++i)
-	{
-		b2Free(m_chunks[i].blocks);
-	}
+	FreeChunks();
 
 	m_chunkCount = 0;
+	m_largeAllocationCount = 0;
 	memset(m_chunks, 0, m_chunkSpace * sizeof(b2Chunk));
 
 	memset(m_freeLists, 0, sizeof(m_freeLists));
 }
+
+void b2BlockAllocator::CloneFrom(const b2BlockAllocator& source, b2BlockRelocation& relocation)
+{
+	b2Assert(m_chunkCount == 0);
+	b2Assert(source.IsRelocatable());
+
+	relocation.m_ranges.clear();
+
+	const int32 count = source.m_chunkCount;
+
+	if (m_chunkSpace < source.m_chunkSpace)
+	{
+		b2Free(m_chunks);
+		m_chunkSpace = source.m_chunkSpace;
+		m_chunks = (b2Chunk*)b2Alloc(m_chunkSpace * sizeof(b2Chunk));
+	}
+
+	memset(m_chunks, 0, m_chunkSpace * sizeof(b2Chunk));
+
+	if (count > 0)
+	{
+		m_arena = (int8*)b2Alloc(count * b2_chunkSize);
+		m_arenaChunkCount = count;
+	}
+
+	// Lay the chunks out in the order of their source addresses,
+	// so that a contiguous run of source chunks stays contiguous in the arena.
+	memcpy(m_chunks, source.m_chunks, count * sizeof(b2Chunk));
+
+	std::sort(m_chunks, m_chunks + count, [](const b2Chunk& a, const b2Chunk& b) {
+		return std::less<const b2Block*>()(a.blocks, b.blocks);
+	});
+
+	for (int32 i = 0; i < count; ++i)
+	{
+		b2Chunk& chunk = m_chunks[i];
+
+		const int8* sourceBlocks = (const int8*)chunk.blocks;
+		int8* targetBlocks = m_arena + i * b2_chunkSize;
+
+		memcpy(targetBlocks, sourceBlocks, b2_chunkSize);
+		chunk.blocks = (b2Block*)targetBlocks;
+
+		if (!relocation.m_ranges.empty() && relocation.m_ranges.back().sourceEnd == sourceBlocks)
+		{
+			relocation.m_ranges.back().sourceEnd += b2_chunkSize;
+		}
+		else
+		{
+			relocation.m_ranges.push_back({ sourceBlocks, sourceBlocks + b2_chunkSize, targetBlocks });
+		}
+	}
+
+	m_chunkCount = count;
+
+	// The free blocks were copied along with the chunks,
+	// only the links between them still point to the source.
+	for (int32 i = 0; i < b2_blockSizes; ++i)
+	{
+		m_freeLists[i] = source.m_freeLists[i];
+		relocation.Relocate(m_freeLists[i]);
+
+		for (b2Block* block = m_freeLists[i]; block; block = block->next)
+		{
+			relocation.Relocate(block->next);
+		}
+	}
+
+#if DEBUG_PHYSICS_WORLD_CACHE_COPY
+	m_numAllocatedObjects = source.m_numAllocatedObjects;
+#endif
+}
+
+void* b2BlockRelocation::Relocate(const void* p) const
+{
+	if (p == NULL)
+	{
+		return NULL;
+	}
+
+	const int8* bytes = (const int8*)p;
+
+	// Ranges are sorted by their source addresses.
+	auto it = std::upper_bound(m_ranges.begin(), m_ranges.end(), bytes, [](const int8* value, const Range& range) {
+		return std::less<const int8*>()(value, range.source);
+	});
+
+	b2Assert(it != m_ranges.begin());
+	--it;
+	b2Assert(bytes < it->sourceEnd);
+
+	return it->target + (bytes - it->source);
+}
@@ -19,6 +19,7 @@
 #ifndef B2_BLOCK_ALLOCATOR_H
 #define B2_BLOCK_ALLOCATOR_H
 
+#include <vector>
 #include <Box2D/Common/b2Settings.h>
 #include "augs/build_settings/setting_debug_physics_world_cache_copy.h"
 
@@ -30,6 +31,36 @@ const int32 b2_chunkArrayIncrement = 128;
 struct b2Block;
 struct b2Chunk;
 
+/// Maps the addresses of blocks of one allocator to the addresses
+/// of the same blocks in an allocator that was cloned from it with b2BlockAllocator::CloneFrom.
+/// Chunks that were adjacent in the source are merged into a single range,
+/// so cloning a clone usually needs only one range - a constant offset.
+class b2BlockRelocation
+{
+public:
+	void* Relocate(const void* p) const;
+
+	template <class T>
+	void Relocate(T*& p) const
+	{
+		p = static_cast<T*>(Relocate(static_cast<const void*>(p)));
+	}
+
+	int32 GetRangeCount() const { return static_cast<int32>(m_ranges.size()); }
+
+private:
+	friend class b2BlockAllocator;
+
+	struct Range
+	{
+		const int8* source;
+		const int8* sourceEnd;
+		int8* target;
+	};
+
+	std::vector<Range> m_ranges;
+};
+
 /// This is a small object allocator used for allocating small
 /// objects that persist for more than one time step.
 /// See: http://www.codeproject.com/useritems/Small_Block_Allocator.asp
@@ -47,6 +78,16 @@ public:
 
 	void Clear();
 
+	/// Copies all chunks of the source into a single arena with one allocation and a bulk memcpy,
+	/// then relocates the free lists. This allocator must not have any chunks yet.
+	/// Every block of the source then has its copy at relocation.Relocate(block).
+	/// Requires source.IsRelocatable().
+	void CloneFrom(const b2BlockAllocator& source, b2BlockRelocation& relocation);
+
+	/// False if any live allocation went through b2Alloc because it exceeded b2_maxBlockSize.
+	/// Such allocations are not a part of any chunk and could not be found by CloneFrom.
+	bool IsRelocatable() const { return m_largeAllocationCount == 0; }
+
 	b2BlockAllocator& operator=(const b2BlockAllocator&) {
 		return *this;
 	}
@@ -58,6 +99,15 @@ private:
 
 	b2Block* m_freeLists[b2_blockSizes];
 
+	/// Holds the chunks copied by CloneFrom. Chunks allocated afterwards lie outside of it.
+	int8* m_arena;
+	int32 m_arenaChunkCount;
+
+	int32 m_largeAllocationCount;
+
+	bool IsInArena(const b2Chunk& chunk) const;
+	void FreeChunks();
+
 #if DEBUG_PHYSICS_WORLD_CACHE_COPY
 public:
 	unsigned m_numAllocatedObjects;
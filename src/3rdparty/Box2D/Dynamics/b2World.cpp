@@ -21,6 +21,7 @@
 #include <Box2D/Dynamics/b2Fixture.h>
 #include <Box2D/Dynamics/b2Island.h>
 #include <Box2D/Dynamics/Joints/b2PulleyJoint.h>
+#include <Box2D/Dynamics/Joints/b2GearJoint.h>
 #include <Box2D/Dynamics/Contacts/b2Contact.h>
 #include <Box2D/Dynamics/Contacts/b2ContactSolver.h>
 #include <Box2D/Collision/b2Collision.h>
@@ -102,6 +103,100 @@ void b2World::SetDebugDraw(b2Draw* debugDraw)
 	m_debugDraw = debugDraw;
 }
 
+void b2World::CloneObjectsFrom(const b2World& source, b2BlockRelocation& relocation)
+{
+	b2Assert(m_contactManager.m_allocator == &m_blockAllocator);
+
+	m_blockAllocator.CloneFrom(source.m_blockAllocator, relocation);
+
+	relocation.Relocate(m_bodyList);
+	relocation.Relocate(m_jointList);
+	relocation.Relocate(m_contactManager.m_contactList);
+
+	b2DynamicTree& proxyTree = m_contactManager.m_broadPhase.m_tree;
+
+	for (b2Body* b = m_bodyList; b; b = b->m_next)
+	{
+		b->m_world = this;
+
+		relocation.Relocate(b->m_prev);
+		relocation.Relocate(b->m_next);
+		relocation.Relocate(b->m_ownerFrictionGround);
+		relocation.Relocate(b->m_fixtureList);
+		relocation.Relocate(b->m_jointList);
+		relocation.Relocate(b->m_contactList);
+
+		for (b2Fixture* f = b->m_fixtureList; f; f = f->m_next)
+		{
+			f->m_body = b;
+
+			relocation.Relocate(f->m_next);
+			relocation.Relocate(f->m_shape);
+			relocation.Relocate(f->m_proxies);
+
+			if (f->m_shape->m_type == b2Shape::e_chain)
+			{
+				// Chain vertices are allocated outside of the block allocator.
+				b2ChainShape* chain = static_cast<b2ChainShape*>(f->m_shape);
+				const int32 bytes = chain->m_count * sizeof(b2Vec2);
+
+				const b2Vec2* sourceVertices = chain->m_vertices;
+				chain->m_vertices = (b2Vec2*)b2Alloc(bytes);
+				memcpy(chain->m_vertices, sourceVertices, bytes);
+			}
+
+			for (int32 i = 0; i < f->m_proxyCount; ++i)
+			{
+				b2FixtureProxy& proxy = f->m_proxies[i];
+				proxy.fixture = f;
+				proxyTree.m_nodes[proxy.proxyId].userData = &proxy;
+			}
+		}
+	}
+
+	for (b2Contact* c = m_contactManager.m_contactList; c; c = c->m_next)
+	{
+		relocation.Relocate(c->m_prev);
+		relocation.Relocate(c->m_next);
+		relocation.Relocate(c->m_fixtureA);
+		relocation.Relocate(c->m_fixtureB);
+
+		for (b2ContactEdge* edge : { &c->m_nodeA, &c->m_nodeB })
+		{
+			edge->contact = c;
+			relocation.Relocate(edge->other);
+			relocation.Relocate(edge->prev);
+			relocation.Relocate(edge->next);
+		}
+	}
+
+	for (b2Joint* j = m_jointList; j; j = j->m_next)
+	{
+		relocation.Relocate(j->m_prev);
+		relocation.Relocate(j->m_next);
+		relocation.Relocate(j->m_bodyA);
+		relocation.Relocate(j->m_bodyB);
+
+		for (b2JointEdge* edge : { &j->m_edgeA, &j->m_edgeB })
+		{
+			edge->joint = j;
+			relocation.Relocate(edge->other);
+			relocation.Relocate(edge->prev);
+			relocation.Relocate(edge->next);
+		}
+
+		if (j->m_type == e_gearJoint)
+		{
+			b2GearJoint* gear = static_cast<b2GearJoint*>(j);
+
+			relocation.Relocate(gear->m_joint1);
+			relocation.Relocate(gear->m_joint2);
+			relocation.Relocate(gear->m_bodyC);
+			relocation.Relocate(gear->m_bodyD);
+		}
+	}
+}
+
 b2Body* b2World::CreateBody(const b2BodyDef* def)
 {
 	b2Assert(IsLocked() == false);
@@ -210,6 +210,12 @@ public:
 
 	b2World& operator=(const b2World&) = default;
 
+	/// Called on a freshly constructed world right after it was assigned the source world.
+	/// Clones all bodies, fixtures, shapes, contacts and joints of the source in bulk
+	/// through b2BlockAllocator::CloneFrom, then relocates the pointers between them in a single pass.
+	/// Requires source.m_blockAllocator.IsRelocatable().
+	void CloneObjectsFrom(const b2World& source, b2BlockRelocation& relocation);
+
 public:
 	b2World& operator=(b2World&&) = delete;
 	b2World(const b2World&) = delete;
@@ -0,0 +1,150 @@
+#include <array>
+
+#include "augs/log.h"
+#include "augs/misc/randomization.h"
+#include "augs/templates/remove_cref.h"
+
+#include "game/cosmos/cosmos.h"
+#include "game/cosmos/entity_handle.h"
+#include "game/cosmos/for_each_entity.h"
+#include "game/cosmos/solvable_hash.h"
+#include "game/cosmos/solvers/standard_solver.h"
+#include "game/modes/test_mode.h"
+#include "test_scenes/test_scene_settings.h"
+
+#include "application/intercosm.h"
+#include "application/authoritative_solve_test.h"
+
+#if BUILD_TEST_SCENES
+std::vector<cosmic_entropy> record_test_scene_match(const cosmos& cosm, const unsigned steps) {
+	std::vector<entity_id> characters;
+
+	cosm.for_each_having<components::sentience>([&](const auto typed_handle) {
+		characters.push_back(typed_handle.get_id());
+	});
+
+	auto rng = randomization(1337);
+
+	const auto movement_intents = std::array<game_intent_type, 4> {
+		game_intent_type::MOVE_FORWARD,
+		game_intent_type::MOVE_BACKWARD,
+		game_intent_type::MOVE_LEFT,
+		game_intent_type::MOVE_RIGHT
+	};
+
+	std::vector<cosmic_entropy> recorded;
+	recorded.resize(steps);
+
+	for (auto& entropy : recorded) {
+		for (const auto& character : characters) {
+			auto& commands = entropy[character].commands;
+
+			auto toggle = [&](const game_intent_type type, const int one_in) {
+				if (rng.randval(0, one_in - 1) == 0) {
+					game_intent intent;
+					intent.intent = type;
+					intent.change = rng.randval(0, 1) ? intent_change::PRESSED : intent_change::RELEASED;
+
+					commands.intents.push_back(intent);
+				}
+			};
+
+			for (const auto m : movement_intents) {
+				toggle(m, 30);
+			}
+
+			toggle(game_intent_type::CROSSHAIR_PRIMARY_ACTION, 20);
+			toggle(game_intent_type::RELOAD, 200);
+
+			auto& crosshair_motion = commands.motions[game_motion_type::MOVE_CROSSHAIR];
+			crosshair_motion.x = static_cast<short>(rng.randval(-10, 10));
+			crosshair_motion.y = static_cast<short>(rng.randval(-10, 10));
+		}
+	}
+
+	return recorded;
+}
+#endif
+
+bool perform_authoritative_solve_test(sol::state& lua, const unsigned steps) {
+#if BUILD_TEST_SCENES
+	LOG("Testing the authoritative-only solve over %x recorded steps.", steps);
+
+	auto scene = std::make_unique<intercosm>();
+	auto ruleset = test_mode_ruleset();
+
+	scene->make_test_scene(lua, { false, 60 }, ruleset);
+
+	auto& full = scene->world;
+	const auto authoritative = std::make_unique<cosmos>(full);
+
+	const auto recorded = record_test_scene_match(full, steps);
+
+	solve_settings full_settings;
+	solve_settings authoritative_settings;
+	authoritative_settings.generate_audiovisual_messages = false;
+
+	auto advance = [&](cosmos& cosm, const solve_settings& settings, cosmic_entropy entropy) {
+		std::size_t audiovisual_messages = 0;
+
+		entropy.clear_dead_entities(cosm);
+
+		standard_solver()(
+			{ cosm, entropy, settings },
+			solver_callbacks(
+				default_solver_callback(),
+				[&](const const_logic_step step) {
+					step.transient.messages.for_each_queue([&](const std::size_t, const auto& q) {
+						using M = typename remove_cref<decltype(q)>::value_type;
+
+						if constexpr(is_audiovisual_message_v<M>) {
+							audiovisual_messages += q.size();
+						}
+					});
+				}
+			)
+		);
+
+		return audiovisual_messages;
+	};
+
+	std::size_t full_audiovisual_messages = 0;
+
+	for (unsigned i = 0; i < steps; ++i) {
+		full_audiovisual_messages += advance(full, full_settings, recorded[i]);
+
+		if (const auto leaked = advance(*authoritative, authoritative_settings, recorded[i])) {
+			LOG("(Authoritative solve test) Step %x: %x audiovisual messages were posted.", i, leaked);
+			return false;
+		}
+
+		if (calculate_solvable_hash(full) != calculate_solvable_hash(*authoritative)) {
+			LOG("(Authoritative solve test) Diverged from the full solve at step %x.", i);
+
+			solvable_hash_tree full_tree;
+			solvable_hash_tree authoritative_tree;
+
+			full_tree.rebuild(full);
+			authoritative_tree.rebuild(*authoritative);
+
+			if (const auto divergence = find_divergence(full_tree, authoritative_tree)) {
+				LOG(divergence->describe());
+			}
+
+			return false;
+		}
+	}
+
+	LOG("(Authoritative solve test) Entities: %x", full.get_entities_count());
+	LOG("(Authoritative solve test) Audiovisual messages skipped: %x", full_audiovisual_messages);
+	LOG("(Authoritative solve test) Hashes matched after every step.");
+
+	return true;
+#else
+	(void)lua;
+	(void)steps;
+
+	LOG("Authoritative solve test requires BUILD_TEST_SCENES.");
+	return false;
+#endif
+}
@@ -0,0 +1,24 @@
+#pragma once
+#include "3rdparty/sol2/sol/forward.hpp"
+
+/*
+	Records a match played by every character of the test scene -
+	random movement, aiming and shooting - and replays it twice:
+	once with the full solve and once with the authoritative-only solve
+	that dedicated servers use (solve_settings::generate_audiovisual_messages = false).
+
+	Returns false if the solvable hashes differ after any step,
+	or if the authoritative-only solve has posted any audiovisual message.
+*/
+
+bool perform_authoritative_solve_test(sol::state& lua, unsigned steps);
+
+#if BUILD_TEST_SCENES
+#include <vector>
+
+class cosmos;
+struct cosmic_entropy;
+
+/* Random movement, aiming and shooting of every character of the test scene. */
+std::vector<cosmic_entropy> record_test_scene_match(const cosmos& cosm, unsigned steps);
+#endif
@@ -46,6 +46,8 @@
 #include "application/performance_settings.h"
 #include "application/http_client/http_client_settings.h"
 #include "application/masterserver/masterserver_settings.h"
+#include "application/relay/spectator_relay_settings.h"
+#include "application/load_test/load_test_swarm_settings.h"
 #include "application/nat/nat_detection_settings.h"
 #include "application/nat/nat_traversal_settings.h"
 #include "fp_consistency_tests.h"
@@ -104,6 +106,8 @@ struct config_lua_table {
 	address_and_port extra_address_resolution_port;
 
 	masterserver_settings masterserver;
+	spectator_relay_settings spectator_relay;
+	load_test_swarm_settings load_test_swarm;
 
 	std::vector<std::string> official_arena_servers;
 
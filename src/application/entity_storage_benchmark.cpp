@@ -0,0 +1,146 @@
+#include "augs/log.h"
+#include "augs/misc/timing/timer.h"
+#include "augs/templates/remove_cref.h"
+#include "augs/templates/for_each_type.h"
+#include "augs/templates/introspection_utils/introspective_equal.h"
+
+#include "game/cosmos/cosmos.h"
+#include "game/cosmos/entity_soa_layout.h"
+#include "augs/misc/pool/pool_allocate.h"
+#include "game/modes/test_mode.h"
+#include "test_scenes/test_scene_settings.h"
+
+#include "application/intercosm.h"
+#include "application/entity_storage_benchmark.h"
+
+/* 
+	Only keeps the traversal from being optimized out. 
+	Padding bytes are read too, so the result says nothing about the equality of components.
+*/
+
+template <class C>
+static std::size_t touch_bytes_of(const C& component) {
+	const auto bytes = reinterpret_cast<const unsigned char*>(std::addressof(component));
+
+	std::size_t total = 0;
+
+	for (std::size_t i = 0; i < sizeof(C); ++i) {
+		total += bytes[i];
+	}
+
+	return total;
+}
+
+bool perform_entity_storage_benchmark(sol::state& lua, const unsigned passes) {
+#if BUILD_TEST_SCENES
+	LOG("Performing %x entity storage benchmark passes.", passes);
+
+	auto scene = std::make_unique<intercosm>();
+	auto ruleset = test_mode_ruleset();
+
+	scene->make_test_scene(lua, { false, 60 }, ruleset);
+
+	const auto& significant = scene->world.get_solvable().significant;
+
+	double aos_ms = 0.0;
+	double soa_ms = 0.0;
+
+	std::size_t sink = 0;
+	std::size_t mismatched_components = 0;
+
+	significant.for_each_entity_pool([&](const auto& world_pool) {
+		using E = typename remove_cref<decltype(world_pool)>::value_type::used_entity_type;
+		using aos_pool_type = make_entity_pool_with<E, entity_pool_storage::ARRAY_OF_STRUCTS>;
+		using soa_pool_type = make_entity_soa_pool<E>;
+
+		/* 
+			The world stores every type with its own storage,
+			so both storages are mirrored from it to be compared on equal terms. 
+		*/
+
+		auto aos_pool = std::make_unique<aos_pool_type>();
+		auto soa = std::make_unique<soa_pool_type>();
+
+		aos_pool->reserve(world_pool.capacity());
+		soa->reserve(world_pool.capacity());
+
+		std::vector<typename soa_pool_type::key_type> soa_ids;
+		soa_ids.reserve(world_pool.size());
+
+		for (std::size_t i = 0; i < world_pool.size(); ++i) {
+			const auto object = [&]() {
+				if constexpr(is_soa_entity_v<E>) {
+					return world_pool.assemble_nth(i);
+				}
+				else {
+					return world_pool.data()[i];
+				}
+			}();
+
+			aos_pool->allocate(object);
+			soa_ids.push_back(soa->allocate(object).key);
+		}
+
+		const auto& aos = *aos_pool;
+
+		for_each_type_in_list<components_of<E>>(
+			[&](auto tag) {
+				using C = decltype(tag);
+
+				{
+					std::size_t i = 0;
+
+					for (const auto& object : aos) {
+						if (!augs::introspective_equal(object.template get<C>(), soa->template get<C>(soa_ids[i++]))) {
+							++mismatched_components;
+						}
+					}
+				}
+
+				{
+					auto timer = augs::timer();
+
+					for (unsigned p = 0; p < passes; ++p) {
+						for (const auto& object : aos) {
+							sink += touch_bytes_of(object.template get<C>());
+						}
+					}
+
+					aos_ms += timer.get<std::chrono::microseconds>() / 1000.0;
+				}
+
+				{
+					auto timer = augs::timer();
+
+					for (unsigned p = 0; p < passes; ++p) {
+						for (const auto& component : soa->template get_column<C>()) {
+							sink += touch_bytes_of(component);
+						}
+					}
+
+					soa_ms += timer.get<std::chrono::microseconds>() / 1000.0;
+				}
+			}
+		);
+	});
+
+	LOG("(Entity storage benchmark) Entities: %x", scene->world.get_entities_count());
+	LOG("(Entity storage benchmark) Array of structs: %x ms", aos_ms);
+	LOG("(Entity storage benchmark) Structure of arrays: %x ms", soa_ms);
+
+	LOG("(Entity storage benchmark) Sink: %x", sink);
+
+	if (mismatched_components > 0) {
+		LOG("(Entity storage benchmark) %x components differ between the two storages.", mismatched_components);
+		return false;
+	}
+
+	return true;
+#else
+	(void)lua;
+	(void)passes;
+
+	LOG("Entity storage benchmark requires BUILD_TEST_SCENES.");
+	return false;
+#endif
+}
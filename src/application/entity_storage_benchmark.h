@@ -0,0 +1,12 @@
+#pragma once
+#include "3rdparty/sol2/sol/forward.hpp"
+
+/*
+	Builds the test scene and compares iterating every component of every entity
+	when the entity pools are stored as arrays of structs (as in the cosmos)
+	versus when they are stored as structures of arrays (augs::soa_pool).
+
+	Returns false if both storages disagree about the contents.
+*/
+
+bool perform_entity_storage_benchmark(sol::state& lua, unsigned passes);
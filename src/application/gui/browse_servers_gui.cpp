@@ -17,6 +17,8 @@
 #include "application/network/resolve_address.h"
 #include "application/masterserver/masterserver_requests.h"
 #include "application/masterserver/gameserver_command_readwrite.h"
+#include "application/masterserver/server_list_snapshot.h"
+#include "application/masterserver/netcode_address_hash.h"
 
 constexpr auto ping_retry_interval = 1;
 constexpr auto reping_interval = 10;
@@ -53,6 +55,16 @@ struct browse_servers_gui_internal {
 
 	std::future<official_addrs> future_official_addresses;
 
+	/* The list as of the last refresh - the later refreshes only download what has changed since then. */
+	std::unordered_map<netcode_address_t, server_list_entry> cached_list;
+	std::optional<uint64_t> cached_version;
+	uint64_t cached_epoch = 0;
+
+	void forget_cached_list() {
+		cached_list.clear();
+		cached_version = std::nullopt;
+	}
+
 	bool refresh_op_in_progress() const {
 		return future_official_addresses.valid() || future_response.valid();
 	}
@@ -105,8 +117,19 @@ void browse_servers_gui_state::refresh_server_list(const browse_servers_input in
 		}
 	);
 
+	auto make_query = [&]() {
+		server_list_query query;
+
+		if (data->cached_version) {
+			query.since_version = data->cached_version;
+			query.epoch = data->cached_epoch;
+		}
+
+		return query;
+	};
+
 	data->future_response = launch_async(
-		[&http_opt, address = in.server_list_provider]() -> std::shared_ptr<Response> {
+		[&http_opt, address = in.server_list_provider, query_path = make_query().to_request_path()]() -> std::shared_ptr<Response> {
 			const auto resolved = resolve_address(address);
 			LOG(resolved.report());
 
@@ -135,7 +158,7 @@ void browse_servers_gui_state::refresh_server_list(const browse_servers_input in
 			auto& http = *http_opt;
 			http.follow_location(true);
 
-			return http.Get("/server_list_binary", progress);
+			return http.Get(query_path.c_str(), progress);
 		}
 	);
 
@@ -509,13 +532,56 @@ bool browse_servers_gui_state::perform(const browse_servers_input in) {
 			return;
 		}
 
-		const auto& bytes = response->body;
+		const auto& body = response->body;
+		std::vector<std::byte> bytes;
+
+		LOG("Server list response bytes: %x", body.size());
+
+		try {
+			if (response->has_header(server_list_uncompressed_size_header_v)) {
+				const auto max_list_bytes = std::size_t(64 * 1024 * 1024);
+				const auto uncompressed_size = std::stoull(response->get_header_value(server_list_uncompressed_size_header_v));
+
+				if (uncompressed_size > max_list_bytes) {
+					throw augs::decompression_error("The declared size of the server list is too big: %x.", uncompressed_size);
+				}
+
+				bytes.resize(uncompressed_size);
+				augs::decompress(reinterpret_cast<const std::byte*>(body.data()), body.size(), bytes);
+			}
+			else {
+				bytes.assign(
+					reinterpret_cast<const std::byte*>(body.data()),
+					reinterpret_cast<const std::byte*>(body.data() + body.size())
+				);
+			}
+		}
+		catch (const std::exception& err) {
+			error_message = couldnt_download + "There was a problem decompressing the server list:\n" + std::string(err.what());
 
-		LOG("Server list response bytes: %x", bytes.size());
+			data->forget_cached_list();
+			return;
+		}
 
 		auto stream = augs::make_read_stream(bytes.data(), bytes.size());
+		auto& cached_list = data->cached_list;
 
 		try {
+			const auto epoch = augs::read_bytes<uint64_t>(stream);
+			const auto version = augs::read_bytes<uint64_t>(stream);
+			const auto is_delta = augs::read_bytes<uint8_t>(stream) != 0;
+			const auto num_removed = augs::read_bytes<uint32_t>(stream);
+
+			if (!is_delta) {
+				cached_list.clear();
+			}
+
+			for (uint32_t i = 0; i < num_removed; ++i) {
+				cached_list.erase(augs::read_bytes<netcode_address_t>(stream));
+			}
+
+			std::size_t num_changed = 0;
+
 			while (stream.has_unread_bytes()) {
 				server_list_entry entry;
 
@@ -523,12 +589,29 @@ bool browse_servers_gui_state::perform(const browse_servers_input in) {
 				augs::read_bytes(stream, entry.appeared_when);
 				augs::read_bytes(stream, entry.heartbeat);
 
-				server_list.emplace_back(std::move(entry));
+				const auto address = entry.address;
+				cached_list.insert_or_assign(address, std::move(entry));
+
+				++num_changed;
 			}
+
+			LOG("Received %x: %x removed, %x changed.", is_delta ? "the changes to the server list" : "a full server list", num_removed, num_changed);
+
+			data->cached_epoch = epoch;
+			data->cached_version = version;
 		}
 		catch (const augs::stream_read_error& err) {
 			error_message = "There was a problem deserializing the server list:\n" + std::string(err.what()) + "\n\nTry restarting the game and updating your client!";
 			server_list.clear();
+
+			data->forget_cached_list();
+			return;
+		}
+
+		server_list.reserve(cached_list.size());
+
+		for (const auto& cached : cached_list) {
+			server_list.push_back(cached.second);
 		}
 	};
 
@@ -1121,6 +1121,8 @@ void settings_gui_state::perform(
 					revertable_slider(SCOPE_CFG_NVP(buffer_at_least_steps), 0u, 10u);
 					revertable_slider(SCOPE_CFG_NVP(buffer_at_least_ms), 0u, 100u);
 					revertable_slider(SCOPE_CFG_NVP(max_commands_to_squash_at_once), uint8_t(0), uint8_t(255));
+					revertable_slider(SCOPE_CFG_NVP(max_adaptive_steps), 0u, max_adaptive_jitter_steps_v);
+					revertable_checkbox(SCOPE_CFG_NVP(stretch_catch_up));
 				}
 
 				break;
@@ -1634,6 +1636,8 @@ void do_server_vars(
 	ImGui::Separator();
 
 	revertable_slider(SCOPE_CFG_NVP(sleep_mult), 0.0f, 0.9f);
+	revertable_slider(SCOPE_CFG_NVP(logic_workers), 0u, 16u);
+	revertable_checkbox(SCOPE_CFG_NVP(verify_parallel_solve));
 }
 
 #undef CONFIG_NVP
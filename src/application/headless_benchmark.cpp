@@ -0,0 +1,190 @@
+#include <limits>
+#include <sol2/sol.hpp>
+
+#include "augs/log.h"
+#include "augs/misc/lua/lua_utils.h"
+#include "augs/misc/randomization.h"
+#include "augs/misc/timing/timer.h"
+#include "augs/templates/introspect.h"
+
+#include "game/cosmos/cosmos.h"
+#include "game/cosmos/entity_handle.h"
+#include "game/cosmos/solvable_hash.h"
+#include "game/cosmos/solvers/standard_solver.h"
+
+#include "application/intercosm.h"
+#include "application/predefined_rulesets.h"
+#include "application/network/network_common.h"
+#include "application/setups/server/server_vars.h"
+#include "application/arena/arena_handle.h"
+#include "application/arena/choose_arena.h"
+#include "application/headless_benchmark.h"
+
+static void generate_synthetic_entropy(
+	cosmic_entropy& entropy,
+	const entity_id character,
+	randomization& rng
+) {
+	auto& commands = entropy[character].commands;
+
+	auto toggle = [&](const game_intent_type type, const int one_in) {
+		if (rng.randval(0, one_in - 1) == 0) {
+			game_intent intent;
+			intent.intent = type;
+			intent.change = rng.randval(0, 1) ? intent_change::PRESSED : intent_change::RELEASED;
+
+			commands.intents.push_back(intent);
+		}
+	};
+
+	toggle(game_intent_type::MOVE_FORWARD, 30);
+	toggle(game_intent_type::MOVE_BACKWARD, 30);
+	toggle(game_intent_type::MOVE_LEFT, 30);
+	toggle(game_intent_type::MOVE_RIGHT, 30);
+	toggle(game_intent_type::SPRINT, 60);
+	toggle(game_intent_type::CROSSHAIR_PRIMARY_ACTION, 20);
+	toggle(game_intent_type::RELOAD, 200);
+
+	auto& crosshair_motion = commands.motions[game_motion_type::MOVE_CROSSHAIR];
+	crosshair_motion.x = static_cast<short>(rng.randval(-10, 10));
+	crosshair_motion.y = static_cast<short>(rng.randval(-10, 10));
+}
+
+bool perform_headless_benchmark(const headless_benchmark_settings& settings) {
+	auto lua = augs::create_lua_state();
+
+	auto scene = std::make_unique<intercosm>();
+	auto rulesets = std::make_unique<predefined_rulesets>();
+	auto initial_signi = std::make_unique<cosmos_solvable_significant>();
+
+	online_mode_and_rules current_mode;
+
+	const auto arena = online_arena_handle<false> {
+		current_mode,
+		*scene,
+		scene->world,
+		*rulesets,
+		*initial_signi
+	};
+
+	{
+		server_solvable_vars vars;
+		vars.current_arena = settings.arena;
+
+		try {
+			::choose_arena(lua, arena, vars, *initial_signi);
+		}
+		catch (const std::exception& err) {
+			LOG("(Headless benchmark) Failed to load arena \"%x\": %x", settings.arena, err.what());
+			return false;
+		}
+	}
+
+	auto& cosm = arena.get_cosmos();
+
+	const auto num_players = std::min(
+		settings.players,
+		static_cast<unsigned>(max_mode_players_v - 1)
+	);
+
+	LOG(
+		"(Headless benchmark) Arena: %x, players: %x, steps: %x, seed: %x",
+		settings.arena.empty() ? std::string("testbed") : settings.arena,
+		num_players,
+		settings.steps,
+		settings.seed
+	);
+
+	auto rng = randomization(settings.seed);
+
+	auto count_allocations = [&]() -> std::size_t {
+		if (settings.count_allocations != nullptr) {
+			return settings.count_allocations();
+		}
+
+		return 0;
+	};
+
+	double total_secs = 0.0;
+	double min_step_secs = std::numeric_limits<double>::max();
+	double max_step_secs = 0.0;
+
+	std::size_t total_allocations = 0;
+	std::size_t max_allocations = 0;
+
+	unsigned players_added = 0;
+
+	for (unsigned i = 0; i < settings.steps; ++i) {
+		mode_entropy entropy;
+
+		/* Only one player can join per step. */
+
+		if (players_added < num_players) {
+			entropy.general.added_player = add_player_input {
+				mode_player_id(players_added),
+				typesafe_sprintf("Player%x", players_added),
+				faction_type::DEFAULT
+			};
+
+			++players_added;
+		}
+
+		arena.on_mode([&](const auto& typed_mode) {
+			for (unsigned p = 0; p < players_added; ++p) {
+				const auto character = typed_mode.lookup(mode_player_id(p));
+
+				if (cosm[character].alive()) {
+					generate_synthetic_entropy(entropy.cosmic, character, rng);
+				}
+			}
+		});
+
+		const auto allocations_before = count_allocations();
+
+		auto tm = augs::timer();
+
+		arena.advance(
+			entropy,
+			solver_callbacks(),
+			solve_settings()
+		);
+
+		const auto step_secs = tm.get<std::chrono::seconds>();
+		const auto step_allocations = count_allocations() - allocations_before;
+
+		total_secs += step_secs;
+		min_step_secs = std::min(min_step_secs, step_secs);
+		max_step_secs = std::max(max_step_secs, step_secs);
+
+		total_allocations += step_allocations;
+		max_allocations = std::max(max_allocations, step_allocations);
+	}
+
+	if (settings.steps == 0) {
+		min_step_secs = 0.0;
+	}
+
+	const auto steps = std::max(1u, settings.steps);
+
+	LOG("(Headless benchmark) Entities at the end: %x", cosm.get_entities_count());
+	LOG("(Headless benchmark) Total: %f2 ms", total_secs * 1000);
+	LOG("(Headless benchmark) Per step: avg %f2 ms, min %f2 ms, max %f2 ms", total_secs * 1000 / steps, min_step_secs * 1000, max_step_secs * 1000);
+
+	if (settings.count_allocations != nullptr) {
+		LOG("(Headless benchmark) Allocations: %x total, %f2 per step, %x at most in a single step", total_allocations, static_cast<double>(total_allocations) / steps, max_allocations);
+	}
+
+	{
+		auto& profiler = cosm.profiler;
+		profiler.prepare_summary_info();
+
+		std::string systems_summary;
+		profiler.summary(systems_summary);
+
+		LOG("(Headless benchmark) Per-system timings, averaged over the last steps:\n%x", systems_summary);
+	}
+
+	LOG("(Headless benchmark) Final solvable hash: %x", calculate_solvable_hash(cosm));
+
+	return true;
+}
@@ -0,0 +1,30 @@
+#pragma once
+#include <string>
+#include <cstddef>
+
+/*
+	Loads an arena - or the testbed if no name is given -
+	populates it with scripted players that move, aim and shoot at random,
+	and steps it for a fixed number of ticks without any window, audio or rendering.
+
+	Reports the step times, the per-system timings gathered by cosmic_profiler,
+	the heap allocations per step and the final solvable hash,
+	so that two runs of the same build on the same settings can be compared directly.
+*/
+
+struct headless_benchmark_settings {
+	std::string arena;
+
+	unsigned players = 10;
+	unsigned steps = 10000;
+	unsigned seed = 1337;
+
+	/*
+		Returns the number of heap allocations made so far by the process.
+		If null, allocations are not reported.
+	*/
+
+	std::size_t (*count_allocations)() = nullptr;
+};
+
+bool perform_headless_benchmark(const headless_benchmark_settings& settings);
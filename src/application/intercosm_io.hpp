@@ -1,6 +1,7 @@
 #pragma once
 #include <sol2/sol.hpp>
 #include "augs/misc/pool/pool_io.hpp"
+#include "augs/misc/pool/soa_pool_io.hpp"
 #include "game/cosmos/per_entity_type.h"
 #include "augs/templates/for_each_type.h"
 #include "augs/readwrite/memory_stream.h"
@@ -0,0 +1,326 @@
+#include <csignal>
+#include <cstring>
+#include <algorithm>
+
+#include "augs/log.h"
+#include "augs/misc/randomization.h"
+#include "augs/misc/timing/timer.h"
+
+#include "game/cosmos/solvers/solver_callbacks.h"
+
+#include "view/audiovisual_state/systems/interpolation_system.h"
+#include "view/audiovisual_state/systems/past_infection_system.h"
+
+#include "application/config_lua_table.h"
+#include "application/session_profiler.h"
+#include "application/setups/client/client_setup.h"
+#include "application/arena/arena_handle.hpp"
+#include "application/load_test/load_test_swarm.h"
+
+#if PLATFORM_UNIX
+extern volatile std::sig_atomic_t signal_status;
+#endif
+
+double yojimbo_time();
+void yojimbo_sleep(double);
+
+struct load_test_bot {
+	std::string nickname;
+	std::unique_ptr<client_setup> setup;
+
+	interpolation_system interp;
+	past_infection_system past_infection;
+	network_profiler performance;
+	network_info stats = {};
+
+	randomization rng;
+
+	bool was_in_game = false;
+	bool dropped = false;
+
+	net_time_t when_last_input = 0.0;
+	net_time_t when_last_team_choice = -1.0;
+
+	load_test_bot(const unsigned seed) : rng(seed) {}
+};
+
+static void generate_random_input(load_test_bot& bot) {
+	auto& rng = bot.rng;
+	auto& setup = *bot.setup;
+
+	game_intents intents;
+
+	auto toggle = [&](const game_intent_type type, const int one_in) {
+		if (rng.randval(0, one_in - 1) == 0) {
+			game_intent intent;
+			intent.intent = type;
+			intent.change = rng.randval(0, 1) ? intent_change::PRESSED : intent_change::RELEASED;
+
+			intents.push_back(intent);
+		}
+	};
+
+	toggle(game_intent_type::MOVE_FORWARD, 30);
+	toggle(game_intent_type::MOVE_BACKWARD, 30);
+	toggle(game_intent_type::MOVE_LEFT, 30);
+	toggle(game_intent_type::MOVE_RIGHT, 30);
+	toggle(game_intent_type::SPRINT, 60);
+	toggle(game_intent_type::CROSSHAIR_PRIMARY_ACTION, 20);
+	toggle(game_intent_type::RELOAD, 200);
+
+	setup.control(intents);
+
+	raw_game_motion motion;
+	motion.motion = game_motion_type::MOVE_CROSSHAIR;
+	motion.offset.x = static_cast<short>(rng.randval(-10, 10));
+	motion.offset.y = static_cast<short>(rng.randval(-10, 10));
+
+	setup.control(raw_game_motion_vector { motion });
+}
+
+static void control_bot(load_test_bot& bot, const net_time_t current_time) {
+	auto& setup = *bot.setup;
+
+	if (!setup.is_gameplay_on()) {
+		return;
+	}
+
+	bot.was_in_game = true;
+
+	/* Input is sampled once per step, so generate no more often than that. */
+
+	if (current_time - bot.when_last_input < setup.get_inv_tickrate()) {
+		return;
+	}
+
+	bot.when_last_input = current_time;
+
+	const auto arena = setup.get_arena_handle(client_arena_type::REFERENTIAL);
+
+	if (::is_spectator(arena, setup.get_local_player_id())) {
+		/* Players join as spectators. Retry in case the mode refused the choice. */
+
+		const auto retry_every_secs = 2.0;
+
+		if (bot.when_last_team_choice < 0 || current_time - bot.when_last_team_choice > retry_every_secs) {
+			setup.control(mode_player_entropy(mode_commands::team_choice { faction_type::DEFAULT }));
+			bot.when_last_team_choice = current_time;
+		}
+
+		return;
+	}
+
+	generate_random_input(bot);
+}
+
+static void report_swarm(
+	const std::vector<std::unique_ptr<load_test_bot>>& bots,
+	const bool detailed
+) {
+	std::size_t num_in_game = 0;
+	std::size_t num_dropped = 0;
+
+	double total_sent_kbps = 0.0;
+	double total_received_kbps = 0.0;
+	double max_received_kbps = 0.0;
+
+	std::size_t total_repredictions = 0;
+	std::size_t total_repredicted_steps = 0;
+
+	server_step_timing server_step;
+
+	for (const auto& bot : bots) {
+		const auto& setup = *bot->setup;
+		const auto& stats = bot->stats;
+		const auto& repredictions = setup.get_total_repredictions();
+
+		if (bot->dropped) {
+			++num_dropped;
+		}
+
+		if (!setup.is_gameplay_on()) {
+			continue;
+		}
+
+		++num_in_game;
+
+		total_sent_kbps += stats.sent_kbps;
+		total_received_kbps += stats.received_kbps;
+		max_received_kbps = std::max(max_received_kbps, double(stats.received_kbps));
+
+		total_repredictions += repredictions.count;
+		total_repredicted_steps += repredictions.steps;
+
+		const auto& timing = setup.get_last_server_step_timing();
+
+		if (timing.max_us > server_step.max_us) {
+			server_step = timing;
+		}
+
+		if (detailed) {
+			LOG(
+				"%x: RTT: %3f ms, loss: %3f%%, sent: %3f kbps, received: %3f kbps, repredictions: %x (%x steps; scheduled: %x, reinference: %x, entropy mismatch: %x, timing nudge: %x)",
+				bot->nickname,
+				stats.rtt_ms,
+				stats.loss_percent,
+				stats.sent_kbps,
+				stats.received_kbps,
+				repredictions.count,
+				repredictions.steps,
+				repredictions.of(reprediction_cause::SCHEDULED),
+				repredictions.of(reprediction_cause::REINFERENCE),
+				repredictions.of(reprediction_cause::ENTROPY_MISMATCH),
+				repredictions.of(reprediction_cause::TIMING_NUDGE)
+			);
+		}
+	}
+
+	const auto n = static_cast<double>(std::max(num_in_game, std::size_t(1)));
+
+	LOG(
+		"In game: %x/%x (%x dropped). Server step: avg %3f ms, max %3f ms. Per client: sent %3f kbps, received %3f kbps (max %3f). Repredictions: %x (%x steps)",
+		num_in_game,
+		bots.size(),
+		num_dropped,
+		server_step.avg_us / 1000.0,
+		server_step.max_us / 1000.0,
+		total_sent_kbps / n,
+		total_received_kbps / n,
+		max_received_kbps,
+		total_repredictions,
+		total_repredicted_steps
+	);
+}
+
+bool perform_load_test_swarm(
+	sol::state& lua,
+	const config_lua_table& config,
+	const load_test_swarm_settings& settings
+) {
+	const auto num_clients = std::min(settings.num_clients, static_cast<unsigned>(max_incoming_connections_v));
+
+	LOG(
+		"Starting the load test swarm: %x clients against %x:%x for %x seconds.",
+		num_clients,
+		settings.target.address,
+		settings.target.default_port,
+		settings.duration_secs
+	);
+
+	if (settings.network_simulator.is_enabled) {
+		const auto& sim = settings.network_simulator.value;
+		LOG("Simulating latency: %x ms, jitter: %x ms, loss: %x%%.", sim.latency_ms, sim.jitter_ms, sim.loss_percent);
+	}
+
+	client_start_input start;
+	start.default_port = settings.target.default_port;
+	start.set_custom(settings.target.address);
+
+	std::vector<std::unique_ptr<load_test_bot>> bots;
+
+	for (unsigned i = 0; i < num_clients; ++i) {
+		auto& bot = *bots.emplace_back(std::make_unique<load_test_bot>(settings.seed + i));
+
+		bot.nickname = typesafe_sprintf("%x%x", settings.nickname_prefix, i);
+
+		auto vars = config.client;
+		vars.nickname = bot.nickname;
+		vars.avatar_image_path.clear();
+		vars.demo_recording_path.is_enabled = false;
+		vars.network_simulator = settings.network_simulator;
+
+		bot.setup = std::make_unique<client_setup>(
+			lua,
+			start,
+			vars,
+			config.nat_detection,
+			port_type(0)
+		);
+
+		/* The connecting client turns them on, which would be unreadable for this many clients. */
+		augs::network::enable_detailed_logs(false);
+	}
+
+	const auto screen_size = vec2i(1920, 1080);
+	const auto zoom = 1.f;
+
+	const auto when_started = yojimbo_time();
+	auto when_last_reported = when_started;
+
+	augs::timer frame_timer;
+
+	for (;;) {
+#if PLATFORM_UNIX
+		if (signal_status != 0) {
+			const auto sig = signal_status;
+
+			LOG("%x received.", strsignal(sig));
+
+			if(
+				sig == SIGINT
+				|| sig == SIGSTOP
+				|| sig == SIGTERM
+			) {
+				LOG("Stopping the load test.");
+				break;
+			}
+		}
+#endif
+
+		const auto current_time = yojimbo_time();
+
+		if (settings.duration_secs > 0.f && current_time - when_started >= settings.duration_secs) {
+			break;
+		}
+
+		const auto frame_delta = frame_timer.extract_delta();
+
+		for (auto& bot_ptr : bots) {
+			auto& bot = *bot_ptr;
+			auto& setup = *bot.setup;
+
+			control_bot(bot, current_time);
+
+			setup.advance(
+				{
+					frame_delta,
+					screen_size,
+					config.input,
+					zoom,
+					config.simulation_receiver,
+					config.lag_compensation,
+					bot.performance,
+					bot.stats,
+					bot.interp,
+					bot.past_infection
+				},
+				solver_callbacks()
+			);
+
+			if (bot.was_in_game && !bot.dropped && !setup.is_connected()) {
+				LOG("%x lost connection to the server.", bot.nickname);
+				bot.dropped = true;
+			}
+		}
+
+		if (settings.report_once_every_secs > 0.f) {
+			if (current_time - when_last_reported >= std::max(settings.report_once_every_secs, 0.5f)) {
+				report_swarm(bots, false);
+				when_last_reported = current_time;
+			}
+		}
+
+		yojimbo_sleep(settings.sleep_ms / 1000);
+	}
+
+	LOG("Load test finished after %x seconds.", yojimbo_time() - when_started);
+	report_swarm(bots, true);
+
+	const auto all_joined = std::all_of(
+		bots.begin(),
+		bots.end(),
+		[](const auto& bot) { return bot->was_in_game && !bot->dropped; }
+	);
+
+	return all_joined;
+}
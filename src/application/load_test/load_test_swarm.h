@@ -0,0 +1,27 @@
+#pragma once
+#include "application/load_test/load_test_swarm_settings.h"
+
+/*
+	Connects a number of headless clients to a game server from a single process,
+	so that the server can be measured with many players without gathering them.
+
+	Every client is a complete client_setup - with its own adapter, simulation_receiver
+	and predicted cosmos - only with no window, audio or rendering,
+	and its input is generated at random: it joins a team,
+	walks around, aims and shoots.
+
+	Periodically reports the step time of the server (as sent in net_statistics_update),
+	the traffic of every client and how often the clients had to repredict.
+*/
+
+namespace sol {
+	class state;
+}
+
+struct config_lua_table;
+
+bool perform_load_test_swarm(
+	sol::state& lua,
+	const config_lua_table& config,
+	const load_test_swarm_settings& settings
+);
@@ -0,0 +1,21 @@
+#pragma once
+#include <string>
+#include "augs/network/network_simulator_settings.h"
+#include "application/network/address_and_port.h"
+
+struct load_test_swarm_settings {
+	// GEN INTROSPECTOR struct load_test_swarm_settings
+	address_and_port target;
+
+	unsigned num_clients = 16;
+	float duration_secs = 60.f;
+
+	std::string nickname_prefix = "Bot";
+	unsigned seed = 1337;
+
+	float report_once_every_secs = 5.f;
+	float sleep_ms = 1;
+
+	augs::maybe_network_simulator network_simulator;
+	// END GEN INTROSPECTOR
+};
@@ -1,8 +1,47 @@
 #pragma once
+#include <unordered_map>
+#include "augs/graphics/vertex.h"
+#include "game/cosmos/entity_id.h"
 #include "game/stateless_systems/visibility_system.h"
 
+/*
+	The visibility of a light is reused across frames
+	for as long as neither its request nor the obstacles within its reach change.
+*/
+
+struct cached_light_visibility {
+	visibility_request request;
+	uint64_t obstacles_signature = 0;
+	bool calculated = false;
+
+	visibility_response response;
+	augs::vertex_triangle_buffer triangles;
+
+	uint32_t last_used_frame = 0;
+
+	bool is_up_to_date(const visibility_request& r, const uint64_t signature) const {
+		const auto& a = request;
+
+		return
+			calculated
+			&& obstacles_signature == signature
+			&& a.subject == r.subject
+			&& a.eye_transform == r.eye_transform
+			&& a.queried_rect == r.queried_rect
+			&& a.offset == r.offset
+			&& a.color == r.color
+			&& a.ignore_discontinuities_shorter_than == r.ignore_discontinuities_shorter_than
+			&& a.filter.categoryBits == r.filter.categoryBits
+			&& a.filter.maskBits == r.filter.maskBits
+			&& a.filter.groupIndex == r.filter.groupIndex
+		;
+	}
+};
+
 struct cached_visibility_data {
 	visibility_response fow_response;
-	std::vector<visibility_response> light_responses;
 	std::vector<visibility_request> light_requests;
+
+	std::unordered_map<entity_id, cached_light_visibility> light_cache;
+	uint32_t current_frame = 0;
 };
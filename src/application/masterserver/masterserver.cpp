@@ -1,7 +1,10 @@
 #if PLATFORM_UNIX
 #include <csignal>
 #endif
-#include <shared_mutex>
+#include <atomic>
+#include <thread>
+#include <deque>
+#include <cstring>
 
 #include "application/masterserver/masterserver.h"
 #include "3rdparty/cpp-httplib/httplib.h"
@@ -17,20 +20,26 @@
 #include "augs/misc/time_utils.h"
 #include "augs/readwrite/byte_readwrite.h"
 #include "augs/network/netcode_socket_raii.h"
+#include "augs/network/netcode_socket_batch.h"
 #include "application/network/resolve_address.h"
 #include "augs/readwrite/byte_file.h"
 #include "augs/readwrite/to_bytes.h"
 #include "application/masterserver/masterserver_requests.h"
+#include "application/masterserver/server_list_snapshot.h"
 #include "application/masterserver/netcode_address_hash.h"
 
 std::string ToString(const netcode_address_t&);
 
 #if PLATFORM_UNIX
+#include <sys/resource.h>
 extern volatile std::sig_atomic_t signal_status;
 #endif
 
 #define LOG_MASTERSERVER 1
 
+/* Logging every packet would become the bottleneck with many gameservers. */
+#define LOG_MASTERSERVER_PACKETS 0
+
 template <class... Args>
 void MSR_LOG(Args&&... args) {
 #if LOG_MASTERSERVER
@@ -57,6 +66,9 @@ struct masterserver_client_meta {
 struct masterserver_client {
 	double time_of_last_heartbeat;
 
+	/* The list version at which this server was last added or changed. */
+	uint64_t version = 0;
+
 	masterserver_client_meta meta;
 	server_heartbeat last_heartbeat;
 };
@@ -89,10 +101,47 @@ bool host_equal(const netcode_address_t& a, const netcode_address_t& b) {
 double yojimbo_time();
 void yojimbo_sleep(double);
 
-void perform_masterserver(const config_lua_table& cfg) try {
+struct masterserver_counters {
+	std::atomic<bool> sockets_ready = false;
+	std::atomic<uint64_t> heartbeats = 0;
+	std::atomic<uint64_t> reserializations = 0;
+};
+
+struct masterserver_run_input {
+	masterserver_settings settings;
+	std::optional<augs::path_type> dump_path;
+	bool host_server_list = true;
+};
+
+static bool should_quit_on_signal() {
+#if PLATFORM_UNIX
+	if (signal_status != 0) {
+		const auto sig = signal_status;
+
+		LOG("%x received.", strsignal(sig));
+
+		if(
+			sig == SIGINT
+			|| sig == SIGSTOP
+			|| sig == SIGTERM
+		) {
+			LOG("Gracefully shutting down.");
+			return true;
+		}
+	}
+#endif
+
+	return false;
+}
+
+static bool run_masterserver(
+	const masterserver_run_input& in,
+	masterserver_counters& counters,
+	const std::atomic<bool>& quit_requested
+) try {
 	using namespace httplib;
 
-	const auto& settings = cfg.masterserver;
+	const auto& settings = in.settings;
 
 	auto udp_command_sockets = std::vector<netcode_socket_raii>();
 
@@ -108,45 +157,120 @@ void perform_masterserver(const config_lua_table& cfg) try {
 		}
 		else {
 			LOG("There was a problem binding masterserver to %x:%x! Quitting.", settings.ip, new_port);
-			return;
+			return false;
 		}
 
 		LOG("Created masterserver socket at: %x", ::ToString(udp_command_sockets.back().socket.address));
 	}
 
+	auto sockets = augs::netcode_socket_batch([&]() {
+		std::vector<netcode_socket_t*> out;
+
+		for (auto& s : udp_command_sockets) {
+			out.push_back(&s.socket);
+		}
+
+		return out;
+	}());
+
+	counters.sockets_ready = true;
+
 	std::unordered_map<netcode_address_t, masterserver_client> server_list;
 
-	std::vector<std::byte> serialized_list;
-	std::shared_mutex serialized_list_mutex;
+	/*
+		Every change to the list bumps its version, so that the clients can ask only for what changed since their last query.
+		Removals are remembered separately, up to a limit - after that, the clients have to download a full list.
+	*/
 
-	httplib::Server http;
+	const auto list_epoch = static_cast<uint64_t>(augs::date_time::secs_since_epoch() * 1000);
+	uint64_t list_version = 0;
+
+	const auto max_remembered_removals = std::size_t(4096);
+	std::deque<server_list_removal> removals;
+	uint64_t min_delta_since = 0;
 
-	const auto masterserver_dump_path = augs::path_type(USER_FILES_DIR) / "masterserver.dump";
+	auto remember_removal = [&](const netcode_address_t& address) {
+		if (removals.size() == max_remembered_removals) {
+			min_delta_since = removals.front().version;
+			removals.pop_front();
+		}
+
+		removals.push_back({ address, ++list_version });
+	};
+
+	auto compression_state = augs::make_compression_state();
+
+	/* Shared with the HTTP thread, so only ever accessed with std::atomic_load and std::atomic_store. */
+	auto published_list = server_list_snapshot::make({}, compression_state);
+
+	httplib::Server http;
 
 	auto reserialize_list = [&]() {
 		MSR_LOG("Reserializing the server list.");
 
-		std::lock_guard<std::shared_mutex> lock(serialized_list_mutex);
+		counters.reserializations.fetch_add(1, std::memory_order_relaxed);
 
-		serialized_list.clear();
+		server_list_snapshot snapshot;
 
-		auto ss = augs::ref_memory_stream(serialized_list);
+		snapshot.epoch = list_epoch;
+		snapshot.version = list_version;
+		snapshot.min_delta_since = min_delta_since;
+		snapshot.removals.assign(removals.begin(), removals.end());
+		snapshot.entries.reserve(server_list.size());
 
-		for (auto& server : server_list) {
-			const auto address = server.first;
+		{
+			/* The stream trims the buffer to the written size only once it is destroyed. */
+			auto ss = augs::ref_memory_stream(snapshot.bytes);
 
-			augs::write_bytes(ss, address);
-			augs::write_bytes(ss, server.second.meta.appeared_when);
-			augs::write_bytes(ss, server.second.last_heartbeat);
+			for (auto& server : server_list) {
+				const auto address = server.first;
+				const auto& heartbeat = server.second.last_heartbeat;
+
+				server_list_snapshot_entry entry;
+				entry.address = address;
+				entry.version = server.second.version;
+				entry.offset = ss.get_write_pos();
+
+				augs::write_bytes(ss, address);
+				augs::write_bytes(ss, server.second.meta.appeared_when);
+				augs::write_bytes(ss, heartbeat);
+
+				entry.size = ss.get_write_pos() - entry.offset;
+				entry.game_mode = heartbeat.game_mode.get_index();
+				entry.is_full = heartbeat.num_online >= heartbeat.max_online;
+				entry.is_behind_nat = heartbeat.is_behind_nat();
+				entry.lowercase_name = to_lowercase(std::string(heartbeat.server_name));
+
+				snapshot.entries.emplace_back(std::move(entry));
+			}
+		}
+
+		std::atomic_store(&published_list, server_list_snapshot::make(std::move(snapshot), compression_state));
+	};
+
+	/*
+		With thousands of gameservers, heartbeats that change something arrive all the time,
+		so the list is only marked as dirty and reserialized at most once per reserialize_once_every_secs.
+	*/
+
+	bool list_dirty = false;
+	auto when_last_reserialized = yojimbo_time();
+
+	auto reserialize_list_if_due = [&](const double current_time) {
+		if (list_dirty && current_time - when_last_reserialized >= settings.reserialize_once_every_secs) {
+			reserialize_list();
+
+			list_dirty = false;
+			when_last_reserialized = current_time;
 		}
 	};
 
-	auto dump_server_list_to_file = [&]() {
+	auto dump_server_list_to_file = [&](const augs::path_type& masterserver_dump_path) {
 		const auto n = server_list.size();
 
 		if (n > 0) {
 			LOG("Saving %x servers to %x", n, masterserver_dump_path);
-			augs::bytes_to_file(std::as_const(serialized_list), masterserver_dump_path);
+			augs::bytes_to_file(std::atomic_load(&published_list)->bytes, masterserver_dump_path);
 		}
 		else {
 			LOG("The server list is empty: deleting the dump file.");
@@ -154,7 +278,7 @@ void perform_masterserver(const config_lua_table& cfg) try {
 		}
 	};
 
-	auto load_server_list_from_file = [&]() {
+	auto load_server_list_from_file = [&](const augs::path_type& masterserver_dump_path) {
 		try {
 			auto source = augs::open_binary_input_stream(masterserver_dump_path);
 
@@ -170,6 +294,7 @@ void perform_masterserver(const config_lua_table& cfg) try {
 				augs::read_bytes(source, entry.last_heartbeat);
 
 				entry.time_of_last_heartbeat = current_time;
+				entry.version = ++list_version;
 
 				server_list.try_emplace(address, std::move(entry));
 			}
@@ -188,79 +313,154 @@ void perform_masterserver(const config_lua_table& cfg) try {
 		}
 	};
 
-	load_server_list_from_file();
-
-	auto make_list_streamer_lambda = [&]() {
-		return [data=serialized_list](uint64_t offset, uint64_t length, DataSink sink) {
-			sink(reinterpret_cast<const char*>(&data[offset]), length);
-		};
-	};
+	if (in.dump_path) {
+		load_server_list_from_file(*in.dump_path);
+	}
 
 	auto remove_from_list = [&](const auto& by_external_addr) {
 		server_list.erase(by_external_addr);
-		reserialize_list();
+		remember_removal(by_external_addr);
+		list_dirty = true;
 	};
 
-	auto define_http_server = [&]() {
-		http.Get("/server_list_binary", [&](const Request&, Response& res) {
-			std::shared_lock<std::shared_mutex> lock(serialized_list_mutex);
+	auto parse_query = [](const httplib::Request& req) {
+		server_list_query q;
 
-			if (serialized_list.size() > 0) {
-				MSR_LOG("List request arrived. Sending list of size: %x", serialized_list.size());
+		auto param = [&req](const char* key) {
+			return req.get_param_value(key);
+		};
 
-				res.set_content_provider(
-					serialized_list.size(),
-					make_list_streamer_lambda()
-				);
+		auto param_u64 = [&](const char* key) -> std::optional<uint64_t> {
+			try {
+				if (req.has_param(key)) {
+					return std::stoull(param(key));
+				}
 			}
-		});
-	};
+			catch (const std::exception&) {
 
-	define_http_server();
+			}
 
-	LOG("Hosting a server list at port: %x (HTTP)", settings.server_list_port);
+			return std::nullopt;
+		};
 
-	auto listening_thread = std::thread([&http, in_settings=settings]() {
-		http.listen(in_settings.ip.c_str(), in_settings.server_list_port);
-		LOG("The HTTP listening thread has quit.");
-	});
+		if (const auto game_mode = param_u64("game_mode")) {
+			q.game_mode = static_cast<uint32_t>(*game_mode);
+		}
 
-	uint8_t packet_buffer[NETCODE_MAX_PACKET_BYTES];
+		q.only_not_full = param("not_full") == "1";
+		q.only_public = param("public") == "1";
+		q.name_substring = param("name");
 
-	while (true) {
-#if PLATFORM_UNIX
-		if (signal_status != 0) {
-			const auto sig = signal_status;
-
-			LOG("%x received.", strsignal(sig));
-
-			if(
-				sig == SIGINT
-				|| sig == SIGSTOP
-				|| sig == SIGTERM
-			) {
-				LOG("Gracefully shutting down.");
-				break;
+		q.since_version = param_u64("since");
+		q.epoch = param_u64("epoch").value_or(0);
+
+		q.compressed = param(server_list_compression_param_v) == "lz4";
+
+		return q;
+	};
+
+	auto define_http_server = [&]() {
+		http.Get("/server_list_binary", [&](const Request& req, Response& res) {
+			const auto snapshot = std::atomic_load(&published_list);
+
+			if (snapshot->bytes.empty()) {
+				return;
 			}
-		}
-#endif
 
-		const auto current_time = yojimbo_time();
+			const bool compressed = req.get_param_value(server_list_compression_param_v) == "lz4";
+			const auto& etag = compressed ? snapshot->compressed_etag : snapshot->etag;
 
-		auto process_socket_messages = [&](auto& socket) {
-			netcode_address_t from;
-			const auto packet_bytes = netcode_socket_receive_packet(&socket, &from, packet_buffer, NETCODE_MAX_PACKET_BYTES);
+			res.set_header("ETag", etag);
 
-			if (packet_bytes < 1) {
+			if (req.get_header_value("If-None-Match") == etag) {
+				MSR_LOG("List request arrived. The list has not changed.");
+
+				res.status = 304;
 				return;
 			}
 
+			const auto& body = compressed ? snapshot->compressed : snapshot->bytes;
+
+			if (compressed) {
+				res.set_header(server_list_uncompressed_size_header_v, std::to_string(snapshot->bytes.size()));
+			}
+
+			MSR_LOG("List request arrived. Sending list of size: %x", body.size());
+
+			/* Holding the snapshot keeps the body alive until it is sent. */
+
+			res.set_content_provider(
+				body.size(),
+				[snapshot, &body](uint64_t offset, uint64_t length, DataSink sink) {
+					sink(reinterpret_cast<const char*>(body.data() + offset), length);
+				}
+			);
+		});
+
+		http.Get("/server_list_query", [&](const Request& req, Response& res) {
+			const auto snapshot = std::atomic_load(&published_list);
+			const auto query = parse_query(req);
+
+			auto answer = std::make_shared<std::vector<std::byte>>(snapshot->answer(query));
+
+			if (query.compressed) {
+				res.set_header(server_list_uncompressed_size_header_v, std::to_string(answer->size()));
+
+				auto state = augs::make_compression_state();
+				*answer = augs::compress(state, *answer);
+			}
+
+			MSR_LOG("List query arrived. Sending an answer of size: %x", answer->size());
+
+			res.set_content_provider(
+				answer->size(),
+				[answer](uint64_t offset, uint64_t length, DataSink sink) {
+					sink(reinterpret_cast<const char*>(answer->data() + offset), length);
+				}
+			);
+		});
+	};
+
+	std::thread listening_thread;
+
+	if (in.host_server_list) {
+		define_http_server();
+
+		LOG("Hosting a server list at port: %x (HTTP)", settings.server_list_port);
+
+		listening_thread = std::thread([&http, in_settings=settings]() {
+			http.listen(in_settings.ip.c_str(), in_settings.server_list_port);
+			LOG("The HTTP listening thread has quit.");
+		});
+	}
+
+	/* Timeouts are counted in seconds, so there is no need to check them more often. */
+	const auto check_timeouts_once_every_secs = 1.0;
+	auto when_last_checked_timeouts = yojimbo_time();
+
+	while (!quit_requested.load(std::memory_order_relaxed)) {
+		if (should_quit_on_signal()) {
+			break;
+		}
+
+		sockets.wait(std::min(settings.sleep_ms / 1000, settings.reserialize_once_every_secs));
+
+		const auto current_time = yojimbo_time();
+
+		auto process_socket_message = [&](
+			const std::size_t socket_index,
+			const netcode_address_t& from,
+			const std::byte* const packet_buffer,
+			const int packet_bytes
+		) {
+#if LOG_MASTERSERVER_PACKETS
 			MSR_LOG("Received packet bytes: %x", packet_bytes);
+#endif
 
 			try {
 				auto send_to = [&](auto to, const auto& typed_response) {
 					auto bytes = augs::to_bytes(masterserver_response(typed_response));
-					netcode_socket_send_packet(&socket, &to, bytes.data(), bytes.size());
+					sockets.send(socket_index, to, bytes.data(), bytes.size());
 				};
 
 				auto send_back = [&](const auto& typed_response) {
@@ -269,7 +469,7 @@ void perform_masterserver(const config_lua_table& cfg) try {
 
 				auto send_to_gameserver = [&](const auto& typed_command, netcode_address_t server_address) {
 					auto bytes = make_gameserver_command_bytes(typed_command);
-					netcode_socket_send_packet(&socket, &server_address, bytes.data(), bytes.size());
+					sockets.send(socket_index, server_address, bytes.data(), bytes.size());
 				};
 
 				auto handle = [&](const auto& typed_request) {
@@ -282,6 +482,8 @@ void perform_masterserver(const config_lua_table& cfg) try {
 						}
 					}
 					else if constexpr(std::is_same_v<R, masterserver_in::heartbeat>) {
+						counters.heartbeats.fetch_add(1, std::memory_order_relaxed);
+
 						auto it = server_list.try_emplace(from);
 
 						const bool is_new_server = it.second;
@@ -293,10 +495,13 @@ void perform_masterserver(const config_lua_table& cfg) try {
 
 						const bool heartbeats_mismatch = heartbeat_before != server_entry.last_heartbeat;
 
+#if LOG_MASTERSERVER_PACKETS
 						MSR_LOG_NVPS(is_new_server, heartbeats_mismatch);
+#endif
 
 						if (is_new_server || heartbeats_mismatch) {
-							reserialize_list();
+							server_entry.version = ++list_version;
+							list_dirty = true;
 						}
 					}
 					else if constexpr(std::is_same_v<R, masterserver_in::tell_me_my_address>) {
@@ -385,10 +590,17 @@ void perform_masterserver(const config_lua_table& cfg) try {
 			}
 		};
 
-		for (auto& s : udp_command_sockets) {
-			process_socket_messages(s.socket);
+		sockets.receive(process_socket_message);
+		sockets.flush_sends();
+
+		reserialize_list_if_due(current_time);
+
+		if (current_time - when_last_checked_timeouts < check_timeouts_once_every_secs) {
+			continue;
 		}
 
+		when_last_checked_timeouts = current_time;
+
 		const auto timeout_secs = settings.server_entry_timeout_secs;
 
 		auto process_entry_logic = [&](auto& server_entry) {
@@ -400,6 +612,7 @@ void perform_masterserver(const config_lua_table& cfg) try {
 
 			if (timed_out) {
 				LOG("The server at %x (%x) has timed out.", ::ToString(server_entry.first), server_entry.second.last_heartbeat.server_name);
+				remember_removal(server_entry.first);
 			}
 			else {
 				process_entry_logic(server_entry);
@@ -412,19 +625,353 @@ void perform_masterserver(const config_lua_table& cfg) try {
 		erase_if(server_list, erase_if_dead);
 
 		if (previous_size != server_list.size()) {
+			list_dirty = true;
+		}
+	}
+
+	if (in.host_server_list) {
+		LOG("Stopping the HTTP masterserver.");
+		http.stop();
+		LOG("Joining the HTTP listening thread.");
+		listening_thread.join();
+	}
+
+	if (in.dump_path) {
+		if (list_dirty) {
 			reserialize_list();
 		}
 
-		yojimbo_sleep(settings.sleep_ms / 1000);
+		dump_server_list_to_file(*in.dump_path);
+	}
+
+	return true;
+}
+catch (const netcode_socket_raii_error& err) {
+	LOG(err.what());
+	return false;
+}
+
+void perform_masterserver(const config_lua_table& cfg) {
+	masterserver_run_input in;
+	in.settings = cfg.masterserver;
+	in.dump_path = augs::path_type(USER_FILES_DIR) / "masterserver.dump";
+
+	masterserver_counters counters;
+	const std::atomic<bool> never_quit = false;
+
+	run_masterserver(in, counters, never_quit);
+}
+
+
+bool perform_masterserver_benchmark(const config_lua_table& cfg, const unsigned num_gameservers) try {
+	const auto duration_secs = 10.0;
+
+	/* Heartbeats that were neither processed this long after sending are assumed to be dropped. */
+	const auto assume_lost_after_secs = 0.1;
+	const auto max_in_flight = int64_t(4096);
+
+	/* Every this many rounds, a gameserver reports a changed player count so that the list has to be reserialized. */
+	const auto change_once_every_rounds = 8u;
+
+	masterserver_run_input in;
+	in.settings = cfg.masterserver;
+	in.settings.ip = "127.0.0.1";
+	in.settings.first_udp_command_port += 1000;
+	in.settings.server_entry_timeout_secs = static_cast<unsigned>(duration_secs) * 2;
+	in.host_server_list = false;
+
+	LOG(
+		"Performing masterserver benchmark with %x fake gameservers against ports %x-%x.",
+		num_gameservers,
+		in.settings.first_udp_command_port,
+		in.settings.get_last_udp_command_port()
+	);
+
+#if PLATFORM_UNIX
+	{
+		rlimit limit;
+
+		if (getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur < limit.rlim_max) {
+			limit.rlim_cur = limit.rlim_max;
+			setrlimit(RLIMIT_NOFILE, &limit);
+		}
+	}
+#endif
+
+	masterserver_counters counters;
+	std::atomic<bool> quit_requested = false;
+
+	auto masterserver_thread = std::thread([&]() {
+		run_masterserver(in, counters, quit_requested);
+	});
+
+	auto stop_masterserver = [&]() {
+		quit_requested = true;
+
+		if (masterserver_thread.joinable()) {
+			masterserver_thread.join();
+		}
+	};
+
+	struct stop_on_exit {
+		decltype(stop_masterserver)& stop;
+		~stop_on_exit() { stop(); }
+	} stop_guard { stop_masterserver };
+
+	{
+		const auto when_started_waiting = yojimbo_time();
+
+		while (!counters.sockets_ready.load()) {
+			if (yojimbo_time() - when_started_waiting > 5.0) {
+				LOG("The masterserver failed to start.");
+				return false;
+			}
+
+			yojimbo_sleep(0.01);
+		}
+	}
+
+	struct fake_gameserver {
+		netcode_socket_raii socket;
+		netcode_address_t target;
+
+		std::vector<std::byte> heartbeat_bytes[2];
+	};
+
+	std::vector<fake_gameserver> gameservers;
+	gameservers.reserve(num_gameservers);
+
+	for (unsigned i = 0; i < num_gameservers; ++i) {
+		const auto local_address = to_netcode_addr(in.settings.ip, 0);
+		const auto target_port = in.settings.first_udp_command_port + i % in.settings.num_udp_command_ports;
+		const auto target = to_netcode_addr(in.settings.ip, target_port);
+
+		if (!local_address || !target) {
+			LOG("Could not resolve %x.", in.settings.ip);
+			return false;
+		}
+
+		auto& fake = gameservers.emplace_back(fake_gameserver { netcode_socket_raii(*local_address), *target, {} });
+
+		server_heartbeat heartbeat;
+		heartbeat.server_name = typesafe_sprintf("Fake server %x", i);
+		heartbeat.current_arena = "de_cyberaqua";
+		heartbeat.num_fighting = 0;
+		heartbeat.max_fighting = 10;
+		heartbeat.num_online = 0;
+		heartbeat.max_online = 20;
+
+		for (auto& bytes : fake.heartbeat_bytes) {
+			bytes = augs::to_bytes(masterserver_request(heartbeat));
+			++heartbeat.num_online;
+		}
+	}
+
+	LOG("Created %x fake gameservers.", gameservers.size());
+
+	uint64_t sent = 0;
+	uint64_t assumed_lost = 0;
+	unsigned round = 0;
+
+	const auto heartbeats_before = counters.heartbeats.load();
+	const auto reserializations_before = counters.reserializations.load();
+	const auto when_started = yojimbo_time();
+
+	auto processed = [&]() {
+		return counters.heartbeats.load(std::memory_order_relaxed) - heartbeats_before;
+	};
+
+	auto in_flight = [&]() {
+		return static_cast<int64_t>(sent) - static_cast<int64_t>(processed() + assumed_lost);
+	};
+
+	while (yojimbo_time() - when_started < duration_secs && !should_quit_on_signal()) {
+		for (std::size_t i = 0; i < gameservers.size(); ++i) {
+			auto& fake = gameservers[i];
+
+			const auto variant = ((round + i) / change_once_every_rounds) % 2;
+			auto& bytes = fake.heartbeat_bytes[variant];
+
+			{
+				/* Don't overflow the receive buffers, so that the processing rate is measured, not the loss. */
+
+				auto when_started_waiting = yojimbo_time();
+
+				while (in_flight() >= max_in_flight) {
+					if (yojimbo_time() - when_started_waiting > assume_lost_after_secs) {
+						assumed_lost = sent - processed();
+						break;
+					}
+
+					std::this_thread::yield();
+				}
+			}
+
+			netcode_socket_send_packet(&fake.socket.socket, &fake.target, bytes.data(), static_cast<int>(bytes.size()));
+			++sent;
+		}
+
+		++round;
 	}
 
-	LOG("Stopping the HTTP masterserver.");
-	http.stop();
-	LOG("Joining the HTTP listening thread.");
-	listening_thread.join();
+	const auto elapsed = yojimbo_time() - when_started;
+
+	/* Let the masterserver drain what is still queued. */
+	yojimbo_sleep(assume_lost_after_secs);
+
+	const auto total_processed = processed();
+	const auto reserializations = counters.reserializations.load() - reserializations_before;
+
+	stop_masterserver();
 
-	dump_server_list_to_file();
+	LOG(
+		"(Masterserver benchmark) %x gameservers, %x rounds in %x s.\nSent: %x heartbeats (%f2 per second).\nProcessed: %x heartbeats (%f2 per second), lost: %x.\nReserialized the list %x times.",
+		gameservers.size(),
+		round,
+		elapsed,
+		sent,
+		sent / elapsed,
+		total_processed,
+		total_processed / elapsed,
+		sent > total_processed ? sent - total_processed : 0,
+		reserializations
+	);
+
+	return total_processed > 0;
 }
 catch (const netcode_socket_raii_error& err) {
 	LOG(err.what());
+	return false;
 }
+
+#if BUILD_UNIT_TESTS
+#include <Catch/single_include/catch2/catch.hpp>
+
+TEST_CASE("Masterserver ServerListQueries") {
+	auto make_address = [](const uint8_t last, const uint16_t port) {
+		netcode_address_t a;
+		std::memset(&a, 0, sizeof(a));
+
+		a.type = NETCODE_ADDRESS_IPV4;
+		a.data.ipv4[0] = 10;
+		a.data.ipv4[3] = last;
+		a.port = port;
+
+		return a;
+	};
+
+	server_list_snapshot in;
+	in.epoch = 7;
+	in.version = 10;
+	in.min_delta_since = 2;
+	in.removals.push_back({ make_address(100, 1), 6 });
+
+	auto add = [&](const uint8_t last, const uint64_t version, const uint32_t game_mode, const bool is_full, const std::string& name) {
+		server_list_snapshot_entry e;
+		e.address = make_address(last, 8000);
+		e.version = version;
+		e.offset = in.bytes.size();
+		e.size = 1;
+		e.game_mode = game_mode;
+		e.is_full = is_full;
+		e.lowercase_name = name;
+
+		in.bytes.push_back(std::byte(last));
+		in.entries.push_back(e);
+	};
+
+	add(1, 3, 0, false, "first arena");
+	add(2, 9, 1, true, "second arena");
+	add(3, 5, 1, false, "third");
+
+	auto state = augs::make_compression_state();
+	const auto snapshot = server_list_snapshot::make(std::move(in), state);
+
+	struct parsed {
+		uint64_t epoch = 0;
+		uint64_t version = 0;
+		uint8_t is_delta = 0;
+		std::vector<netcode_address_t> removed;
+		std::vector<uint8_t> sent;
+	};
+
+	auto ask = [&](const server_list_query& q) {
+		const auto bytes = snapshot->answer(q);
+		auto s = augs::make_read_stream(bytes.data(), bytes.size());
+
+		parsed out;
+		augs::read_bytes(s, out.epoch);
+		augs::read_bytes(s, out.version);
+		augs::read_bytes(s, out.is_delta);
+
+		const auto num_removed = augs::read_bytes<uint32_t>(s);
+
+		for (uint32_t i = 0; i < num_removed; ++i) {
+			out.removed.push_back(augs::read_bytes<netcode_address_t>(s));
+		}
+
+		while (s.has_unread_bytes()) {
+			out.sent.push_back(augs::read_bytes<uint8_t>(s));
+		}
+
+		return out;
+	};
+
+	{
+		const auto full = ask(server_list_query());
+
+		REQUIRE(full.epoch == 7);
+		REQUIRE(full.version == 10);
+		REQUIRE(full.is_delta == 0);
+		REQUIRE(full.removed.empty());
+		REQUIRE(full.sent.size() == 3);
+	}
+
+	{
+		server_list_query q;
+		q.game_mode = 1;
+		q.only_not_full = true;
+
+		const auto filtered = ask(q);
+		REQUIRE(filtered.sent == std::vector<uint8_t> { 3 });
+	}
+
+	{
+		server_list_query q;
+		q.name_substring = "ARENA";
+
+		REQUIRE(ask(q).sent.size() == 2);
+	}
+
+	{
+		server_list_query q;
+		q.since_version = 4;
+		q.epoch = 7;
+		q.only_not_full = true;
+
+		/* The third server changed and passes, the second changed but is now full. */
+
+		const auto delta = ask(q);
+
+		REQUIRE(delta.is_delta == 1);
+		REQUIRE(delta.sent == std::vector<uint8_t> { 3 });
+		REQUIRE(delta.removed.size() == 2);
+		REQUIRE(delta.removed[0].data.ipv4[3] == 100);
+		REQUIRE(delta.removed[1].data.ipv4[3] == 2);
+	}
+
+	{
+		server_list_query q;
+		q.since_version = 4;
+
+		/* A different epoch means that the masterserver has restarted. */
+		q.epoch = 8;
+		REQUIRE(ask(q).is_delta == 0);
+
+		/* Removals older than this were forgotten. */
+		q.epoch = 7;
+		q.since_version = 1;
+		REQUIRE(ask(q).is_delta == 0);
+	}
+}
+#endif
@@ -37,3 +37,11 @@ using masterserver_response = std::variant<
 >;
 
 void perform_masterserver(const config_lua_table&);
+
+/*
+	Runs a masterserver on the loopback interface
+	and floods it with heartbeats from num_gameservers fake gameservers,
+	reporting how many of them it can process per second.
+*/
+
+bool perform_masterserver_benchmark(const config_lua_table&, unsigned num_gameservers);
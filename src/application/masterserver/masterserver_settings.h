@@ -15,6 +15,7 @@ struct masterserver_settings {
 	augs::path_type key_pem_path;
 
 	float sleep_ms = 8;
+	float reserialize_once_every_secs = 0.25f;
 	// END GEN INTROSPECTOR
 
 	port_type get_last_udp_command_port() const {
@@ -0,0 +1,85 @@
+#pragma once
+#include <string>
+#include <cctype>
+#include <cstdint>
+#include <optional>
+
+#include "augs/string/typesafe_sprintf.h"
+
+/*
+	A request for a part of the server list, answered by the masterserver at /server_list_query.
+
+	The filters select which servers are sent.
+	If since_version is set and the masterserver still remembers every change made after it,
+	only the servers changed since then are sent, along with the addresses of the servers
+	that were removed or stopped passing the filters - the client then applies them to its cached list.
+	The same filters have to be used for every delta, otherwise a full list has to be requested.
+*/
+
+struct server_list_query {
+	std::optional<uint32_t> game_mode;
+	bool only_not_full = false;
+	bool only_public = false;
+	std::string name_substring;
+
+	std::optional<uint64_t> since_version;
+	uint64_t epoch = 0;
+
+	bool compressed = true;
+
+	std::string to_request_path() const {
+		auto path = std::string("/server_list_query?");
+
+		auto add = [&path](const auto& key, const auto& value) {
+			if (path.back() != '?') {
+				path += '&';
+			}
+
+			path += typesafe_sprintf("%x=%x", key, value);
+		};
+
+		if (game_mode) {
+			add("game_mode", *game_mode);
+		}
+
+		if (only_not_full) {
+			add("not_full", 1);
+		}
+
+		if (only_public) {
+			add("public", 1);
+		}
+
+		if (!name_substring.empty()) {
+			std::string encoded;
+
+			for (const auto c : name_substring) {
+				const auto u = static_cast<unsigned char>(c);
+
+				if (std::isalnum(u) || c == '-' || c == '_' || c == '.' || c == '~') {
+					encoded += c;
+				}
+				else {
+					const char* const hex = "0123456789ABCDEF";
+
+					encoded += '%';
+					encoded += hex[u >> 4];
+					encoded += hex[u & 15];
+				}
+			}
+
+			add("name", encoded);
+		}
+
+		if (since_version) {
+			add("since", *since_version);
+			add("epoch", epoch);
+		}
+
+		if (compressed) {
+			add("compression", "lz4");
+		}
+
+		return path;
+	}
+};
@@ -0,0 +1,230 @@
+#pragma once
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <algorithm>
+#include <unordered_map>
+
+#include "3rdparty/yojimbo/netcode.io/netcode.h"
+#include "augs/misc/compress.h"
+#include "augs/readwrite/crc32_stream.h"
+#include "augs/readwrite/memory_stream.h"
+#include "augs/readwrite/byte_readwrite.h"
+#include "augs/string/typesafe_sprintf.h"
+#include "augs/string/string_templates_declaration.h"
+#include "application/masterserver/server_list_query.h"
+
+/*
+	Appending ?compression=lz4 to the list request makes the masterserver
+	send the lz4-compressed list, with its uncompressed size in this header.
+*/
+
+constexpr auto server_list_compression_param_v = "compression";
+constexpr auto server_list_uncompressed_size_header_v = "X-Uncompressed-Size";
+
+struct server_list_snapshot_entry {
+	netcode_address_t address;
+
+	/* The list version at which this server was last added or changed. */
+	uint64_t version = 0;
+
+	/* Where the serialized entry lies within the bytes of the snapshot. */
+	std::size_t offset = 0;
+	std::size_t size = 0;
+
+	uint32_t game_mode = 0;
+	bool is_full = false;
+	bool is_behind_nat = false;
+	std::string lowercase_name;
+};
+
+struct server_list_removal {
+	netcode_address_t address;
+	uint64_t version = 0;
+};
+
+/*
+	The serialized server list as published by the masterserver.
+
+	It is never modified after being published - the masterserver publishes a new one instead,
+	so the HTTP handlers can stream it for as long as they hold a reference,
+	without copying it or locking anything.
+*/
+
+struct server_list_snapshot {
+	std::vector<std::byte> bytes;
+	std::vector<std::byte> compressed;
+
+	std::string etag;
+	std::string compressed_etag;
+
+	/* Changes every time the masterserver starts, as the versions start over. */
+	uint64_t epoch = 0;
+	uint64_t version = 0;
+
+	/* Deltas since versions older than this can't be answered as the removals were forgotten. */
+	uint64_t min_delta_since = 0;
+
+	std::vector<server_list_snapshot_entry> entries;
+	std::vector<server_list_removal> removals;
+
+	/* Indices of the entries sorted by their versions. */
+	std::vector<std::size_t> by_version;
+	std::unordered_map<uint32_t, std::vector<std::size_t>> by_game_mode;
+
+	static auto make(
+		server_list_snapshot&& in,
+		std::vector<std::byte>& compression_state
+	) {
+		auto out = std::make_shared<server_list_snapshot>(std::move(in));
+
+		if (out->bytes.size() > 0) {
+			augs::compress(compression_state, out->bytes, out->compressed);
+		}
+
+		augs::crc32_stream crc;
+		crc.write(out->bytes.data(), out->bytes.size());
+
+		const auto tag = typesafe_sprintf("%x-%x", crc.get_hash(), out->bytes.size());
+
+		out->etag = "\"" + tag + "\"";
+		out->compressed_etag = "\"" + tag + "-lz4\"";
+
+		auto& entries = out->entries;
+
+		out->by_version.resize(entries.size());
+
+		for (std::size_t i = 0; i < entries.size(); ++i) {
+			out->by_version[i] = i;
+			out->by_game_mode[entries[i].game_mode].push_back(i);
+		}
+
+		std::sort(
+			out->by_version.begin(),
+			out->by_version.end(),
+			[&entries](const auto a, const auto b) {
+				return entries[a].version < entries[b].version;
+			}
+		);
+
+		return std::shared_ptr<const server_list_snapshot>(std::move(out));
+	}
+
+	bool can_answer_delta(const server_list_query& q) const {
+		if (!q.since_version || q.epoch != epoch) {
+			return false;
+		}
+
+		const auto since = *q.since_version;
+		return since >= min_delta_since && since <= version;
+	}
+
+	/*
+		Layout of the answer:
+		epoch, version, whether it is a delta, the number of removed addresses, the removed addresses,
+		and then the serialized entries in the same format as the full list.
+	*/
+
+	std::vector<std::byte> answer(const server_list_query& q) const {
+		const auto name_substring = to_lowercase(q.name_substring);
+
+		auto passes = [&](const server_list_snapshot_entry& e) {
+			if (q.game_mode && *q.game_mode != e.game_mode) {
+				return false;
+			}
+
+			if (q.only_not_full && e.is_full) {
+				return false;
+			}
+
+			if (q.only_public && e.is_behind_nat) {
+				return false;
+			}
+
+			if (!name_substring.empty() && e.lowercase_name.find(name_substring) == std::string::npos) {
+				return false;
+			}
+
+			return true;
+		};
+
+		const bool is_delta = can_answer_delta(q);
+
+		std::vector<netcode_address_t> removed;
+		std::vector<std::size_t> sent;
+
+		if (is_delta) {
+			const auto since = *q.since_version;
+
+			for (const auto& r : removals) {
+				if (r.version > since) {
+					removed.push_back(r.address);
+				}
+			}
+
+			const auto first_changed = std::upper_bound(
+				by_version.begin(),
+				by_version.end(),
+				since,
+				[this](const uint64_t v, const std::size_t i) {
+					return v < entries[i].version;
+				}
+			);
+
+			for (auto it = first_changed; it != by_version.end(); ++it) {
+				const auto& e = entries[*it];
+
+				if (passes(e)) {
+					sent.push_back(*it);
+				}
+				else {
+					/* The client might still have it from before it changed. */
+					removed.push_back(e.address);
+				}
+			}
+		}
+		else {
+			auto add_passing = [&](const std::size_t i) {
+				if (passes(entries[i])) {
+					sent.push_back(i);
+				}
+			};
+
+			if (q.game_mode) {
+				if (const auto found = by_game_mode.find(*q.game_mode); found != by_game_mode.end()) {
+					for (const auto i : found->second) {
+						add_passing(i);
+					}
+				}
+			}
+			else {
+				for (std::size_t i = 0; i < entries.size(); ++i) {
+					add_passing(i);
+				}
+			}
+		}
+
+		std::vector<std::byte> out;
+
+		{
+			auto ss = augs::ref_memory_stream(out);
+
+			augs::write_bytes(ss, epoch);
+			augs::write_bytes(ss, version);
+			augs::write_bytes(ss, static_cast<uint8_t>(is_delta));
+			augs::write_bytes(ss, static_cast<uint32_t>(removed.size()));
+
+			for (const auto& r : removed) {
+				augs::write_bytes(ss, r);
+			}
+
+			for (const auto i : sent) {
+				const auto& e = entries[i];
+				ss.write(bytes.data() + e.offset, e.size);
+			}
+		}
+
+		return out;
+	}
+};
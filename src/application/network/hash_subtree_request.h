@@ -0,0 +1,13 @@
+#pragma once
+#include <cstdint>
+#include "game/cosmos/entity_id.h"
+
+/*
+	Sent by a client whose state diverged at a step for which the server has sent the pool hashes.
+	The server answers with the solvable_hash_subtree of the diverged pool.
+*/
+
+struct hash_subtree_request {
+	uint32_t step = 0;
+	entity_type_id type;
+};
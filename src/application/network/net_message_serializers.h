@@ -41,6 +41,25 @@ namespace net_messages {
 		return true;
 	}
 
+	template <typename Stream>
+	bool hash_subtree_request::Serialize(Stream& stream) {
+		serialize_uint32(stream, payload.step);
+
+		int type_index = 0;
+
+		if (Stream::IsWriting) {
+			type_index = static_cast<int>(payload.type.get_index());
+		}
+
+		serialize_int(stream, type_index, 0, static_cast<int>(num_types_in_list_v<all_entity_types>) - 1);
+
+		if (Stream::IsReading) {
+			payload.type = entity_type_id(static_cast<entity_type_id::index_type>(type_index));
+		}
+
+		return true;
+	}
+
 	template <typename Stream>
 	bool client_welcome::Serialize(Stream& stream) {
 		{
@@ -60,6 +79,9 @@ namespace net_messages {
 		serialize_uint32(stream, payload.net.jitter.buffer_at_least_steps);
 		serialize_uint32(stream, payload.net.jitter.buffer_at_least_ms);
 		serialize_int(stream, payload.net.jitter.max_commands_to_squash_at_once, 0, 255);
+		serialize_int(stream, payload.net.jitter.max_adaptive_steps, 0, max_adaptive_jitter_steps_v);
+		serialize_bool(stream, payload.net.jitter.stretch_catch_up);
+		serialize_bool(stream, payload.relay);
 
 		return true;
 	}
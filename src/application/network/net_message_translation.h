@@ -48,8 +48,57 @@ constexpr std::size_t max_server_step_size_v =
 ;
 
 namespace net_messages {
+	inline bool motion_coord_fits_in_one_byte(const int coord) {
+		return coord >= -7 && coord <= 8;
+	}
+
+	inline bool motion_coord_fits_in_two_bytes(const int coord) {
+		return coord >= -127 && coord <= 128;
+	}
+
+	inline int bytes_to_code_motion(const int x, const int y) {
+		if (motion_coord_fits_in_one_byte(x) && motion_coord_fits_in_one_byte(y)) {
+			return 1;
+		}
+
+		if (motion_coord_fits_in_two_bytes(x) && motion_coord_fits_in_two_bytes(y)) {
+			return 2;
+		}
+
+		return 3;
+	}
+
+	/*
+		Whether the difference from the prediction can be coded in fewer bytes than the motion itself.
+	*/
+
+	inline bool should_code_motion_as_difference(
+		const total_mode_player_entropy& p,
+		const raw_game_motion_offset_type& predicted
+	) {
+		const auto motion = mapped_or_nullptr(p.cosmic.motions, game_motion_type::MOVE_CROSSHAIR);
+
+		if (motion == nullptr || !logically_set(p.cosmic.motions)) {
+			return false;
+		}
+
+		const auto dx = int(motion->x) - int(predicted.x);
+		const auto dy = int(motion->y) - int(predicted.y);
+
+		return bytes_to_code_motion(dx, dy) < bytes_to_code_motion(motion->x, motion->y);
+	}
+
+	/*
+		If motion_prediction is passed, the crosshair motion is coded as a difference from it.
+		The writer must first make sure with should_code_motion_as_difference that it pays off.
+	*/
+
 	template <class Stream>
-	bool serialize(Stream& s, total_mode_player_entropy& p) {
+	bool serialize(
+		Stream& s, 
+		total_mode_player_entropy& p, 
+		const raw_game_motion_offset_type* const motion_prediction = nullptr
+	) {
 		auto& m = p.mode;
 		auto& c = p.cosmic;
 
@@ -57,6 +106,17 @@ namespace net_messages {
 			return c.motions[game_motion_type::MOVE_CROSSHAIR];
 		};
 
+		auto coded_motion = raw_game_motion_offset_type();
+
+		if (Stream::IsWriting && logically_set(c.motions)) {
+			coded_motion = get_motion();
+
+			if (motion_prediction != nullptr) {
+				coded_motion.x -= motion_prediction->x;
+				coded_motion.y -= motion_prediction->y;
+			}
+		}
+
 		bool has_mode_command = logically_set(m);
 
 		bool has_cast_spell = logically_set(c.cast_spell);
@@ -65,16 +125,8 @@ namespace net_messages {
 		bool has_motions = logically_set(c.motions);
 		bool has_transfer = logically_set(c.transfer);
 
-		auto one_byte_pred = [&](const auto& coord) {
-			return coord >= -7 && coord <= 8;
-		};
-
-		auto two_byte_pred = [&](const auto& coord) {
-			return coord >= -127 && coord <= 128;
-		};
-
-		bool motion_writable_in_one_byte = has_motions && one_byte_pred(get_motion().x) && one_byte_pred(get_motion().y);
-		bool motion_writable_in_two_bytes = has_motions && two_byte_pred(get_motion().x) && two_byte_pred(get_motion().y);
+		bool motion_writable_in_one_byte = has_motions && bytes_to_code_motion(coded_motion.x, coded_motion.y) == 1;
+		bool motion_writable_in_two_bytes = has_motions && bytes_to_code_motion(coded_motion.x, coded_motion.y) <= 2;
 
 		serialize_bool(s, has_mode_command);
 		serialize_bool(s, has_cast_spell);
@@ -142,7 +194,7 @@ namespace net_messages {
 		if (has_motions) {
 			static_assert(int(game_motion_type::COUNT) == 1);
 
-			const auto pos_before = s.GetBytesProcessed();
+			const auto pos_before = s.GetBitsProcessed();
 
 			int min_bound = 0;
 			int max_bound = 0;
@@ -173,9 +225,14 @@ namespace net_messages {
 
 				mot.x -= offset;
 				mot.y -= offset;
+
+				if (motion_prediction != nullptr) {
+					mot.x += motion_prediction->x;
+					mot.y += motion_prediction->y;
+				}
 			}
 			else {
-				auto mot = get_motion();
+				auto mot = coded_motion;
 
 				mot.x += offset;
 				mot.y += offset;
@@ -185,16 +242,16 @@ namespace net_messages {
 			}
 
 			{
-				const auto pos_after = s.GetBytesProcessed();
+				const auto pos_after = s.GetBitsProcessed();
 
 				if (motion_writable_in_one_byte) {
-					ensure_eq(1, pos_after - pos_before);
+					ensure_eq(8, pos_after - pos_before);
 				}
 				else if (motion_writable_in_two_bytes) {
-					ensure_eq(2, pos_after - pos_before);
+					ensure_eq(16, pos_after - pos_before);
 				}
 				else {
-					ensure_eq(3, pos_after - pos_before);
+					ensure_eq(24, pos_after - pos_before);
 				}
 			}
 		}
@@ -208,8 +265,19 @@ namespace net_messages {
 		return true;
 	}
 
+	/*
+		If the predictor is passed, the writer codes the crosshair motions of players
+		as differences from the last step wherever it saves space.
+		The reader needs the predictor only if the step was written with one,
+		so steps written without it stay readable by everyone - e.g. from older demos.
+	*/
+
 	template <class Stream>
-	bool serialize(Stream& s, ::networked_server_step_entropy& total_networked) {
+	bool serialize(
+		Stream& s, 
+		::networked_server_step_entropy& total_networked,
+		const ::server_step_entropy_predictor* const predictor = nullptr
+	) {
 		auto& i = total_networked.payload;
 		auto& g = i.general;
 
@@ -222,6 +290,9 @@ namespace net_messages {
 		auto& state_hash = total_networked.meta.state_hash;
 		bool has_state_hash = logically_set(state_hash);
 
+		auto& pool_hashes = total_networked.meta.pool_hashes;
+		bool has_pool_hashes = pool_hashes != std::nullopt;
+
 		bool has_players = logically_set(i.players);
 		bool has_added_player = logically_set(g.added_player);
 		bool has_removed_player = logically_set(g.removed_player);
@@ -235,8 +306,21 @@ namespace net_messages {
 
 		serialize_bool(s, total_networked.meta.reinference_necessary);
 
+		bool predicted = Stream::IsWriting && predictor != nullptr && has_players;
+
+		/* Fits in the padding of the header, so unpredicted steps cost nothing more. */
+		serialize_bool(s, predicted);
+
+		/* Likewise. Older streams have a zero here. */
+		serialize_bool(s, has_pool_hashes);
+
 		serialize_align(s);
 
+		if (predicted && predictor == nullptr) {
+			/* The reader has no history of steps to predict from. */
+			return false;
+		}
+
 		if (has_state_hash) {
 			if (state_hash == std::nullopt) {
 				state_hash.emplace();
@@ -248,6 +332,19 @@ namespace net_messages {
 			state_hash = std::nullopt;
 		}
 
+		if (has_pool_hashes) {
+			if (pool_hashes == std::nullopt) {
+				pool_hashes.emplace();
+			}
+
+			for (auto& h : *pool_hashes) {
+				serialize_uint32(s, h);
+			}
+		}
+		else {
+			pool_hashes = std::nullopt;
+		}
+
 		if (has_players) {
 			auto& p = i.players;
 			auto cnt = static_cast<int>(p.size());
@@ -259,11 +356,38 @@ namespace net_messages {
 			}
 
 			for (auto& pp : p) {
-				if (!serialize(s, pp.player_id)) {
-					return false;
+				if (!predicted) {
+					if (!serialize(s, pp.player_id)) {
+						return false;
+					}
+
+					if (!serialize(s, pp.total)) {
+						return false;
+					}
+
+					continue;
 				}
 
-				if (!serialize(s, pp.total)) {
+				/* 
+					The id takes 7 bits, 
+					so whether the motion is coded as a difference fits in the padding.
+				*/
+
+				static const auto max_id = mode_player_id::machine_admin();
+				serialize_int(s, pp.player_id.value, 0, max_id.value);
+
+				const auto motion_prediction = predictor->predict_motion_of(pp.player_id);
+
+				bool motion_as_difference = 
+					Stream::IsWriting 
+					&& motion_prediction != nullptr 
+					&& should_code_motion_as_difference(pp.total, *motion_prediction)
+				;
+
+				serialize_bool(s, motion_as_difference);
+				serialize_align(s);
+
+				if (!serialize(s, pp.total, motion_as_difference ? motion_prediction : nullptr)) {
 					return false;
 				}
 			}
@@ -290,11 +414,11 @@ namespace net_messages {
 		return true;
 	}
 
-	template <class B, class T>
-	bool safe_write(B& bytes, T& payload) {
+	template <class B, class T, class... Args>
+	bool safe_write(B& bytes, T& payload, Args&&... args) {
 		auto s = yojimbo::WriteStream(yojimbo::GetDefaultAllocator(), (uint8_t*)bytes.data(), bytes.size());
 
-		if (!serialize(s, payload)) {
+		if (!serialize(s, payload, std::forward<Args>(args)...)) {
 			return false;
 		}
 
@@ -304,10 +428,10 @@ namespace net_messages {
 		return true;
 	}
 
-	template <class B, class T>
-	bool safe_read(const B& bytes, T& payload) {
+	template <class B, class T, class... Args>
+	bool safe_read(const B& bytes, T& payload, Args&&... args) {
 		auto s = yojimbo::ReadStream(yojimbo::GetDefaultAllocator(), (const uint8_t*)bytes.data(), bytes.size());
-		return serialize(s, payload);
+		return serialize(s, payload, std::forward<Args>(args)...);
 	}
 
 #if CONTEXTS_SEPARATE
@@ -326,11 +450,38 @@ namespace net_messages {
 		return safe_read(bytes, output);
 	}
 
+	inline bool server_step_entropy::read_payload(
+		::networked_server_step_entropy& output,
+		const ::server_step_entropy_predictor& predictor
+	) {
+		return safe_read(bytes, output, std::addressof(predictor));
+	}
+
 	inline bool server_step_entropy::write_payload(::networked_server_step_entropy& input) {
 		bytes.resize(max_server_step_size_v);
 		return safe_write(bytes, input);
 	}
 
+	inline bool server_step_entropy::write_payload(
+		const ::preserialized_server_step_entropy& input,
+		const ::prestep_client_context& context
+	) {
+		if (input.bytes.empty()) {
+			return false;
+		}
+
+		bytes = input.bytes;
+
+#if !CONTEXTS_SEPARATE
+		static_assert(sizeof(context.num_entropies_accepted) == 1, "The context must fit in the first byte of a serialized step.");
+		bytes[0] = static_cast<std::byte>(context.num_entropies_accepted);
+#else
+		(void)context;
+#endif
+
+		return true;
+	}
+
 	inline bool client_entropy::read_payload(
 		total_client_entropy& output
 	) {
@@ -519,25 +670,153 @@ namespace net_messages {
 		return true;
 	}
 
+	inline bool hash_subtree_request::write_payload(
+		const decltype(hash_subtree_request::payload)& input
+	) {
+		if (!input.type.is_set()) {
+			return false;
+		}
+
+		payload = input;
+		return true;
+	}
+
+	inline bool hash_subtree_request::read_payload(
+		decltype(hash_subtree_request::payload)& output
+	) {
+		output = payload;
+		return true;
+	}
+
+	inline bool hash_subtree::read_payload(
+		solvable_hash_subtree& subtree
+	) {
+		using node_type = solvable_hash_tree::entity_node;
+
+		auto data = reinterpret_cast<const std::byte*>(GetBlockData());
+		auto size = static_cast<std::size_t>(GetBlockSize());
+
+		uint32_t type_index = 0;
+		uint32_t num_entities = 0;
+		uint32_t num_components = 0;
+
+		const auto header_size = sizeof(subtree.step) + sizeof(type_index) + sizeof(num_entities) + sizeof(num_components);
+
+		if (size < header_size) {
+			return false;
+		}
+
+		auto read_next = [&data](auto& into) {
+			std::memcpy(&into, data, sizeof(into));
+			data += sizeof(into);
+		};
+
+		read_next(subtree.step);
+		read_next(type_index);
+		read_next(num_entities);
+		read_next(num_components);
+
+		size -= header_size;
+
+		if (type_index >= num_types_in_list_v<all_entity_types>) {
+			return false;
+		}
+
+		const auto entities_bytes = std::size_t(num_entities) * sizeof(node_type);
+		const auto components_bytes = std::size_t(num_components) * sizeof(solvable_hash_type);
+
+		if (size != entities_bytes + components_bytes) {
+			return false;
+		}
+
+		subtree.type = entity_type_id(static_cast<entity_type_id::index_type>(type_index));
+
+		subtree.entities.resize(num_entities);
+		subtree.component_hashes.resize(num_components);
+
+		std::memcpy(subtree.entities.data(), data, entities_bytes);
+		std::memcpy(subtree.component_hashes.data(), data + entities_bytes, components_bytes);
+
+		for (const auto& e : subtree.entities) {
+			if (std::size_t(e.first_component) + e.num_components > num_components) {
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	template <class F>
+	inline bool hash_subtree::write_payload(
+		F block_allocator,
+		const solvable_hash_subtree& subtree
+	) {
+		using node_type = solvable_hash_tree::entity_node;
+
+		const auto type_index = static_cast<uint32_t>(subtree.type.get_index());
+		const auto num_entities = static_cast<uint32_t>(subtree.entities.size());
+		const auto num_components = static_cast<uint32_t>(subtree.component_hashes.size());
+
+		const auto header_size = sizeof(subtree.step) + sizeof(type_index) + sizeof(num_entities) + sizeof(num_components);
+		const auto entities_bytes = std::size_t(num_entities) * sizeof(node_type);
+		const auto components_bytes = std::size_t(num_components) * sizeof(solvable_hash_type);
+
+		const auto total_size = header_size + entities_bytes + components_bytes;
+
+		if (total_size > max_block_size_v) {
+			return false;
+		}
+
+		auto block = block_allocator(total_size);
+
+		if (block == nullptr) {
+			return false;
+		}
+
+		auto write_next = [&block](const auto& from) {
+			std::memcpy(block, &from, sizeof(from));
+			block += sizeof(from);
+		};
+
+		write_next(subtree.step);
+		write_next(type_index);
+		write_next(num_entities);
+		write_next(num_components);
+
+		std::memcpy(block, subtree.entities.data(), entities_bytes);
+		std::memcpy(block + entities_bytes, subtree.component_hashes.data(), components_bytes);
+
+		return true;
+	}
+
 	inline bool initial_arena_state::read_payload(
 		augs::serialization_buffers& buffers,
 		const cosmos_solvable_significant& initial_signi,
 		const initial_arena_state_payload<false> in
 	) {
-		const auto data = reinterpret_cast<const std::byte*>(GetBlockData());
-		const auto size = static_cast<std::size_t>(GetBlockSize());
+		const auto header_size = sizeof(in.client_id) + sizeof(in.rcon);
 
-		NSR_LOG("RECEIVING INITIAL STATE");
+		const auto block_data = reinterpret_cast<const std::byte*>(GetBlockData());
+		const auto block_size = static_cast<std::size_t>(GetBlockSize());
 
-		NSR_LOG("Compressed stream size: %x", size);
+		NSR_LOG("RECEIVING INITIAL STATE");
 
-		const bool size_written_properly = size >= sizeof(uint32_t);
+		const bool size_written_properly = block_size >= header_size + sizeof(uint32_t);
 
 		if (!size_written_properly) {
 			return false;
 		}
 
-		const auto uncompressed_size = *reinterpret_cast<const uint32_t*>(data);
+		std::memcpy(&in.client_id, block_data, sizeof(in.client_id));
+		std::memcpy(&in.rcon, block_data + sizeof(in.client_id), sizeof(in.rcon));
+
+		const auto data = block_data + header_size;
+		const auto size = block_size - header_size;
+
+		NSR_LOG("Compressed stream size: %x", size);
+
+		uint32_t uncompressed_size = 0;
+		std::memcpy(&uncompressed_size, data, sizeof(uncompressed_size));
 	
 		NSR_LOG("Uncompressed size: %x", uncompressed_size);
 
@@ -572,8 +851,7 @@ namespace net_messages {
 
 		augs::read_bytes(s, in.signi);
 		augs::read_bytes(s, in.mode);
-		augs::read_bytes(s, in.client_id);
-		augs::read_bytes(s, in.rcon);
+		augs::read_bytes(s, in.signi.global.lightweight_projectiles);
 
 		NSR_LOG_NVPS(in.client_id);
 
@@ -583,60 +861,98 @@ namespace net_messages {
 	template <class F>
 	inline bool initial_arena_state::write_payload(
 		F block_allocator,
-		augs::serialization_buffers& buffers,
-		const cosmos_solvable_significant& initial_signi,
-		const all_entity_flavours& all_flavours,
-		const initial_arena_state_payload<true> in
-	) {
-		auto write_all_to = [&in](auto& s) {
-			augs::write_bytes(s, in.signi);
-			augs::write_bytes(s, in.mode);
-			augs::write_bytes(s, in.client_id);
-			augs::write_bytes(s, in.rcon);
-		};
+		const compressed_arena_state& state,
+		const uint32_t client_id,
+		const rcon_level_type rcon
+	) {
+		/* 
+			The compressed state is shared by all clients that requested it at the same step,
+			so the data specific to the client precedes it uncompressed.
+		*/
+
+		const auto header_size = sizeof(client_id) + sizeof(rcon);
+		const auto& c = state.bytes;
+
+		if (c.empty()) {
+			return false;
+		}
+
+		const auto block = block_allocator(header_size + c.size());
+
+		if (block == nullptr) {
+			return false;
+		}
+
+		std::memcpy(block, &client_id, sizeof(client_id));
+		std::memcpy(block + sizeof(client_id), &rcon, sizeof(rcon));
+		std::memcpy(block + header_size, c.data(), c.size());
 
 		NSR_LOG("SENDING INITIAL STATE");
+		NSR_LOG("Compressed stream size: %x", c.size());
 
-		{
-			NSR_LOG("STAGE: ESTIMATION");
+		return true;
+	}
+}
 
-			augs::byte_counter_stream s;
-			write_all_to(s);
-			buffers.serialization.reserve(s.size());
+inline bool preserialized_server_step_entropy::write(
+	::networked_server_step_entropy& input,
+	const ::server_step_entropy_predictor* const predictor
+) {
+	/* Clients will have their own contexts written over this one. */
+	input.context = {};
 
-			NSR_LOG("Reserved size: %x", s.size());
+	bytes.resize(max_server_step_size_v);
+	return net_messages::safe_write(bytes, input, predictor);
+}
 
-			{
-				auto s = buffers.make_serialization_stream<net_solvable_stream_ref>(all_flavours, initial_signi, in.signi);
-				write_all_to(s);
-			}
+inline void compress_arena_state(
+	augs::serialization_buffers& buffers,
+	const cosmos_solvable_significant& initial_signi,
+	const all_entity_flavours& all_flavours,
+	const cosmos_solvable_significant& signi,
+	const online_mode_and_rules& mode,
+	compressed_arena_state& output
+) {
+	auto write_all_to = [&](auto& s) {
+		augs::write_bytes(s, signi);
+		augs::write_bytes(s, mode);
+		augs::write_bytes(s, signi.global.lightweight_projectiles);
+	};
 
-			NSR_LOG("Result stream length: %x", buffers.serialization.size());
-		}
+	{
+		NSR_LOG("STAGE: ESTIMATION");
+
+		augs::byte_counter_stream s;
+		write_all_to(s);
+		buffers.serialization.reserve(s.size());
 
-		auto& c = buffers.compressed;
+		NSR_LOG("Reserved size: %x", s.size());
 
 		{
-			NSR_LOG("STAGE: COMPRESSION");
+			auto s = buffers.make_serialization_stream<net_solvable_stream_ref>(all_flavours, initial_signi, signi);
+			write_all_to(s);
+		}
 
-			c.clear();
+		NSR_LOG("Result stream length: %x", buffers.serialization.size());
+	}
 
-			{
-				auto s = augs::ref_memory_stream(c);
-				const auto uncompressed_size = static_cast<uint32_t>(buffers.serialization.size());
-				augs::write_bytes(s, uncompressed_size);
+	auto& c = output.bytes;
 
-				NSR_LOG("Uncompressed size: %x", uncompressed_size);
-			}
+	{
+		NSR_LOG("STAGE: COMPRESSION");
 
-			augs::compress(buffers.compression_state, buffers.serialization, c);
+		c.clear();
 
-			NSR_LOG("Compressed stream size: %x", c.size());
+		{
+			auto s = augs::ref_memory_stream(c);
+			const auto uncompressed_size = static_cast<uint32_t>(buffers.serialization.size());
+			augs::write_bytes(s, uncompressed_size);
+
+			NSR_LOG("Uncompressed size: %x", uncompressed_size);
 		}
 
-		auto block = block_allocator(c.size());
-		std::memcpy(block, c.data(), c.size());
+		augs::compress(buffers.compression_state, buffers.serialization, c);
 
-		return true;
+		NSR_LOG("Compressed stream size: %x", c.size());
 	}
 }
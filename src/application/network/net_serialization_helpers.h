@@ -102,7 +102,16 @@ namespace net_messages {
 
 	template <class Stream>
 	bool serialize(Stream& s, ::net_statistics_update& c) {
-		return serialize_vector_uint8_t(s, c.ping_values, 0, max_mode_players_v);
+		if (!serialize_vector_uint8_t(s, c.ping_values, 0, max_mode_players_v)) {
+			return false;
+		}
+
+		const auto max_us = static_cast<int>(std::numeric_limits<uint16_t>::max());
+
+		serialize_int(s, c.server_step.avg_us, 0, max_us);
+		serialize_int(s, c.server_step.max_us, 0, max_us);
+
+		return true;
 	}
 
 	template <class Stream>
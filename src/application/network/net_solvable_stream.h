@@ -64,7 +64,27 @@ struct net_solvable_stream_ref : augs::ref_memory_stream {
 				static_assert(std::is_trivially_copyable_v<remove_cref<decltype(s)>>);
 
 				if (const auto correspondent_initial = original_pool.find(this_id)) {
-					if (!std::memcmp(std::addressof(s), correspondent_initial, sizeof(*correspondent_initial))) {
+					if constexpr(is_soa_entity_v<E>) {
+						/* s was assembled from the columns, so compare the columns themselves. */
+						const auto initial_idx = static_cast<std::size_t>(correspondent_initial - original_pool.data());
+						bool all_equal = true;
+
+						for_each_type_in_list<typename remove_cref<decltype(original_pool)>::column_list>([&](auto tag) {
+							using C = decltype(tag);
+
+							const auto& serialized_column = serialized_pool.template get_column<C>();
+							const auto& original_column = original_pool.template get_column<C>();
+
+							if (std::memcmp(std::addressof(serialized_column[this_idx]), std::addressof(original_column[initial_idx]), sizeof(C))) {
+								all_equal = false;
+							}
+						});
+
+						if (all_equal) {
+							return 2;
+						}
+					}
+					else if (!std::memcmp(std::addressof(s), correspondent_initial, sizeof(*correspondent_initial))) {
 						return 2;
 					}
 				}
@@ -140,7 +160,12 @@ struct net_solvable_stream_cref : augs::cref_memory_stream {
 				unversioned_id_type id;
 				augs::read_bytes(*this, id);
 
-				storage[i] = initial_bodies[initial_bodies.get_versioned(id)];
+				if constexpr(is_soa_entity_v<E>) {
+					storage[i] = initial_bodies.assemble(initial_bodies.get_versioned(id));
+				}
+				else {
+					storage[i] = initial_bodies[initial_bodies.get_versioned(id)];
+				}
 			}
 		}
 	}
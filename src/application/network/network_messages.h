@@ -8,6 +8,8 @@
 #include "augs/misc/serialization_buffers.h"
 #include "application/network/server_step_entropy.h"
 #include "application/network/special_client_request.h"
+#include "application/network/hash_subtree_request.h"
+#include "game/cosmos/solvable_hash.h"
 #include "application/network/rcon_command.h"
 #include "application/setups/server/chat_structs.h"
 #include "application/setups/server/net_statistics_update.h"
@@ -15,6 +17,8 @@
 #include "game/common_state/entity_flavours.h"
 #include "application/setups/server/public_settings_update.h"
 #include "game/modes/session_id.h"
+#include "application/setups/server/rcon_level.h"
+#include "application/setups/server/arena_state_snapshot.h"
 
 #define LOG_NET_SERIALIZATION !IS_PRODUCTION_BUILD
 
@@ -56,6 +60,20 @@ constexpr std::size_t max_message_size_v = ((chosen_packet_size_v - total_header
 
 using message_bytes_type = augs::constant_size_vector<std::byte, max_message_size_v>;
 
+/*
+	A server step serialized only once per tick, to be then sent to every client.
+
+	The only part that differs between clients is the prestep_client_context,
+	which is serialized first and occupies exactly the first byte,
+	so it is simply overwritten in each client's copy.
+*/
+
+struct preserialized_server_step_entropy {
+	message_bytes_type bytes;
+
+	bool write(::networked_server_step_entropy&, const ::server_step_entropy_predictor* = nullptr);
+};
+
 struct server_vars;
 struct server_solvable_vars;
 
@@ -156,10 +174,9 @@ namespace net_messages {
 		template <class F>
 		bool write_payload(
 			F block_allocator,
-			augs::serialization_buffers&,
-			const cosmos_solvable_significant& initial_signi,
-			const all_entity_flavours& all_flavours,
-			initial_arena_state_payload<true>
+			const compressed_arena_state&,
+			uint32_t client_id,
+			rcon_level_type rcon
 		);
 	};
 
@@ -187,7 +204,9 @@ namespace net_messages {
 		static constexpr bool client_to_server = false;
 
 		bool write_payload(::networked_server_step_entropy&);
+		bool write_payload(const ::preserialized_server_step_entropy&, const ::prestep_client_context&);
 		bool read_payload(::networked_server_step_entropy&);
+		bool read_payload(::networked_server_step_entropy&, const ::server_step_entropy_predictor&);
 	};
 
 	struct client_entropy : preserialized_message {
@@ -275,6 +294,34 @@ namespace net_messages {
 		);
 	};
 
+	struct hash_subtree_request : public yojimbo::Message {
+		static constexpr bool server_to_client = false;
+		static constexpr bool client_to_server = true;
+
+		template <typename Stream>
+		bool Serialize(Stream& stream);
+
+		::hash_subtree_request payload;
+
+		bool write_payload(const ::hash_subtree_request&);
+		bool read_payload(::hash_subtree_request&);
+
+		YOJIMBO_MESSAGE_BOILERPLATE();
+	};
+
+	struct hash_subtree : only_block_message {
+		static constexpr bool server_to_client = true;
+		static constexpr bool client_to_server = false;
+
+		bool read_payload(solvable_hash_subtree&);
+
+		template <class F>
+		bool write_payload(
+			F block_allocator,
+			const solvable_hash_subtree&
+		);
+	};
+
 	using all_t = type_list<
 		client_welcome*,
 		public_settings_update*, 
@@ -293,7 +340,9 @@ namespace net_messages {
 		client_requested_chat*,
 		server_broadcasted_chat*,
 		net_statistics_update*,
-		player_avatar_exchange*
+		player_avatar_exchange*,
+		hash_subtree_request*,
+		hash_subtree*
 	>;
 	
 	using id_t = type_in_list_id<all_t>;
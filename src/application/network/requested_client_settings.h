@@ -19,5 +19,6 @@ struct requested_client_settings {
 
 	public_client_settings public_settings;
 	client_net_vars net;
+	bool relay = false;
 	// END GEN INTROSPECTOR
 };
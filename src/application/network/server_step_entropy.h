@@ -1,6 +1,9 @@
 #pragma once
+#include <array>
 #include "augs/templates/logically_empty.h"
+#include "augs/templates/container_templates.h"
 #include "game/modes/mode_entropy.h"
+#include "game/cosmos/solvable_hash.h"
 
 using server_step_entropy = mode_entropy;
 
@@ -88,10 +91,15 @@ struct server_step_entropy_meta {
 	// GEN INTROSPECTOR struct server_step_entropy_meta
 	std::optional<uint32_t> state_hash;
 	bool reinference_necessary = false;
+	std::optional<solvable_pool_hashes> pool_hashes;
 	// END GEN INTROSPECTOR
 
 	bool operator==(const server_step_entropy_meta& b) const {
-		return state_hash == b.state_hash && reinference_necessary == b.reinference_necessary;
+		return 
+			state_hash == b.state_hash 
+			&& reinference_necessary == b.reinference_necessary 
+			&& pool_hashes == b.pool_hashes
+		;
 	}
 };
 
@@ -108,3 +116,37 @@ struct networked_server_step_entropy {
 		return context == b.context && meta == b.meta && payload == b.payload;
 	}
 };
+
+/*
+	Remembers the crosshair motions of all players from the last step,
+	so that the motions of the next step can be coded as differences from them.
+	A player moving the mouse steadily produces nearly the same motion every step.
+
+	Steps are delivered reliably and in order,
+	so the predictors of both sides see the same sequence of steps and stay in agreement -
+	as long as the first step ever sent over a connection is not predicted.
+*/
+
+struct server_step_entropy_predictor {
+	std::array<raw_game_motion_offset_type, max_mode_players_v> last_motions = {};
+
+	const raw_game_motion_offset_type* predict_motion_of(const mode_player_id& id) const {
+		if (id.value < last_motions.size()) {
+			return std::addressof(last_motions[id.value]);
+		}
+
+		return nullptr;
+	}
+
+	void update(const compact_server_step_entropy& step) {
+		last_motions = {};
+
+		for (const auto& p : step.players) {
+			if (p.player_id.value < last_motions.size()) {
+				if (const auto motion = mapped_or_nullptr(p.total.cosmic.motions, game_motion_type::MOVE_CROSSHAIR)) {
+					last_motions[p.player_id.value] = *motion;
+				}
+			}
+		}
+	}
+};
@@ -144,3 +144,17 @@ void simulation_receiver::drag_mispredictions_into_past(
 		);
 	}
 }
+
+void simulation_receiver::log_divergence(const solvable_hash_subtree& expected) const {
+	if (desynced_step != expected.step) {
+		LOG("Received the hash subtree of step %x, but the client has not desynchronized at that step.", expected.step);
+		return;
+	}
+
+	if (const auto divergence = find_divergence(expected, desynced_hash_tree)) {
+		LOG("Divergence: %x", divergence->describe());
+	}
+	else {
+		LOG("Divergence: every entity of the received hash subtree matches.");
+	}
+}
@@ -1,4 +1,5 @@
 #pragma once
+#include <optional>
 #include <unordered_set>
 
 #include "augs/log.h"
@@ -6,11 +7,13 @@
 #include "augs/network/jitter_buffer.h"
 #include "augs/templates/logically_empty.h"
 #include "game/cosmos/cosmic_functions.h"
+#include "game/cosmos/solvable_hash.h"
 
 #include "view/audiovisual_state/systems/interpolation_system.h"
 #include "view/audiovisual_state/systems/past_infection_system.h"
 
 #include "application/network/server_step_entropy.h"
+#include "application/network/hash_subtree_request.h"
 #include "application/network/simulation_receiver_settings.h"
 
 #include "application/network/interpolation_transfer.h"
@@ -24,11 +27,32 @@ struct misprediction_candidate_entry {
 	components::transform transform;
 };
 
+enum class reprediction_cause {
+	NONE,
+	SCHEDULED,
+	REINFERENCE,
+	ENTROPY_MISMATCH,
+	TIMING_NUDGE,
+
+	COUNT
+};
+
 struct steps_unpacking_result {
 	bool should_repredict = false;
 	bool malicious_server = false;
 	bool desync = false;
 	std::size_t total_accepted = static_cast<std::size_t>(-1);
+
+	/* The first reason found for re-simulating the predicted cosmos. */
+	reprediction_cause cause = reprediction_cause::NONE;
+
+	/* Index of the first accepted server step whose entropy differed from the predicted one. */
+	std::optional<std::size_t> first_divergent_step;
+
+	std::size_t num_repredicted_steps = 0;
+
+	/* Set if a pool was found to diverge - the server can tell the exact entity. */
+	std::optional<hash_subtree_request> subtree_request;
 };
 
 class simulation_receiver {
@@ -36,6 +60,12 @@ public:
 	using received_entropy_type = compact_server_step_entropy;
 	using simulated_entropy_type = server_step_entropy;
 private:
+	/* Updated with every received hash, rehashing only the entities modified since. */
+	solvable_hash_tree local_hash_tree;
+
+	/* The tree at the last desync, to be compared against the subtree sent by the server. */
+	solvable_hash_tree desynced_hash_tree;
+	std::optional<uint32_t> desynced_step;
 
 	template <class H>
 	misprediction_candidate_entry acquire_potential_misprediction(const H& e) const {
@@ -108,6 +138,9 @@ public:
 		}
 	}
 
+	/* Descends into the pool that the server has sent the hashes of, after the client has requested them on desync. */
+	void log_divergence(const solvable_hash_subtree& expected) const;
+
 	template <class F, class A, class S1, class S2>
 	steps_unpacking_result unpack_deterministic_steps(
 		const simulation_receiver_settings& settings,
@@ -140,9 +173,16 @@ public:
 
 		auto& repredict = result.should_repredict;
 
+		auto request_reprediction = [&](const reprediction_cause cause) {
+			if (!repredict) {
+				repredict = true;
+				result.cause = cause;
+			}
+		};
+
 		if (schedule_reprediction) {
 			if (!predicted_entropies.empty()) {
-				repredict = true;
+				request_reprediction(reprediction_cause::SCHEDULED);
 				schedule_reprediction = false;
 			}
 		}
@@ -186,9 +226,9 @@ public:
 						}
 #endif
 
-						const auto client_state_hash = 
-							referential_cosmos.template calculate_solvable_signi_hash<uint32_t>()
-						;
+						local_hash_tree.update(referential_cosmos);
+
+						const auto client_state_hash = local_hash_tree.get_root();
 
 						if (*received_hash != client_state_hash) {
 							LOG(
@@ -198,6 +238,20 @@ public:
 							   	client_state_hash
 							);
 
+							if (const auto& received_pools = meta.pool_hashes) {
+								if (const auto divergence = find_divergence(*received_pools, local_hash_tree)) {
+									LOG("Divergence: %x", divergence->describe());
+
+									desynced_hash_tree = local_hash_tree;
+									desynced_step = static_cast<uint32_t>(referential_cosmos.get_total_steps_passed());
+
+									result.subtree_request = hash_subtree_request { *desynced_step, divergence->type };
+								}
+								else {
+									LOG("Divergence: all pools match. The clock or the global solvable diverged.");
+								}
+							}
+
 							result.desync = true;
 						}
 					}
@@ -217,10 +271,19 @@ public:
 						advance_referential(actual_server_entropy);
 
 						if (!repredict) {
+							/*
+								Once anything diverged, the predicted cosmos is rebuilt from the referential one anyway,
+								so there is no need to compare the remaining entropies.
+							*/
+
 							const auto& predicted_server_entropy = predicted_entropies[p_i];
 
-							if (shall_reinfer || !(actual_server_entropy == predicted_server_entropy)) {
-								repredict = true;
+							if (shall_reinfer) {
+								request_reprediction(reprediction_cause::REINFERENCE);
+							}
+							else if (!(actual_server_entropy == predicted_server_entropy)) {
+								request_reprediction(reprediction_cause::ENTROPY_MISMATCH);
+								result.first_divergent_step = i;
 							}
 						}
 					}
@@ -232,7 +295,7 @@ public:
 					if (num_accepted != 1) {
 						/* We'll need to nudge into the future or into the past. */
 
-						repredict = true;
+						request_reprediction(reprediction_cause::TIMING_NUDGE);
 					}
 
 					p_i += num_accepted;
@@ -271,6 +334,7 @@ public:
 			::save_interpolations(transfer_caches, std::as_const(predicted_cosmos));
 
 			predicted_arena.transfer_all_solvables(referential_arena);
+			result.num_repredicted_steps = predicted_entropies.size();
 
 			for (auto& predicted_step_entropy : predicted_entropies) {
 				predict_intents_of_remote_entities(
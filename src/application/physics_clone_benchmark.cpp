@@ -0,0 +1,60 @@
+#include "augs/log.h"
+#include "augs/misc/timing/timer.h"
+
+#include "3rdparty/Box2D/Box2D.h"
+#include "game/inferred_caches/physics_world_cache.h"
+#include "game/detail/physics/make_crowded_b2world.h"
+
+#include "application/physics_clone_benchmark.h"
+
+bool perform_physics_clone_benchmark(const unsigned clones) {
+	const auto num_bodies = 4000u;
+	const auto dt = 1 / 60.f;
+
+	LOG("Performing %x physics clone benchmark passes.", clones);
+
+	physics_world_cache original;
+	auto& original_world = original.get_b2world();
+
+	make_crowded_b2world(original_world, num_bodies);
+
+	for (int i = 0; i < 60; ++i) {
+		original_world.Step(dt, 8, 3);
+	}
+
+	LOG("(Physics clone benchmark) Bodies: %x, contacts: %x", original_world.GetBodyCount(), original_world.GetContactCount());
+
+	bool all_identical = true;
+
+	auto measure = [&](const b2world_clone_method method, const auto& name) {
+		physics_world_cache clone;
+
+		auto timer = augs::timer();
+
+		for (unsigned i = 0; i < clones; ++i) {
+			clone.clone_b2world_from(original, method);
+		}
+
+		const auto ms = timer.get<std::chrono::microseconds>() / 1000.0;
+
+		LOG("(Physics clone benchmark) %x: %x ms per clone", name, clones ? ms / clones : 0.0);
+
+		physics_world_cache reference;
+		reference.clone_b2world_from(original, b2world_clone_method::PER_OBJECT);
+
+		for (int i = 0; i < 60; ++i) {
+			reference.get_b2world().Step(dt, 8, 3);
+			clone.get_b2world().Step(dt, 8, 3);
+		}
+
+		if (clones > 0 && !b2world_bodies_identical(reference.get_b2world(), clone.get_b2world())) {
+			LOG("(Physics clone benchmark) %x: the clone diverged after stepping.", name);
+			all_identical = false;
+		}
+	};
+
+	measure(b2world_clone_method::PER_OBJECT, "Per object");
+	measure(b2world_clone_method::ARENA, "Arena");
+
+	return all_identical;
+}
@@ -0,0 +1,10 @@
+#pragma once
+
+/*
+	Builds a crowded physics world with thousands of contacts
+	and measures how long it takes to clone it with each b2world_clone_method.
+
+	Returns false if any clone stops stepping identically to the original.
+*/
+
+bool perform_physics_clone_benchmark(unsigned clones);
@@ -0,0 +1,597 @@
+#include <csignal>
+#include <cstring>
+#include <utility>
+#include <algorithm>
+
+#include "augs/log.h"
+#include "augs/misc/compress.h"
+#include "augs/templates/always_false.h"
+
+#include "game/cosmos/change_solvable_significant.h"
+#include "game/cosmos/solvers/standard_solver.h"
+
+#include "application/relay/spectator_relay.h"
+
+#include "application/network/client_adapter.hpp"
+#include "application/network/server_adapter.hpp"
+#include "application/network/net_message_translation.h"
+#include "application/network/net_message_serializers.h"
+#include "application/network/payload_easily_movable.h"
+
+#include "application/arena/arena_handle.hpp"
+#include "application/arena/choose_arena.h"
+
+#include "augs/readwrite/byte_readwrite.h"
+#include "augs/readwrite/memory_stream.h"
+
+#if PLATFORM_UNIX
+extern volatile std::sig_atomic_t signal_status;
+#endif
+
+double yojimbo_time();
+void yojimbo_sleep(double);
+
+using initial_payload = initial_arena_state_payload<false>;
+
+static augs::server_listen_input make_downstream_input(const spectator_relay_settings& settings) {
+	augs::server_listen_input in;
+
+	in.ip = settings.ip;
+	in.port = settings.port;
+	in.max_connections = std::clamp(settings.max_spectators, 1, static_cast<int>(max_incoming_connections_v));
+
+	return in;
+}
+
+spectator_relay::spectator_relay(
+	sol::state& lua,
+	const spectator_relay_settings& settings
+) :
+	lua(lua),
+	settings(settings),
+	upstream(std::make_unique<client_adapter>(std::nullopt)),
+	downstream(std::make_unique<server_adapter>(
+		make_downstream_input(settings),
+		[](const netcode_address_t&, const std::byte*, const std::size_t) { return false; }
+	))
+{
+	requested_settings.chosen_nickname = settings.nickname;
+	requested_settings.relay = true;
+
+	relay_time = yojimbo_time();
+
+	const auto result = upstream->connect(settings.upstream);
+
+	if (result.result != resolve_result_type::OK) {
+		LOG("Relay failed to resolve the upstream server. %x", result.report());
+	}
+}
+
+spectator_relay::~spectator_relay() {
+	upstream->disconnect();
+	downstream->stop();
+}
+
+online_arena_handle<false> spectator_relay::get_arena_handle() {
+	return {
+		current_mode,
+		scene,
+		scene.world,
+		rulesets,
+		initial_signi
+	};
+}
+
+void spectator_relay::log_malicious_server() {
+	LOG("The upstream server has sent invalid data.");
+}
+
+void spectator_relay::disconnect() {
+	upstream->disconnect();
+}
+
+void spectator_relay::log_malicious_client(const client_id_type& id) {
+	LOG("Spectator %x has sent invalid data.", id);
+}
+
+void spectator_relay::init_client(const client_id_type& id) {
+	LOG("Spectator %x connected to the relay.", id);
+
+	auto& s = spectators[id];
+
+	s = {};
+	s.state = client_state_type::PENDING_WELCOME;
+	s.last_valid_message_time = relay_time;
+}
+
+void spectator_relay::unset_client(const client_id_type& id) {
+	LOG("Spectator %x disconnected from the relay.", id);
+
+	spectators[id] = {};
+}
+
+void spectator_relay::disconnect_and_unset(const client_id_type& id) {
+	downstream->disconnect_client(id);
+	unset_client(id);
+}
+
+template <class F>
+void spectator_relay::for_each_spectator_in_game(F&& callback) {
+	for (std::size_t i = 0; i < spectators.size(); ++i) {
+		const auto id = static_cast<client_id_type>(i);
+		auto& s = spectators[i];
+
+		if (s.state == client_state_type::IN_GAME && downstream->is_client_connected(id)) {
+			callback(id, s);
+		}
+	}
+}
+
+template <class T, class F>
+message_handler_result spectator_relay::handle_server_payload(
+	F&& read_payload
+) {
+	constexpr auto abort_v = message_handler_result::ABORT_AND_DISCONNECT;
+	constexpr auto continue_v = message_handler_result::CONTINUE;
+	constexpr bool is_easy_v = payload_easily_movable_v<T>;
+
+	std::conditional_t<is_easy_v, T, std::monostate> payload;
+
+	if constexpr(is_easy_v) {
+		if (!read_payload(payload)) {
+			return abort_v;
+		}
+	}
+
+	if constexpr (std::is_same_v<T, server_solvable_vars>) {
+		/*
+			The steps that follow are already for the new arena,
+			so all that was held back has to reach the spectators first.
+		*/
+
+		relay_delayed_messages(true);
+
+		const bool are_initial_vars = upstream_state == client_state_type::PENDING_WELCOME;
+
+		if (are_initial_vars) {
+			upstream_state = client_state_type::RECEIVING_INITIAL_STATE;
+		}
+
+		if (are_initial_vars || payload.current_arena != solvable_vars.current_arena) {
+			LOG("Relay loads arena: %x", payload.current_arena);
+
+			try {
+				::choose_arena(lua, get_arena_handle(), payload, initial_signi);
+			}
+			catch (const augs::file_open_error& err) {
+				LOG("Relay failed to load arena: %x. Details:\n%x", payload.current_arena, err.what());
+				return abort_v;
+			}
+
+			compressed_at_step = std::nullopt;
+		}
+
+		solvable_vars = payload;
+
+		for (std::size_t i = 0; i < spectators.size(); ++i) {
+			const auto id = static_cast<client_id_type>(i);
+
+			if (spectators[i].state >= client_state_type::RECEIVING_INITIAL_STATE && downstream->is_client_connected(id)) {
+				downstream->send_payload(id, game_channel_type::SERVER_SOLVABLE_AND_STEPS, solvable_vars);
+			}
+		}
+	}
+	else if constexpr (std::is_same_v<T, initial_payload>) {
+		if (!desync_reported && upstream_state != client_state_type::RECEIVING_INITIAL_STATE) {
+			LOG("The upstream server has sent initial state early (state: %x). Disconnecting.", upstream_state);
+			log_malicious_server();
+			return abort_v;
+		}
+
+		relay_delayed_messages(true);
+
+		uint32_t read_client_id = 0;
+		rcon_level_type read_rcon = rcon_level_type::DENIED;
+
+		bool read_successfully = false;
+
+		cosmic::change_solvable_significant(
+			scene.world,
+			[&](cosmos_solvable_significant& signi) {
+				read_successfully = read_payload(
+					buffers,
+
+					initial_signi,
+
+					initial_payload {
+						signi,
+						current_mode,
+						read_client_id,
+						read_rcon
+					}
+				);
+
+				return changer_callback_result::REFRESH;
+			}
+		);
+
+		if (!read_successfully) {
+			return abort_v;
+		}
+
+		relay_player_id = static_cast<mode_player_id>(read_client_id);
+
+		LOG("Relay received initial state at step: %x.", scene.world.get_timestamp().step);
+
+		const bool was_in_game = upstream_state == client_state_type::IN_GAME;
+
+		upstream_state = client_state_type::IN_GAME;
+		desync_reported = false;
+		compressed_at_step = std::nullopt;
+
+		if (!was_in_game) {
+			/* Lets the server know we are in game, just as a client would with its first command. */
+			auto no_input = total_client_entropy();
+			upstream->send_payload(game_channel_type::CLIENT_COMMANDS, no_input);
+		}
+	}
+	else if constexpr (std::is_same_v<T, networked_server_step_entropy>) {
+		if (upstream_state != client_state_type::IN_GAME) {
+			LOG("The upstream server has sent entropy too early (state: %x). Disconnecting.", upstream_state);
+
+			log_malicious_server();
+			return abort_v;
+		}
+
+		networked_server_step_entropy step;
+
+		if (!read_payload(step, std::as_const(upstream_predictor))) {
+			return abort_v;
+		}
+
+		upstream_predictor.update(step.payload);
+		delayed.push_back({ relay_time, std::move(step) });
+
+		/* Keep the server's queue of our commands filled, so that it accepts exactly one every step. */
+		auto no_input = total_client_entropy();
+		upstream->send_payload(game_channel_type::CLIENT_COMMANDS, no_input);
+	}
+	else if constexpr (
+		std::is_same_v<T, public_settings_update>
+		|| std::is_same_v<T, server_broadcasted_chat>
+		|| std::is_same_v<T, net_statistics_update>
+	) {
+		delayed.push_back({ relay_time, std::move(payload) });
+	}
+	else if constexpr (std::is_same_v<T, server_vars>) {
+		/* Only relevant for rcon. */
+	}
+#if CONTEXTS_SEPARATE
+	else if constexpr (std::is_same_v<T, prestep_client_context>) {
+		/* The relay accepts commands of its spectators on its own. */
+	}
+#endif
+	else if constexpr (std::is_same_v<T, arena_player_avatar_payload>) {
+		/* Avatars are not relayed. */
+	}
+	else if constexpr (std::is_same_v<T, solvable_hash_subtree>) {
+		/* The relay never asks for hash subtrees. */
+	}
+	else {
+		static_assert(always_false_v<T>, "Unhandled payload type.");
+	}
+
+	return continue_v;
+}
+
+template <class T, class F>
+message_handler_result spectator_relay::handle_client_message(
+	const client_id_type& client_id,
+	F&& read_payload
+) {
+	constexpr auto abort_v = message_handler_result::ABORT_AND_DISCONNECT;
+	constexpr auto continue_v = message_handler_result::CONTINUE;
+	constexpr bool is_easy_v = payload_easily_movable_v<T>;
+
+	std::conditional_t<is_easy_v, T, std::monostate> payload;
+
+	if constexpr(is_easy_v) {
+		if (!read_payload(payload)) {
+			return abort_v;
+		}
+	}
+
+	auto& s = spectators[client_id];
+
+	if constexpr (std::is_same_v<T, requested_client_settings>) {
+		if (s.state == client_state_type::PENDING_WELCOME) {
+			s.state = client_state_type::WELCOME_ARRIVED;
+		}
+	}
+	else if constexpr (std::is_same_v<T, total_client_entropy>) {
+		if (s.state != client_state_type::IN_GAME) {
+			LOG("Spectator %x has sent entropy too early (state: %x). Disconnecting.", client_id, s.state);
+			return abort_v;
+		}
+
+		/* The input of spectators is discarded, only the count matters for their timing. */
+		++s.num_entropies_pending;
+	}
+	else if constexpr (std::is_same_v<T, special_client_request>) {
+		if (payload == special_client_request::RESYNC && s.state == client_state_type::IN_GAME) {
+			LOG("Spectator %x requested a resync.", client_id);
+			send_state_to(client_id);
+		}
+	}
+	else {
+		/* Chat, rcon commands, avatars and hash subtree requests of spectators never reach the game server. */
+	}
+
+	s.last_valid_message_time = relay_time;
+	return continue_v;
+}
+
+void spectator_relay::send_state_to(const client_id_type client_id) {
+	if (compressed_at_step != steps_relayed) {
+		::compress_arena_state(
+			buffers,
+			initial_signi,
+			scene.world.get_common_significant().flavours,
+			scene.world.get_solvable().significant,
+			current_mode,
+			compressed
+		);
+
+		compressed_at_step = steps_relayed;
+	}
+
+	downstream->send_payload(
+		client_id,
+		game_channel_type::SERVER_SOLVABLE_AND_STEPS,
+
+		std::as_const(compressed),
+		static_cast<uint32_t>(relay_player_id.value),
+		rcon_level_type::DENIED
+	);
+
+	get_arena_handle().on_mode(
+		[&](const auto& typed_mode) {
+			typed_mode.for_each_player_id(
+				[&](const mode_player_id& id) {
+					downstream->send_payload(
+						client_id,
+						game_channel_type::SERVER_SOLVABLE_AND_STEPS,
+
+						public_settings_update { id, player_metas[id.value].public_settings }
+					);
+
+					return callback_result::CONTINUE;
+				}
+			);
+		}
+	);
+
+	auto& s = spectators[client_id];
+
+	s.state = client_state_type::IN_GAME;
+	s.num_entropies_pending = 0;
+}
+
+void spectator_relay::relay(networked_server_step_entropy& step) {
+	const auto arena = get_arena_handle();
+	auto& cosm = arena.get_cosmos();
+
+	const auto& meta = step.meta;
+
+	if (meta.state_hash != std::nullopt && !desync_reported) {
+		const auto relay_state_hash = cosm.calculate_solvable_signi_hash<uint32_t>();
+
+		if (*meta.state_hash != relay_state_hash) {
+			LOG("Relay desynchronized at step: %x. Requesting a resync.", cosm.get_total_steps_passed());
+
+			upstream->send_payload(game_channel_type::CLIENT_COMMANDS, special_client_request::RESYNC);
+			desync_reported = true;
+		}
+	}
+
+	/*
+		Serialize once for all spectators,
+		only the number of accepted commands differs between them.
+	*/
+
+	preserialized_server_step_entropy preserialized;
+	std::optional<preserialized_server_step_entropy> unpredicted;
+
+	if (preserialized.write(step, std::addressof(downstream_predictor))) {
+		for_each_spectator_in_game(
+			[&](const client_id_type id, downstream_spectator& s) {
+				const auto n = s.num_entropies_pending;
+
+				/* Accept one command per step, but squash if the spectator got too far ahead. */
+				const auto accepted = n > 4 ? n - 1 : std::min(n, std::size_t(1));
+
+				prestep_client_context context;
+				context.num_entropies_accepted = static_cast<uint8_t>(std::min(accepted, std::size_t(255)));
+
+				s.num_entropies_pending -= context.num_entropies_accepted;
+
+				if (!s.can_predict_steps && unpredicted == std::nullopt) {
+					unpredicted.emplace();
+					unpredicted->write(step);
+				}
+
+				downstream->send_payload(
+					id,
+					game_channel_type::SERVER_SOLVABLE_AND_STEPS,
+
+					std::as_const(s.can_predict_steps ? preserialized : *unpredicted),
+					std::as_const(context)
+				);
+
+				s.can_predict_steps = true;
+			}
+		);
+	}
+	else {
+		LOG("Failed to serialize a step for the spectators.");
+	}
+
+	downstream_predictor.update(step.payload);
+
+	const bool shall_reinfer = meta.reinference_necessary || logically_set(step.payload.general.added_player);
+
+	if (shall_reinfer) {
+		cosmic::reinfer_solvable(cosm);
+	}
+
+	auto mode_id_to_entity_id = [&](const mode_player_id& mode_id) {
+		return arena.on_mode(
+			[&](const auto& typed_mode) {
+				return typed_mode.lookup(mode_id);
+			}
+		);
+	};
+
+	auto get_settings_for = [&](const mode_player_id& mode_id) {
+		return player_metas[mode_id.value].public_settings.character_input;
+	};
+
+	arena.advance(
+		step.payload.unpack(mode_id_to_entity_id, get_settings_for),
+		solver_callbacks(),
+		solve_settings()
+	);
+
+	++steps_relayed;
+}
+
+void spectator_relay::relay(const public_settings_update& update) {
+	if (update.subject_id.value < player_metas.size()) {
+		player_metas[update.subject_id.value].public_settings = update.new_settings;
+	}
+
+	for_each_spectator_in_game(
+		[&](const client_id_type id, downstream_spectator&) {
+			downstream->send_payload(id, game_channel_type::SERVER_SOLVABLE_AND_STEPS, update);
+		}
+	);
+}
+
+void spectator_relay::relay(const server_broadcasted_chat& chat) {
+	auto relayed = chat;
+
+	/* A kick of the relay is not a kick of its spectators. */
+	relayed.recipient_shall_kindly_leave = relayed.target == chat_target_type::SERVER_SHUTTING_DOWN;
+
+	for_each_spectator_in_game(
+		[&](const client_id_type id, downstream_spectator&) {
+			downstream->send_payload(id, game_channel_type::COMMUNICATIONS, std::as_const(relayed));
+		}
+	);
+}
+
+void spectator_relay::relay(const net_statistics_update& update) {
+	for_each_spectator_in_game(
+		[&](const client_id_type id, downstream_spectator&) {
+			downstream->send_payload(id, game_channel_type::VOLATILE_STATISTICS, update);
+		}
+	);
+}
+
+void spectator_relay::relay_delayed_messages(const bool all) {
+	const auto delay = static_cast<net_time_t>(std::max(0.f, settings.broadcast_delay_secs));
+
+	while (!delayed.empty()) {
+		auto& entry = delayed.front();
+
+		if (!all && relay_time - entry.when_received < delay) {
+			break;
+		}
+
+		std::visit([&](auto& message) { relay(message); }, entry.message);
+		delayed.pop_front();
+	}
+}
+
+bool spectator_relay::advance() {
+	relay_time = yojimbo_time();
+
+	upstream->advance(relay_time, *this);
+
+	if (upstream->has_connection_failed() || upstream->is_disconnected()) {
+		LOG("Relay lost connection to the upstream server.");
+		return false;
+	}
+
+	if (upstream->is_connected() && upstream_state == client_state_type::INITIATING_CONNECTION) {
+		upstream->send_payload(game_channel_type::CLIENT_COMMANDS, std::as_const(requested_settings));
+		upstream_state = client_state_type::PENDING_WELCOME;
+
+		LOG("Relay connected to the upstream server.");
+	}
+
+	relay_delayed_messages(false);
+
+	downstream->advance(relay_time, *this);
+
+	for (std::size_t i = 0; i < spectators.size(); ++i) {
+		const auto id = static_cast<client_id_type>(i);
+		auto& s = spectators[i];
+
+		if (s.state == client_state_type::WELCOME_ARRIVED && upstream_state == client_state_type::IN_GAME) {
+			downstream->send_payload(id, game_channel_type::SERVER_SOLVABLE_AND_STEPS, solvable_vars);
+			send_state_to(id);
+		}
+
+		const auto max_time_to_enter_game = 10.0;
+
+		if (s.state == client_state_type::PENDING_WELCOME) {
+			if (relay_time - s.last_valid_message_time > max_time_to_enter_game) {
+				disconnect_and_unset(id);
+			}
+		}
+	}
+
+	upstream->send_packets();
+	downstream->send_packets();
+
+	return true;
+}
+
+void spectator_relay::sleep() {
+	yojimbo_sleep(settings.sleep_ms / 1000);
+}
+
+void perform_spectator_relay(
+	sol::state& lua,
+	const spectator_relay_settings& settings
+) {
+	LOG(
+		"Starting the spectator relay at port %x, relaying: %x",
+		settings.port,
+		settings.upstream.address
+	);
+
+	spectator_relay relay(lua, settings);
+
+	while (relay.advance()) {
+#if PLATFORM_UNIX
+		if (signal_status != 0) {
+			const auto sig = signal_status;
+
+			LOG("%x received.", strsignal(sig));
+
+			if(
+				sig == SIGINT
+				|| sig == SIGSTOP
+				|| sig == SIGTERM
+			) {
+				LOG("Gracefully shutting down.");
+				break;
+			}
+		}
+#endif
+
+		relay.sleep();
+	}
+}
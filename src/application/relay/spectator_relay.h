@@ -0,0 +1,148 @@
+#pragma once
+#include <deque>
+#include <array>
+#include <memory>
+#include <variant>
+#include <optional>
+
+#include "augs/misc/serialization_buffers.h"
+#include "augs/network/network_types.h"
+
+#include "application/intercosm.h"
+#include "application/predefined_rulesets.h"
+#include "application/arena/mode_and_rules.h"
+#include "application/arena/arena_handle.h"
+
+#include "application/network/network_common.h"
+#include "application/network/client_state_type.h"
+#include "application/network/server_step_entropy.h"
+#include "application/network/requested_client_settings.h"
+
+#include "application/setups/server/server_vars.h"
+#include "application/setups/server/chat_structs.h"
+#include "application/setups/server/net_statistics_update.h"
+#include "application/setups/server/public_settings_update.h"
+#include "application/setups/server/arena_state_snapshot.h"
+
+#include "view/mode_gui/arena/arena_player_meta.h"
+#include "application/relay/spectator_relay_settings.h"
+
+namespace sol {
+	class state;
+}
+
+class client_adapter;
+class server_adapter;
+
+/*
+	Connects to a game server as a single spectator
+	and rebroadcasts the game to many downstream spectators,
+	so that they cost the authoritative server nothing.
+
+	The relay keeps its own referential cosmos in sync with the server
+	and sends the state of it to every spectator that connects,
+	followed by the step entropies as they are received,
+	optionally held back by broadcast_delay_secs.
+
+	Downstream clients are ordinary game clients,
+	and all of them view the game as the spectating player of the relay itself.
+*/
+
+class spectator_relay {
+	using delayed_message = std::variant<
+		networked_server_step_entropy,
+		public_settings_update,
+		server_broadcasted_chat,
+		net_statistics_update
+	>;
+
+	struct delayed_entry {
+		net_time_t when_received = 0.0;
+		delayed_message message;
+	};
+
+	struct downstream_spectator {
+		client_state_type state = client_state_type::INITIATING_CONNECTION;
+		net_time_t last_valid_message_time = 0.0;
+		std::size_t num_entropies_pending = 0;
+		bool can_predict_steps = false;
+	};
+
+	sol::state& lua;
+	spectator_relay_settings settings;
+
+	intercosm scene;
+	cosmos_solvable_significant initial_signi;
+	predefined_rulesets rulesets;
+	online_mode_and_rules current_mode;
+	server_solvable_vars solvable_vars;
+
+	arena_player_metas player_metas;
+	mode_player_id relay_player_id;
+
+	augs::serialization_buffers buffers;
+
+	std::unique_ptr<client_adapter> upstream;
+	client_state_type upstream_state = client_state_type::INITIATING_CONNECTION;
+	requested_client_settings requested_settings;
+
+	std::unique_ptr<server_adapter> downstream;
+	std::array<downstream_spectator, max_incoming_connections_v> spectators;
+
+	std::deque<delayed_entry> delayed;
+
+	server_step_entropy_predictor upstream_predictor;
+	server_step_entropy_predictor downstream_predictor;
+
+	/* Shared by all spectators joining at the same step. */
+	std::optional<std::size_t> compressed_at_step;
+	compressed_arena_state compressed;
+
+	std::size_t steps_relayed = 0;
+	bool desync_reported = false;
+
+	net_time_t relay_time = 0.0;
+
+	online_arena_handle<false> get_arena_handle();
+
+	void relay_delayed_messages(bool all);
+	void relay(networked_server_step_entropy&);
+	void relay(const public_settings_update&);
+	void relay(const server_broadcasted_chat&);
+	void relay(const net_statistics_update&);
+
+	void send_state_to(client_id_type);
+
+	template <class F>
+	void for_each_spectator_in_game(F&& callback);
+
+public:
+	spectator_relay(sol::state& lua, const spectator_relay_settings&);
+	~spectator_relay();
+
+	bool advance();
+	void sleep();
+
+	/* Handlers of the upstream messages, called by the client_adapter. */
+
+	template <class T, class F>
+	message_handler_result handle_server_payload(F&& read_payload);
+
+	template <class T>
+	void handle_server_message(T&) {}
+
+	void log_malicious_server();
+	void disconnect();
+
+	/* Handlers of the downstream messages, called by the server_adapter. */
+
+	template <class T, class F>
+	message_handler_result handle_client_message(const client_id_type&, F&& read_payload);
+
+	void init_client(const client_id_type&);
+	void unset_client(const client_id_type&);
+	void disconnect_and_unset(const client_id_type&);
+	void log_malicious_client(const client_id_type&);
+};
+
+void perform_spectator_relay(sol::state& lua, const spectator_relay_settings&);
@@ -0,0 +1,19 @@
+#pragma once
+#include <string>
+#include "augs/network/port_type.h"
+#include "application/network/address_and_port.h"
+
+struct spectator_relay_settings {
+	// GEN INTROSPECTOR struct spectator_relay_settings
+	address_and_port upstream;
+
+	std::string ip = "0.0.0.0";
+	port_type port = 8414;
+	int max_spectators = 64;
+
+	std::string nickname = "[Relay]";
+	float broadcast_delay_secs = 0.f;
+
+	float sleep_ms = 1;
+	// END GEN INTROSPECTOR
+};
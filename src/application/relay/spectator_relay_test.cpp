@@ -0,0 +1,249 @@
+#include <map>
+#include <optional>
+
+#include "augs/log.h"
+#include "augs/misc/timing/timer.h"
+#include "augs/templates/container_templates.h"
+#include "augs/network/netcode_socket_raii.h"
+
+#include "view/audiovisual_state/systems/interpolation_system.h"
+#include "view/audiovisual_state/systems/past_infection_system.h"
+
+#include "application/config_lua_table.h"
+#include "application/session_profiler.h"
+#include "application/nat/stun_server_provider.h"
+#include "application/network/resolve_address.h"
+#include "application/setups/server/server_setup.h"
+#include "application/setups/client/client_setup.h"
+#include "application/relay/spectator_relay.h"
+#include "application/relay/spectator_relay_test.h"
+
+double yojimbo_time();
+void yojimbo_sleep(double);
+
+/* 
+	Binds a socket to port 0 so that the system picks a free port, then releases it.
+	Another process might take the port in between, but that is unlikely on the loopback interface.
+*/
+
+static std::optional<port_type> find_free_loopback_port() {
+	const auto address = to_netcode_addr("127.0.0.1", 0);
+
+	if (!address) {
+		return std::nullopt;
+	}
+
+	try {
+		const auto probe = netcode_socket_raii(*address);
+		return probe.socket.address.port;
+	}
+	catch (const netcode_socket_raii_error& err) {
+		LOG("(Spectator relay test) %x", err.what());
+		return std::nullopt;
+	}
+}
+
+bool perform_spectator_relay_test(sol::state& lua, const config_lua_table& in_config, const unsigned steps) {
+	LOG("Testing the spectator relay over %x compared steps.", steps);
+
+	auto config = std::make_unique<config_lua_table>(in_config);
+
+	/* Nothing should leave the machine, and the arena should not depend on the content folder. */
+
+	config->server.notified_server_list.address = "";
+	config->server.allow_nat_traversal = false;
+	config->server_solvable.current_arena = "";
+
+	const auto server_port = find_free_loopback_port();
+
+	if (!server_port) {
+		LOG("(Spectator relay test) Could not find a free port for the server.");
+		return false;
+	}
+
+	auto stun_provider = stun_server_provider(config->nat_detection.stun_server_list);
+
+	augs::server_listen_input listen;
+	listen.ip = "127.0.0.1";
+	listen.port = *server_port;
+	listen.max_connections = 2;
+
+	auto server = std::make_unique<server_setup>(
+		lua,
+		listen,
+		config->server,
+		config->server_solvable,
+		config->client,
+		config->private_server,
+		config->dedicated_server,
+
+		server_nat_traversal_input {
+			config->nat_detection,
+			config->nat_traversal,
+			stun_provider
+		}
+	);
+
+	if (!server->is_running()) {
+		LOG("(Spectator relay test) The server failed to start on port %x.", *server_port);
+		return false;
+	}
+
+	/* The server is already bound, so the relay cannot be handed the same port. */
+
+	const auto relay_port = find_free_loopback_port();
+
+	if (!relay_port) {
+		LOG("(Spectator relay test) Could not find a free port for the relay.");
+		return false;
+	}
+
+	spectator_relay_settings relay_settings;
+	relay_settings.upstream.address = "127.0.0.1";
+	relay_settings.upstream.default_port = *server_port;
+	relay_settings.ip = "127.0.0.1";
+	relay_settings.port = *relay_port;
+	relay_settings.max_spectators = 1;
+	relay_settings.broadcast_delay_secs = 0.25f;
+
+	auto relay = std::make_unique<spectator_relay>(lua, relay_settings);
+
+	client_start_input start;
+	start.default_port = *relay_port;
+	start.set_custom("127.0.0.1");
+
+	auto client_vars = config->client;
+	client_vars.nickname = "Spectator";
+	client_vars.avatar_image_path.clear();
+	client_vars.demo_recording_path.is_enabled = false;
+	client_vars.network_simulator.is_enabled = false;
+
+	auto client = std::make_unique<client_setup>(
+		lua,
+		start,
+		client_vars,
+		config->nat_detection,
+		port_type(0)
+	);
+
+	network_profiler server_performance;
+	server_network_info server_stats;
+
+	network_profiler client_performance;
+	network_info client_stats;
+	interpolation_system interp;
+	past_infection_system past_infection;
+
+	using step_type = decltype(server->get_viewed_cosmos().get_total_steps_passed());
+
+	std::map<step_type, uint32_t> server_hashes;
+
+	const auto timeout_secs = 20.0;
+
+	std::size_t steps_compared = 0;
+	std::size_t steps_mismatched = 0;
+	std::optional<step_type> last_client_step;
+
+	const auto screen_size = vec2i(1920, 1080);
+	const auto zoom = 1.f;
+
+	const auto when_started = yojimbo_time();
+	augs::timer frame_timer;
+
+	while (steps_compared < steps && yojimbo_time() - when_started < timeout_secs) {
+		server->advance(
+			{
+				vec2i(),
+				config->input,
+				zoom,
+				nat_detection_result(),
+				server_performance,
+				server_stats
+			},
+			solver_callbacks()
+		);
+
+		{
+			const auto& cosm = server->get_viewed_cosmos();
+			server_hashes[cosm.get_total_steps_passed()] = cosm.calculate_solvable_signi_hash<uint32_t>();
+		}
+
+		if (!relay->advance()) {
+			LOG("(Spectator relay test) The relay has stopped.");
+			return false;
+		}
+
+		client->advance(
+			{
+				frame_timer.extract_delta(),
+				screen_size,
+				config->input,
+				zoom,
+				config->simulation_receiver,
+				config->lag_compensation,
+				client_performance,
+				client_stats,
+				interp,
+				past_infection
+			},
+			solver_callbacks()
+		);
+
+		if (client->is_gameplay_on()) {
+			const auto& cosm = client->get_arena_handle(client_arena_type::REFERENTIAL).get_cosmos();
+			const auto step = cosm.get_total_steps_passed();
+
+			if (step != last_client_step) {
+				last_client_step = step;
+
+				if (const auto server_hash = mapped_or_nullptr(server_hashes, step)) {
+					++steps_compared;
+
+					if (*server_hash != cosm.calculate_solvable_signi_hash<uint32_t>()) {
+						LOG("(Spectator relay test) Step %x mismatched.", step);
+						++steps_mismatched;
+					}
+				}
+			}
+		}
+
+		yojimbo_sleep(0.001);
+	}
+
+	bool success = true;
+
+	if (steps_compared != steps) {
+		LOG("(Spectator relay test) Compared only %x out of %x steps within %x seconds.", steps_compared, steps, timeout_secs);
+		success = false;
+	}
+
+	if (steps_mismatched > 0) {
+		LOG("(Spectator relay test) %x steps mismatched.", steps_mismatched);
+		success = false;
+	}
+
+	if (last_client_step.has_value()) {
+		/* The client should trail the server by about broadcast_delay_secs. */
+
+		const auto server_step = server->get_viewed_cosmos().get_total_steps_passed();
+		const auto delay_steps = relay_settings.broadcast_delay_secs / server->get_inv_tickrate();
+		const auto trailing_steps = static_cast<double>(server_step) - static_cast<double>(*last_client_step);
+
+		LOG("(Spectator relay test) The client trails the server by %x steps.", trailing_steps);
+
+		if (trailing_steps < delay_steps / 2) {
+			LOG("(Spectator relay test) Expected the client to trail by at least %x steps.", delay_steps / 2);
+			success = false;
+		}
+	}
+
+	client->disconnect();
+	relay.reset();
+	server.reset();
+
+	if (success) {
+		LOG("(Spectator relay test) The downstream client matched the server at every compared step.");
+	}
+
+	return success;
+}
@@ -0,0 +1,18 @@
+#pragma once
+#include "3rdparty/sol2/sol/forward.hpp"
+
+struct config_lua_table;
+
+/*
+	Starts a dedicated server, a relay connected to it and a client connected to the relay,
+	all on the loopback interface and on ports that are free at the moment.
+
+	The state of the client, held back by broadcast_delay_secs,
+	has to hash the same as the state the server had at the same step.
+
+	Returns false if any of the compared steps mismatched,
+	if fewer than steps were compared before the timeout,
+	or if the client did not trail the server by about broadcast_delay_secs.
+*/
+
+bool perform_spectator_relay_test(sol::state& lua, const config_lua_table& config, unsigned steps);
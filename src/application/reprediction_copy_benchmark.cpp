@@ -0,0 +1,118 @@
+#include "augs/log.h"
+#include "augs/misc/timing/timer.h"
+
+#include "game/cosmos/cosmos.h"
+#include "game/cosmos/entity_handle.h"
+#include "game/cosmos/solvable_hash.h"
+#include "game/cosmos/solvers/standard_solver.h"
+#include "game/organization/for_each_entity_type.h"
+#include "game/modes/test_mode.h"
+#include "test_scenes/test_scene_settings.h"
+
+#include "application/intercosm.h"
+#include "application/authoritative_solve_test.h"
+#include "application/reprediction_copy_benchmark.h"
+
+bool perform_reprediction_copy_benchmark(sol::state& lua, const unsigned steps) {
+#if BUILD_TEST_SCENES
+	LOG("Performing reprediction copy benchmark over %x recorded steps.", steps);
+
+	if (steps == 0) {
+		return true;
+	}
+
+	auto scene = std::make_unique<intercosm>();
+	auto ruleset = test_mode_ruleset();
+
+	scene->make_test_scene(lua, { false, 60 }, ruleset);
+
+	const auto recorded = record_test_scene_match(scene->world, steps);
+
+	auto advance = [](cosmos& cosm, cosmic_entropy entropy) {
+		entropy.clear_dead_entities(cosm);
+		standard_solver()({ cosm, entropy, solve_settings() }, solver_callbacks());
+	};
+
+	struct copy_method {
+		const char* name;
+		bool only_dirty;
+
+		std::unique_ptr<cosmos> referential;
+		std::unique_ptr<cosmos> predicted;
+
+		double secs = 0.0;
+	};
+
+	copy_method methods[] = {
+		{ "Only dirty entities", true, std::make_unique<cosmos>(scene->world), std::make_unique<cosmos>(scene->world) },
+		{ "Whole solvable", false, std::make_unique<cosmos>(scene->world), std::make_unique<cosmos>(scene->world) }
+	};
+
+	std::size_t dirty_entities = 0;
+	std::size_t total_entities = 0;
+
+	for (unsigned i = 0; i < steps; ++i) {
+		for (auto& m : methods) {
+			auto& referential = *m.referential;
+			auto& predicted = *m.predicted;
+
+			advance(referential, recorded[i]);
+
+			if (m.only_dirty) {
+				const auto& a = predicted.get_dirty_entities();
+				const auto& b = referential.get_dirty_entities();
+
+				if (dirty_entity_tracker::synchronized_with_each_other(a, b)) {
+					for_each_entity_type([&](auto e) {
+						using E = decltype(e);
+						const auto type = entity_type_id::of<E>();
+
+						if (dirty_entity_tracker::whole_pool_dirty(a, b, type)) {
+							dirty_entities += referential.get_solvable().get_count_of<E>();
+						}
+						else {
+							dirty_entities += dirty_entity_tracker::count_dirty_in_either(a, b, type);
+						}
+					});
+
+					total_entities += referential.get_entities_count();
+				}
+			}
+			else {
+				predicted.invalidate_dirty_tracking();
+			}
+
+			{
+				auto timer = augs::timer();
+				predicted.assign_solvable(referential);
+				m.secs += timer.get<std::chrono::seconds>();
+			}
+
+			advance(predicted, recorded[(i + 1) % steps]);
+		}
+
+		if (calculate_solvable_hash(*methods[0].predicted) != calculate_solvable_hash(*methods[1].predicted)) {
+			LOG("(Reprediction copy benchmark) Copying only dirty entities diverged at step %x.", i);
+			return false;
+		}
+	}
+
+	LOG("(Reprediction copy benchmark) Entities: %x", scene->world.get_entities_count());
+
+	for (const auto& m : methods) {
+		LOG("(Reprediction copy benchmark) %x: %f2 us per copy", m.name, m.secs * 1000000 / steps);
+	}
+
+	if (total_entities > 0) {
+		LOG("(Reprediction copy benchmark) Dirty entities: %f2 percent", 100.0 * dirty_entities / total_entities);
+	}
+
+	return true;
+#else
+	(void)lua;
+	(void)steps;
+
+	LOG("Reprediction copy benchmark requires BUILD_TEST_SCENES.");
+	return false;
+#endif
+}
@@ -0,0 +1,15 @@
+#pragma once
+#include "3rdparty/sol2/sol/forward.hpp"
+
+/*
+	Plays a recorded firefight on the test scene the way the client repredicts it:
+	after every referential step, the predicted cosmos is reassigned from the referential one
+	and then advanced by one more step.
+
+	Measures the time of cosmos::assign_solvable when only the dirty entities are copied
+	versus when the whole solvable is copied, along with how many entities were dirty.
+
+	Returns false if both ways of copying ever disagree about the solvable hash.
+*/
+
+bool perform_reprediction_copy_benchmark(sol::state& lua, unsigned steps);
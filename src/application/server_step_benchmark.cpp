@@ -0,0 +1,236 @@
+#include "augs/log.h"
+#include "augs/misc/randomization.h"
+#include "augs/misc/timing/timer.h"
+
+#include "augs/misc/scope_guard.h"
+#include "augs/filesystem/file.h"
+#include "augs/readwrite/byte_file.h"
+#include "augs/readwrite/memory_stream.h"
+#include "augs/templates/type_in_list_id.h"
+
+#include "application/network/network_messages.h"
+#include "application/network/net_message_translation.h"
+#include "application/setups/client/demo_step.h"
+#include "application/setups/client/demo_file_meta.h"
+#include "application/network/net_message_readwrite.h"
+#include "application/server_step_benchmark.h"
+
+static networked_server_step_entropy make_synthetic_step(
+	randomization& rng,
+	const unsigned num_players
+) {
+	networked_server_step_entropy step;
+
+	for (unsigned p = 0; p < num_players; ++p) {
+		total_mode_player_entropy t;
+
+		auto& motion = t.cosmic.motions[game_motion_type::MOVE_CROSSHAIR];
+		motion.x = static_cast<short>(rng.randval(-10, 10));
+		motion.y = static_cast<short>(rng.randval(-10, 10));
+
+		if (rng.randval(0, 3) == 0) {
+			t.cosmic.intents.push_back({ game_intent_type::MOVE_FORWARD, intent_change::PRESSED });
+		}
+
+		step.payload.players.push_back({ mode_player_id(p), t });
+	}
+
+	return step;
+}
+
+bool perform_server_step_benchmark(const unsigned ticks) {
+	const unsigned num_clients = 64;
+
+	/* 
+		Fewer players than clients have any input in a typical step,
+		and the message has to fit in a single packet.
+	*/
+
+	const unsigned num_players_with_input = 16;
+
+	LOG("Performing server step benchmark with %x ticks and %x clients.", ticks, num_clients);
+
+	auto rng = randomization(1337);
+
+	std::vector<net_messages::server_step_entropy> messages(num_clients);
+
+	for (auto& m : messages) {
+		m.Release();
+	}
+
+	bool all_equal = true;
+	std::vector<message_bytes_type> serialized_per_client(num_clients);
+
+	double per_client_secs = 0.0;
+	double once_secs = 0.0;
+
+	for (unsigned t = 0; t < ticks; ++t) {
+		auto step = make_synthetic_step(rng, num_players_with_input);
+
+		{
+			auto timer = augs::timer();
+
+			for (unsigned c = 0; c < num_clients; ++c) {
+				step.context.num_entropies_accepted = static_cast<uint8_t>(c % 3);
+				messages[c].write_payload(step);
+			}
+
+			per_client_secs += timer.get<std::chrono::seconds>();
+		}
+
+		for (unsigned c = 0; c < num_clients; ++c) {
+			serialized_per_client[c] = messages[c].bytes;
+		}
+
+		{
+			auto timer = augs::timer();
+
+			preserialized_server_step_entropy preserialized;
+			preserialized.write(step);
+
+			for (unsigned c = 0; c < num_clients; ++c) {
+				prestep_client_context context;
+				context.num_entropies_accepted = static_cast<uint8_t>(c % 3);
+
+				messages[c].write_payload(preserialized, context);
+			}
+
+			once_secs += timer.get<std::chrono::seconds>();
+		}
+
+		for (unsigned c = 0; c < num_clients; ++c) {
+			if (!(serialized_per_client[c] == messages[c].bytes)) {
+				all_equal = false;
+			}
+		}
+	}
+
+	const auto divisor = std::max(1u, ticks);
+
+	LOG("(Server step benchmark) Step size: %x bytes", messages[0].bytes.size());
+	LOG("(Server step benchmark) Serialized per client: %f2 us per tick", per_client_secs * 1000000 / divisor);
+	LOG("(Server step benchmark) Serialized once: %f2 us per tick", once_secs * 1000000 / divisor);
+
+	if (!all_equal) {
+		LOG("(Server step benchmark) Messages serialized once differ from the ones serialized per client!");
+	}
+
+	return all_equal;
+}
+
+bool perform_step_coding_measurement(const augs::path_type& demo_path) {
+	LOG("Measuring the coding of server steps recorded in: %x", demo_path);
+
+	std::vector<demo_step> steps;
+
+	try {
+		auto source = augs::open_binary_input_stream(demo_path);
+
+		demo_file_meta meta;
+		augs::read_bytes(source, meta);
+		augs::read_vector_until_eof(source, steps);
+	}
+	catch (const std::exception& err) {
+		LOG("Failed to read the demo: %x", err.what());
+		return false;
+	}
+
+	/* As recorded, so that demos with predicted steps can be read too. */
+	server_step_entropy_predictor recorded;
+
+	server_step_entropy_predictor encoder;
+	server_step_entropy_predictor decoder;
+
+	std::size_t num_server_steps = 0;
+	std::size_t num_player_entries = 0;
+	std::size_t unpredicted_bytes = 0;
+	std::size_t predicted_bytes = 0;
+
+	bool all_read = true;
+	bool all_equal = true;
+
+	auto measure_step = [&](net_messages::server_step_entropy& msg) {
+		networked_server_step_entropy step;
+
+		if (!msg.read_payload(step, std::as_const(recorded))) {
+			all_read = false;
+			return;
+		}
+
+		recorded.update(step.payload);
+
+		preserialized_server_step_entropy unpredicted;
+		preserialized_server_step_entropy predicted;
+
+		if (!unpredicted.write(step) || !predicted.write(step, std::addressof(encoder))) {
+			all_read = false;
+			return;
+		}
+
+		encoder.update(step.payload);
+
+		{
+			net_messages::server_step_entropy sent;
+			sent.Release();
+			sent.bytes = predicted.bytes;
+
+			networked_server_step_entropy received;
+
+			if (!sent.read_payload(received, std::as_const(decoder)) || !(received == step)) {
+				all_equal = false;
+			}
+
+			decoder.update(received.payload);
+		}
+
+		++num_server_steps;
+		num_player_entries += step.payload.players.size();
+		unpredicted_bytes += unpredicted.bytes.size();
+		predicted_bytes += predicted.bytes.size();
+	};
+
+	for (const auto& s : steps) {
+		for (const auto& bytes : s.serialized_messages) {
+			auto callback = [&](auto& msg) {
+				using M = remove_cref<decltype(msg)>;
+
+				if constexpr(std::is_same_v<M, net_messages::server_step_entropy>) {
+					measure_step(msg);
+				}
+
+				return message_handler_result::CONTINUE;
+			};
+
+			try {
+				::on_read_net_message(bytes, callback);
+			}
+			catch (const augs::stream_read_error& err) {
+				LOG("Failed to read a message from the demo: %x", err.what());
+				return false;
+			}
+		}
+	}
+
+	const auto divisor = static_cast<double>(std::max(std::size_t(1), num_server_steps));
+
+	LOG("(Step coding) Server steps: %x, player entries per step: %f2", num_server_steps, num_player_entries / divisor);
+	LOG("(Step coding) Unpredicted: %f2 bytes per tick", unpredicted_bytes / divisor);
+	LOG("(Step coding) Predicted: %f2 bytes per tick", predicted_bytes / divisor);
+
+	if (unpredicted_bytes > 0) {
+		const auto saved = 1.0 - static_cast<double>(predicted_bytes) / unpredicted_bytes;
+		const auto player_divisor = static_cast<double>(std::max(std::size_t(1), num_player_entries));
+
+		LOG("(Step coding) Saved: %f2 percent (%f2 bytes per player entry)", saved * 100.0, (static_cast<double>(unpredicted_bytes) - predicted_bytes) / player_divisor);
+	}
+
+	if (!all_read) {
+		LOG("(Step coding) Some of the recorded steps could not be read or written.");
+	}
+
+	if (!all_equal) {
+		LOG("(Step coding) Predicted steps were read back differently!");
+	}
+
+	return all_read && all_equal;
+}
@@ -0,0 +1,17 @@
+#pragma once
+#include "augs/filesystem/path_declaration.h"
+
+/*
+	Measures the cost of preparing the server step messages of a single tick for 64 clients,
+	serializing the step separately for each client versus serializing it once
+	and patching the per-client context into every copy.
+*/
+
+bool perform_server_step_benchmark(unsigned ticks);
+
+/*
+	Replays the server steps recorded in a demo file
+	and measures the bytes per tick they take with and without predicting them from the previous step.
+*/
+
+bool perform_step_coding_measurement(const augs::path_type& demo_path);
@@ -21,6 +21,8 @@ struct network_profiler : public augs::profiler_mixin<network_profiler> {
 	// GEN INTROSPECTOR struct network_profiler
 	augs::amount_measurements<std::size_t> predicted_steps = 1;
 	augs::amount_measurements<std::size_t> accepted_commands = 1;
+	augs::amount_measurements<std::size_t> repredicted_steps = 1;
+	augs::amount_measurements<std::size_t> steps_before_divergence = 1;
 
 	augs::time_measurements unpacking_remote_steps;
 	augs::time_measurements stepping_forward;
@@ -1,4 +1,5 @@
 #include "augs/misc/pool/pool_io.hpp"
+#include "augs/misc/pool/soa_pool_io.hpp"
 #include "augs/misc/imgui/imgui_scope_wrappers.h"
 #include "augs/misc/imgui/imgui_control_wrappers.h"
 
@@ -284,10 +285,12 @@ client_setup::client_setup(
 
 				ensure_eq(resolution.result, resolve_result_type::OK);
 
-				const auto new_demo_fname = augs::date_time().get_readable_for_file() + ".dem";
-				const auto new_demo_path = augs::path_type(DEMOS_DIR) / new_demo_fname;
+				if (vars.demo_recording_path.is_enabled) {
+					const auto new_demo_fname = augs::date_time().get_readable_for_file() + ".dem";
+					const auto new_demo_path = augs::path_type(vars.demo_recording_path.value) / new_demo_fname;
 
-				record_demo_to(new_demo_path);
+					record_demo_to(new_demo_path);
+				}
 			}
 		}
 	}
@@ -699,6 +702,17 @@ void client_setup::send_pending_commands() {
 		}
 	}
 
+	if (pending_subtree_request) {
+		LOG("Asking the server for the hashes of the diverged pool.");
+
+		send_payload(
+			game_channel_type::CLIENT_COMMANDS,
+			std::as_const(*pending_subtree_request)
+		);
+
+		pending_subtree_request = std::nullopt;
+	}
+
 	if (pending_request == special_client_request::RESYNC) {
 		LOG("Sending the request resync command.");
 
@@ -1153,8 +1167,7 @@ void save_interpolations(
 	source.get_solvable().significant.entity_pools.for_each_container(
 		[&](const auto& p) {
 			using P = remove_cref<decltype(p)>;
-			using V = typename P::mapped_type;
-			using E = entity_type_of<V>;
+			using E = typename P::value_type::used_entity_type;
 
 			if constexpr(has_all_of_v<E, invariants::interpolation>) {
 				auto& c = caches.get_for<E>();
@@ -1,4 +1,5 @@
 #pragma once
+#include <array>
 #include <future>
 #include "augs/math/camera_cone.h"
 #include "game/detail/render_layer_filter.h"
@@ -17,6 +18,7 @@
 
 #include "augs/network/network_types.h"
 #include "application/setups/server/rcon_level.h"
+#include "application/setups/server/net_statistics_update.h"
 
 #include "application/predefined_rulesets.h"
 #include "application/arena/mode_and_rules.h"
@@ -38,6 +40,7 @@
 
 #include "view/client_arena_type.h"
 #include "application/network/special_client_request.h"
+#include "application/network/hash_subtree_request.h"
 #include "application/gui/client/rcon_gui.h"
 #include "application/gui/client/chat_gui.h"
 #include "application/gui/client/client_gui_state.h"
@@ -58,6 +61,17 @@ class client_adapter;
 
 struct netcode_socket_t;
 
+struct client_reprediction_totals {
+	std::size_t count = 0;
+	std::size_t steps = 0;
+
+	std::array<std::size_t, static_cast<std::size_t>(reprediction_cause::COUNT)> by_cause = {};
+
+	auto of(const reprediction_cause c) const {
+		return by_cause[static_cast<std::size_t>(c)];
+	}
+};
+
 class client_setup : 
 	public default_setup_settings,
 	public arena_gui_mixin<client_setup>
@@ -83,6 +97,7 @@ class client_setup :
 	online_mode_and_rules predicted_mode;
 
 	special_client_request pending_request = special_client_request::NONE;
+	std::optional<hash_subtree_request> pending_subtree_request;
 	bool now_resyncing = false;
 
 	arena_player_metas player_metas;
@@ -91,6 +106,10 @@ class client_setup :
 	sol::state& lua;
 
 	simulation_receiver receiver;
+	server_step_entropy_predictor step_predictor;
+
+	client_reprediction_totals total_repredictions;
+	server_step_timing last_server_step_timing;
 
 	address_and_port last_addr;
 	netcode_address_t resolved_server_address;
@@ -445,6 +464,17 @@ class client_setup :
 				);
 
 				performance.accepted_commands.measure(result.total_accepted);
+				performance.repredicted_steps.measure(result.num_repredicted_steps);
+
+				if (result.should_repredict) {
+					++total_repredictions.count;
+					total_repredictions.steps += result.num_repredicted_steps;
+					++total_repredictions.by_cause[static_cast<std::size_t>(result.cause)];
+				}
+
+				if (result.first_divergent_step) {
+					performance.steps_before_divergence.measure(*result.first_divergent_step);
+				}
 
 				if (result.malicious_server) {
 					LOG("There was a problem unpacking steps from the server. Disconnecting.");
@@ -454,6 +484,7 @@ class client_setup :
 
 				if (result.desync && !now_resyncing) {
 					pending_request = special_client_request::RESYNC;
+					pending_subtree_request = result.subtree_request;
 					now_resyncing = true;
 
 #if DUMP_BEFORE_AND_AFTER_ROUND_START
@@ -716,6 +747,15 @@ public:
 	void update_stats(network_info&) const;
 	bool is_spectating_referential() const;
 
+	const auto& get_total_repredictions() const {
+		return total_repredictions;
+	}
+
+	/* As last reported by the server. */
+	const auto& get_last_server_step_timing() const {
+		return last_server_step_timing;
+	}
+
 	const entropy_accumulator& get_entropy_accumulator() const {
 		return total_collected;
 	}
@@ -9,11 +9,15 @@
 
 using client_nickname_type = augs::constant_size_string<max_nickname_length_v>;
 
+constexpr unsigned max_adaptive_jitter_steps_v = 16;
+
 struct client_jitter_vars {
 	// GEN INTROSPECTOR struct client_jitter_vars
 	uint32_t buffer_at_least_steps = 2;
 	uint32_t buffer_at_least_ms = 20;
 	uint8_t max_commands_to_squash_at_once = 255;
+	uint32_t max_adaptive_steps = 4;
+	bool stretch_catch_up = true;
 	// END GEN INTROSPECTOR
 };
 
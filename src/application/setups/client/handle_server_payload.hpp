@@ -237,10 +237,18 @@ message_handler_result client_setup::handle_server_payload(
 			return abort_v;
 		}
 
+		networked_server_step_entropy step;
+
+		if (!read_payload(step, std::as_const(step_predictor))) {
+			return abort_v;
+		}
+
+		step_predictor.update(step.payload);
+
 		receiver.acquire_next_server_entropy(
-			payload.context,
-			payload.meta, 
-			payload.payload
+			step.context,
+			step.meta, 
+			step.payload
 		);
 
 		const auto& max_commands = vars.max_buffered_server_commands;
@@ -293,6 +301,7 @@ message_handler_result client_setup::handle_server_payload(
 			}
 		);
 
+		last_server_step_timing = payload.server_step;
 	}
 	else if constexpr (std::is_same_v<T, arena_player_avatar_payload>) {
 		session_id_type session_id;
@@ -313,6 +322,9 @@ message_handler_result client_setup::handle_server_payload(
 			return abort_v;
 		}
 	}
+	else if constexpr (std::is_same_v<T, solvable_hash_subtree>) {
+		receiver.log_divergence(payload);
+	}
 	else {
 		static_assert(always_false_v<T>, "Unhandled payload type.");
 	}
@@ -12,6 +12,7 @@
 #include "augs/misc/readable_bytesize.h"
 
 #include "augs/misc/pool/pool_io.hpp"
+#include "augs/misc/pool/soa_pool_io.hpp"
 #include "augs/readwrite/memory_stream.h"
 #include "augs/readwrite/byte_readwrite.h"
 
@@ -104,7 +105,7 @@ void editor_summary_gui::perform(editor_setup& setup) {
 		const auto& s = cosm.get_solvable().significant;
 
 		s.for_each_entity_pool([&](const auto& p){
-			using T = entity_type_of<typename remove_cref<decltype(p)>::mapped_type>;
+			using T = typename remove_cref<decltype(p)>::value_type::used_entity_type;
 
 			const auto si = p.size();
 			const auto ca = p.max_size();
@@ -125,7 +126,7 @@ void editor_summary_gui::perform(editor_setup& setup) {
 		text("Total percentages: ");
 
 		s.for_each_entity_pool([&](const auto& p){
-			using T = entity_type_of<typename remove_cref<decltype(p)>::mapped_type>;
+			using T = typename remove_cref<decltype(p)>::value_type::used_entity_type;
 
 			const auto si = p.size();
 			const auto ca = cosm.get_entities_count();
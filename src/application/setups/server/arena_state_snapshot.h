@@ -0,0 +1,29 @@
+#pragma once
+#include <vector>
+#include <future>
+#include <cstddef>
+
+#include "application/network/network_common.h"
+
+/*
+	The significant state and the mode of the arena, serialized and compressed,
+	preceded by the uncompressed size.
+*/
+
+struct compressed_arena_state {
+	std::vector<std::byte> bytes;
+};
+
+/*
+	Serializing and compressing the whole arena takes a while for bigger maps,
+	so it is done on a background thread, from a copy of the state at the given step.
+
+	All clients asking for the state in the same step share a single snapshot.
+	Until it is ready, the step entropies for these clients are buffered
+	and sent right after the snapshot so that they can catch up.
+*/
+
+struct arena_state_snapshot {
+	server_step_type step = 0;
+	std::shared_future<compressed_arena_state> compressed;
+};
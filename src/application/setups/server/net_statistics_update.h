@@ -1,5 +1,12 @@
 #pragma once
 
+struct server_step_timing {
+	/* Over the recent steps of the server, in microseconds. */
+	uint16_t avg_us = 0;
+	uint16_t max_us = 0;
+};
+
 struct net_statistics_update {
 	std::vector<uint8_t> ping_values;
+	server_step_timing server_step;
 };
@@ -1,4 +1,5 @@
 #pragma once
+#include <memory>
 #include "application/setups/server/server_vars.h"
 #include "augs/network/jitter_buffer.h"
 #include "augs/network/network_types.h"
@@ -6,10 +7,12 @@
 
 #include "application/network/requested_client_settings.h"
 #include "application/network/client_state_type.h"
+#include "application/network/server_step_entropy.h"
+#include "application/setups/server/arena_state_snapshot.h"
 
 #include "view/mode_gui/arena/arena_player_meta.h"
 
-using client_pending_entropies = std::vector<total_client_entropy>;
+using client_pending_entropies = augs::jitter_buffer<total_client_entropy>;
 
 struct server_client_state {
 	using type = client_state_type;
@@ -25,11 +28,18 @@ struct server_client_state {
 
 	unsigned resyncs_counter = 0;
 	net_time_t last_resync_counter_reset_at = 0;
+	std::optional<uint32_t> last_sent_hash_subtree_step;
 	unsigned unauthorized_rcon_commands = 0;
 	std::optional<net_time_t> when_kicked;
 
 	arena_player_meta meta;
 
+	std::shared_ptr<const arena_state_snapshot> awaited_snapshot;
+	std::vector<networked_server_step_entropy> steps_since_snapshot;
+
+	/* The first step sent to the client cannot be predicted from the ones before. */
+	bool can_predict_steps = false;
+
 	server_client_state() = default;
 
 	server_client_state(const net_time_t server_time) {
@@ -1,4 +1,5 @@
 #include "augs/misc/pool/pool_io.hpp"
+#include "augs/misc/pool/soa_pool_io.hpp"
 #include "augs/misc/imgui/imgui_scope_wrappers.h"
 #include "augs/misc/imgui/imgui_control_wrappers.h"
 #include "augs/misc/compress.h"
@@ -557,6 +558,12 @@ void server_setup::apply(const server_vars& new_vars, const bool force) {
 		if (force || old_vars.network_simulator != new_vars.network_simulator) {
 			server->set(new_vars.network_simulator);
 		}
+
+		if (shared_logic_pool == nullptr) {
+			if (force || old_vars.logic_workers != new_vars.logic_workers) {
+				logic_pool.resize(new_vars.logic_workers);
+			}
+		}
 	}
 }
 
@@ -640,6 +647,19 @@ void server_setup::choose_arena(const std::string& name) {
 
 	solvable_vars.current_arena = name;
 
+	/* 
+		The pending snapshots refer to the flavours and the initial signi of the current arena.
+		Clients still waiting for one will receive the state of the new arena instead.
+	*/
+
+	for (auto& c : clients) {
+		if (c.awaited_snapshot != nullptr) {
+			c.awaited_snapshot->compressed.wait();
+		}
+	}
+
+	last_arena_snapshot = nullptr;
+
 	const auto& arena = get_arena_handle();
 
 	::choose_arena(
@@ -649,6 +669,14 @@ void server_setup::choose_arena(const std::string& name) {
 		initial_signi
 	);
 
+	share_common_significant_of_equal_arena();
+
+	for (auto& c : clients) {
+		if (c.awaited_snapshot != nullptr) {
+			request_arena_state_for(c);
+		}
+	}
+
 	arena_gui.reset();
 	arena_gui.choose_team.show = ::is_spectator(arena, get_local_player_id());
 
@@ -680,11 +708,29 @@ void server_setup::init_client(const client_id_type& id) {
 	auto& new_client = clients[id];
 	new_client.init(server_time);
 
+	/* One more than the limit, so that exceeding it can be detected. */
+	new_client.pending_entropies.set_capacity(vars.max_buffered_client_commands + 1);
+
 	LOG("Client %x connected.", id);
 }
 
 void server_setup::unset_client(const client_id_type& id) {
 	LOG("Client disconnected. Details:\n%x", describe_client(id));
+
+	if (const auto& c = clients[id]; c.state == client_state_type::IN_GAME) {
+		const auto& jitter = c.pending_entropies.get_stats();
+
+		LOG(
+			"Jitter buffer: target depth: %x, jitter: %3f steps, underruns: %x, overruns: %x, extrapolated: %x, caught up: %x",
+			jitter.target_depth,
+			jitter.jitter_steps,
+			jitter.underruns,
+			jitter.overruns,
+			jitter.steps_extrapolated,
+			jitter.steps_caught_up
+		);
+	}
+
 	clients[id].unset();
 }
 
@@ -702,7 +748,113 @@ void server_setup::accept_entropy_of_client(
 	}
 }
 
+void server_setup::request_arena_state_for(server_client_state& c) {
+	const bool can_share_last = 
+		last_arena_snapshot != nullptr
+		&& last_arena_snapshot->step == current_simulation_step
+	;
+
+	if (!can_share_last) {
+		auto snapshot = std::make_shared<arena_state_snapshot>();
+		snapshot->step = current_simulation_step;
+
+		/* 
+			Copying is much cheaper than serializing, 
+			and the simulation is free to proceed once the copy is made.
+		*/
+
+		auto signi = std::make_unique<cosmos_solvable_significant>(scene.world.get_solvable().significant);
+		auto mode = std::make_unique<online_mode_and_rules>(current_mode);
+
+		/* 
+			Both of these only change along with the arena,
+			and choose_arena waits for the pending snapshots to finish.
+		*/
+
+		const auto& initial = initial_signi;
+		const auto& flavours = scene.world.get_common_significant().flavours;
+
+		snapshot->compressed = launch_async(
+			[signi = std::move(signi), mode = std::move(mode), &initial, &flavours]() {
+				augs::serialization_buffers snapshot_buffers;
+				compressed_arena_state result;
+
+				::compress_arena_state(
+					snapshot_buffers,
+					initial,
+					flavours,
+					*signi,
+					*mode,
+					result
+				);
+
+				return result;
+			}
+		).share();
+
+		last_arena_snapshot = std::move(snapshot);
+	}
+
+	c.awaited_snapshot = last_arena_snapshot;
+	c.steps_since_snapshot.clear();
+}
+
+void server_setup::send_compressed_arena_states() {
+	auto send_if_ready = [&](const client_id_type client_id, auto& c) {
+		if (c.awaited_snapshot == nullptr || !::is_ready(c.awaited_snapshot->compressed)) {
+			return;
+		}
+
+		const auto& snapshot = *c.awaited_snapshot;
+
+		server->send_payload(
+			client_id, 
+			game_channel_type::SERVER_SOLVABLE_AND_STEPS, 
+
+			snapshot.compressed.get(),
+			static_cast<uint32_t>(client_id),
+			get_rcon_level(client_id)
+		);
+
+		for (auto& step : c.steps_since_snapshot) {
+#if CONTEXTS_SEPARATE
+			server->send_payload(
+				client_id,
+				game_channel_type::SERVER_SOLVABLE_AND_STEPS,
+
+				step.context
+			);
+#endif
+
+			/* Sent unpredicted, as they were buffered while the predictor moved on. */
+
+			server->send_payload(
+				client_id,
+				game_channel_type::SERVER_SOLVABLE_AND_STEPS,
+
+				step
+			);
+
+			c.can_predict_steps = true;
+		}
+
+		LOG(
+			"Sending initial payload for %x at step: %x. Steps to catch up: %x", 
+			client_id, 
+			snapshot.step,
+			c.steps_since_snapshot.size()
+		);
+
+		c.awaited_snapshot = nullptr;
+		c.steps_since_snapshot.clear();
+	};
+
+	for_each_id_and_client(send_if_ready, only_connected_v);
+}
+
 void server_setup::advance_clients_state() {
+	send_compressed_arena_states();
+
 	/* Do it only once per tick */
 	bool added_someone_already = false;
 	bool removed_someone_already = false;
@@ -756,51 +908,26 @@ void server_setup::advance_clients_state() {
 		}
 
 		auto contribute_to_step_entropy = [&]() {
-#if 0
-			c.pending_entropies.set_lower_limit(
-				c.settings.net.requested_jitter_buffer_ms * inv_simulation_delta_ms;
-			);
-#endif
-
-			const auto jitter_vars = c.settings.net.jitter;
-			const auto jitter_squash_steps = std::max(jitter_vars.buffer_at_least_steps, in_steps(jitter_vars.buffer_at_least_ms));
-
-			auto& inputs = c.pending_entropies;
-
-			if (const auto num_pending = inputs.size(); num_pending > 0) {
-				const bool should_squash = num_pending >= jitter_squash_steps;
-
-				total_client_entropy entropy;
-
-				c.num_entropies_accepted = [&]() {
-					if (should_squash) {
-						const auto num_squashed = static_cast<uint8_t>(
-							std::min(
-								num_pending,
-								static_cast<std::size_t>(c.settings.net.jitter.max_commands_to_squash_at_once)
-							)
-						);
+			const auto& jitter_vars = c.settings.net.jitter;
 
-						for (std::size_t i = 0; i < num_squashed; ++i) {
-							entropy += inputs[i];
-						}
-
-						if (num_squashed == num_pending) {
-							inputs.clear();
-						}
-						else {
-							erase_first_n(inputs, num_squashed);
-						}
+			augs::jitter_buffer_settings jitter_settings;
 
-						return static_cast<uint8_t>(num_squashed);
-					}
+			jitter_settings.catch_up_above_steps = std::max(jitter_vars.buffer_at_least_steps, in_steps(jitter_vars.buffer_at_least_ms));
+			jitter_settings.max_squashed_at_once = jitter_vars.max_commands_to_squash_at_once;
+			jitter_settings.max_adaptive_steps = std::min(jitter_vars.max_adaptive_steps, max_adaptive_jitter_steps_v);
+			jitter_settings.catch_up = jitter_vars.stretch_catch_up ? augs::jitter_catch_up_type::STRETCH : augs::jitter_catch_up_type::SQUASH;
 
-					entropy = inputs[0];
-					erase_first_n(inputs, 1);
+			total_client_entropy entropy;
 
-					return static_cast<uint8_t>(1);
-				}();
+			const auto num_unpacked = c.pending_entropies.unpack(
+				jitter_settings,
+				[&entropy](const total_client_entropy& next) {
+					entropy += next;
+				}
+			);
 
+			if (num_unpacked > 0) {
+				c.num_entropies_accepted = static_cast<uint8_t>(num_unpacked);
 				accept_entropy_of_client(mode_id, entropy);
 			}
 		};
@@ -841,8 +968,6 @@ void server_setup::advance_clients_state() {
 		};
 
 		auto send_state_for_the_first_time = [&]() {
-			const auto sent_client_id = static_cast<uint32_t>(client_id);
-
 			server->send_payload(
 				client_id, 
 				game_channel_type::SERVER_SOLVABLE_AND_STEPS, 
@@ -861,22 +986,7 @@ void server_setup::advance_clients_state() {
 				);
 			}
 
-			server->send_payload(
-				client_id, 
-				game_channel_type::SERVER_SOLVABLE_AND_STEPS, 
-
-				buffers,
-
-				initial_signi,
-				scene.world.get_common_significant().flavours,
-
-				initial_arena_state_payload<true> {
-					scene.world.get_solvable().significant,
-					current_mode,
-					sent_client_id,
-					rcon_level
-				}
-			);
+			request_arena_state_for(c);
 
 			{
 				auto download_existing_avatar = [this, recipient_client_id = client_id](const auto client_id_of_avatar, auto& cc) {
@@ -911,7 +1021,7 @@ void server_setup::advance_clients_state() {
 				for_each_id_and_client(download_existing_public_settings, connected_and_integrated_v);
 			}
 
-			LOG("Sending initial payload for %x at step: %x", client_id, scene.world.get_total_steps_passed());
+			LOG("Requested initial payload for %x at step: %x", client_id, scene.world.get_total_steps_passed());
 		};
 
 		if (!added_someone_already) {
@@ -933,7 +1043,13 @@ void server_setup::advance_clients_state() {
 		}
 
 		if (c.state == client_state_type::IN_GAME) {
-			if (c.should_kick_due_to_afk(vars, server_time)) {
+			/* Spectator relays never send any input. */
+			const bool spectating_relay = 
+				c.settings.relay 
+				&& ::is_spectator(get_arena_handle(), to_mode_player_id(client_id))
+			;
+
+			if (!spectating_relay && c.should_kick_due_to_afk(vars, server_time)) {
 				kick(client_id, "AFK!");
 			}
 		}
@@ -1121,8 +1237,10 @@ message_handler_result server_setup::handle_client_message(
 			c.last_keyboard_activity_time = server_time;
 		}
 
-		c.pending_entropies.emplace_back(std::move(payload));
-		//LOG("Received %x th command from client. ", c.pending_entropies.size());
+		if (!c.pending_entropies.acquire(std::move(payload), server_time, get_inv_tickrate())) {
+			const auto max_commands = vars.max_buffered_client_commands;
+			kick(client_id, typesafe_sprintf("number of pending commands exceeded the maximum of %x.", max_commands));
+		}
 	}
 	else if constexpr (std::is_same_v<T, special_client_request>) {
 		switch (payload) {
@@ -1142,32 +1260,40 @@ message_handler_result server_setup::handle_client_message(
 					return abort_v;
 				}
 
-				{
-					const auto rcon_level = get_rcon_level(client_id);
+				request_arena_state_for(c);
 
-					server->send_payload(
-						client_id, 
-						game_channel_type::SERVER_SOLVABLE_AND_STEPS, 
+				reinference_necessary = true;
 
-						buffers,
+				break;
 
-						initial_signi,
-						scene.world.get_common_significant().flavours,
+			default: return abort_v;
+		}
+	}
+	else if constexpr (std::is_same_v<T, hash_subtree_request>) {
+		/* 
+			Only the tree of the last step with sent pool hashes is kept.
+			Answer at most once per such step, so that the client cannot make the server send the same subtrees over and over.
+		*/
 
-						initial_arena_state_payload<true> {
-							scene.world.get_solvable().significant,
-							current_mode,
-							client_id,
-							rcon_level
-						}
-					);
-				}
+		if (sent_pool_hashes_step != payload.step) {
+			LOG("Client %x asked for the hash subtree of step %x, which is no longer kept.", client_id, payload.step);
+		}
+		else if (c.last_sent_hash_subtree_step == payload.step) {
+			LOG("Client %x asked for the hash subtree of step %x again. Ignoring.", client_id, payload.step);
+		}
+		else {
+			c.last_sent_hash_subtree_step = payload.step;
 
-				reinference_necessary = true;
+			sent_subtree.assign_from(sent_pool_hashes_tree, payload.type, payload.step);
 
-				break;
+			LOG("Sending the hashes of %x entities of step %x to client %x.", sent_subtree.entities.size(), payload.step, client_id);
 
-			default: return abort_v;
+			server->send_payload(
+				client_id,
+				game_channel_type::SERVER_SOLVABLE_AND_STEPS,
+
+				std::as_const(sent_subtree)
+			);
 		}
 	}
 	else if constexpr (std::is_same_v<T, arena_player_avatar_payload>) {
@@ -1272,18 +1398,62 @@ void server_setup::send_server_step_entropies(const compact_server_step_entropy&
 	total.meta.reinference_necessary = reinference_necessary;
 	total.meta.state_hash = [&]() -> decltype(total.meta.state_hash) {
 		auto& ticks_remaining = ticks_until_sending_hash;
+		auto& pool_ticks_remaining = ticks_until_sending_pool_hashes;
+
+		if (pool_ticks_remaining > 0) {
+			--pool_ticks_remaining;
+		}
 
 		if (ticks_remaining == 0) {
 			ticks_remaining = vars.state_hash_once_every_tick;
 			--ticks_remaining;
 
-			const auto calculated_hash = get_arena_handle().get_cosmos().calculate_solvable_signi_hash<uint32_t>();
-			return calculated_hash;
+			const auto& cosm = get_arena_handle().get_cosmos();
+
+			hash_tree.update(cosm);
+
+			if (pool_ticks_remaining == 0 && vars.pool_hashes_once_every_tick > 0) {
+				/* 
+					Lets the clients tell which pool diverged if they desynchronize.
+					The tree is kept so that they can then ask for the hashes of every entity in that pool.
+				*/
+
+				pool_ticks_remaining = vars.pool_hashes_once_every_tick;
+
+				total.meta.pool_hashes = hash_tree.get_pool_hashes();
+
+				sent_pool_hashes_tree = hash_tree;
+				sent_pool_hashes_step = static_cast<uint32_t>(cosm.get_total_steps_passed());
+			}
+
+			return hash_tree.get_root();
 		}
 
 		return std::nullopt;
 	}();
 
+	preserialized_server_step_entropy preserialized;
+
+	if (!preserialized.write(total, std::addressof(step_predictor))) {
+		LOG("Failed to serialize the server step entropy.");
+		preserialized.bytes.clear();
+	}
+
+	/* Only for the clients receiving their very first step. */
+	std::optional<preserialized_server_step_entropy> unpredicted;
+
+	auto get_unpredicted = [&]() -> const preserialized_server_step_entropy& {
+		if (unpredicted == std::nullopt) {
+			unpredicted.emplace();
+
+			if (!unpredicted->write(total)) {
+				unpredicted->bytes.clear();
+			}
+		}
+
+		return *unpredicted;
+	};
+
 	auto process_client = [&](const auto client_id, auto& c) {
 		const bool its_time_already = 
 			c.state >= client_state_type::RECEIVING_INITIAL_STATE
@@ -1293,38 +1463,50 @@ void server_setup::send_server_step_entropies(const compact_server_step_entropy&
 			return;
 		}
 
-		{
-			{
-				prestep_client_context context;
-				context.num_entropies_accepted = c.num_entropies_accepted;
+		prestep_client_context context;
+		context.num_entropies_accepted = c.num_entropies_accepted;
+
+		/* Reset the counter */
+		c.num_entropies_accepted = 0;
+
+		if (c.awaited_snapshot != nullptr) {
+			/* The client will catch up once the arena state is compressed. */
+
+			auto& buffered = c.steps_since_snapshot.emplace_back(total);
+			buffered.context = context;
+
+			return;
+		}
 
 #if CONTEXTS_SEPARATE
-				server->send_payload(
-					client_id, 
-					game_channel_type::SERVER_SOLVABLE_AND_STEPS,
+		server->send_payload(
+			client_id, 
+			game_channel_type::SERVER_SOLVABLE_AND_STEPS,
 
-					context
-				);
-#else
-				total.context = context;
+			context
+		);
 #endif
-			}
 
-			/* Reset the counter */
-			c.num_entropies_accepted = 0;
-		}
+		/* 
+			Every client gets its own copy of the bytes serialized once above,
+			as yojimbo allocates messages from separate per-client pools.
+		*/
 
-		/* TODO PERFORMANCE: only serialize the message once and multicast the same buffer to all clients! */
 		server->send_payload(
 			client_id,
 			game_channel_type::SERVER_SOLVABLE_AND_STEPS,
 
-			total
+			c.can_predict_steps ? preserialized : get_unpredicted(),
+			context
 		);
+
+		c.can_predict_steps = true;
 	};
 
 	for_each_id_and_client(process_client, only_connected_v);
 
+	step_predictor.update(total.payload);
+
 	{
 		const auto& interval = vars.send_net_statistics_update_once_every_secs;
 
@@ -1366,6 +1548,17 @@ void server_setup::send_server_step_entropies(const compact_server_step_entropy&
 			};
 
 			for_each_id_and_client(gather_stats, connected_and_integrated_v);
+
+			{
+				auto to_us = [](const double secs) {
+					const auto max_us = double(std::numeric_limits<uint16_t>::max());
+					return static_cast<uint16_t>(std::clamp(secs * 1000000, 0.0, max_us));
+				};
+
+				update.server_step.avg_us = to_us(profiler.step.get_average_units());
+				update.server_step.max_us = to_us(profiler.step.get_maximum_units());
+			}
+
 			for_each_id_and_client(send_stats, only_connected_v);
 
 			when_last_sent_net_statistics = server_time;
@@ -1373,6 +1566,24 @@ void server_setup::send_server_step_entropies(const compact_server_step_entropy&
 	}
 }
 
+solve_settings server_setup::make_solve_settings() {
+	solve_settings out;
+
+	if (shared_logic_pool != nullptr) {
+		out.parallelization.pool = shared_logic_pool;
+	}
+	else if (vars.logic_workers > 0 || vars.verify_parallel_solve) {
+		out.parallelization.pool = &logic_pool;
+	}
+
+	out.parallelization.verify_against_serial = vars.verify_parallel_solve;
+
+	/* Nobody is there to see or hear the effects on a dedicated server. */
+	out.generate_audiovisual_messages = !is_dedicated();
+
+	return out;
+}
+
 void server_setup::reinfer_if_necessary_for(const compact_server_step_entropy& entropy) {
 	if (reinference_necessary || logically_set(entropy.general.added_player)) {
 		LOG("Server: Added player or reinference_necessary. Will reinfer to sync.");
@@ -1492,10 +1703,14 @@ bool server_setup::should_have_admin_character() const {
 }
 
 void server_setup::sleep_until_next_tick() {
-	const auto sleep_dt = server_time - get_current_time();
+	sleep_until(server_time, vars.sleep_mult);
+}
+
+void server_setup::sleep_until(const net_time_t next_tick_time, const float sleep_mult) {
+	const auto sleep_dt = next_tick_time - get_current_time();
 
 	if (sleep_dt > 0.0) {
-		const auto mult = std::clamp(vars.sleep_mult, 0.f, 0.9f);
+		const auto mult = std::clamp(sleep_mult, 0.f, 0.9f);
 
 		if (mult > 0.f) {
 			yojimbo_sleep(static_cast<float>(sleep_dt) * mult);
@@ -1503,6 +1718,32 @@ void server_setup::sleep_until_next_tick() {
 	}
 }
 
+void server_setup::share_logic_pool(augs::thread_pool& pool) {
+	shared_logic_pool = std::addressof(pool);
+	logic_pool.resize(0);
+}
+
+void server_setup::share_common_significant_with(std::vector<const server_setup*> other_arenas) {
+	arenas_sharing_common = std::move(other_arenas);
+	share_common_significant_of_equal_arena();
+}
+
+void server_setup::share_common_significant_of_equal_arena() {
+	for (const auto* const other : arenas_sharing_common) {
+		if (scene.world.share_common_significant_if_equal(other->scene.world)) {
+			return;
+		}
+	}
+}
+
+void server_setup::offset_ticks_by(const net_time_t offset) {
+	server_time += offset;
+}
+
+net_time_t server_setup::get_next_tick_time() const {
+	return server_time;
+}
+
 void server_setup::update_stats(server_network_info& info) const {
 	info = server->get_server_network_info();
 }
@@ -1799,7 +2040,14 @@ void server_setup::log_performance() {
 				);
 
 				last_logged_at = server_time;
-				LOG(summary);
+
+				if (dedicated->num_arenas > 1) {
+					/* All arenas of this process write to the same log. */
+					LOG("Port %x: %x", last_start.port, summary);
+				}
+				else {
+					LOG(summary);
+				}
 			}
 		}
 	}
@@ -1971,6 +2219,11 @@ TEST_CASE("NetSerialization ServerEntropySecond") {
 	networked_server_step_entropy sent;
 	sent.meta.state_hash = 0xdeadbeef;
 	sent.meta.reinference_necessary = true;
+	sent.meta.pool_hashes.emplace();
+
+	for (std::size_t i = 0; i < sent.meta.pool_hashes->size(); ++i) {
+		(*sent.meta.pool_hashes)[i] = static_cast<uint32_t>(0xdead0000 + i);
+	}
 
 	const auto naive_bytes = [&]() {
 		total_mode_player_entropy t;
@@ -2027,4 +2280,123 @@ TEST_CASE("NetSerialization ServerEntropySecond") {
 	REQUIRE(received == sent);
 }
 
+TEST_CASE("NetSerialization PreserializedServerEntropy") {
+	networked_server_step_entropy sent;
+	sent.meta.state_hash = 0xdeadbeef;
+
+	{
+		total_mode_player_entropy t;
+		t.cosmic.motions[game_motion_type::MOVE_CROSSHAIR] = { -3, 7 };
+		t.cosmic.intents.push_back({ game_intent_type::SPRINT, intent_change::PRESSED });
+
+		sent.payload.players.push_back({ mode_player_id::first(), t });
+		sent.payload.general.special_command = match_command::RESTART_MATCH;
+	}
+
+	preserialized_server_step_entropy preserialized;
+	REQUIRE(preserialized.write(sent));
+
+	for (const auto num_accepted : { 0, 1, 2, 17, 255 }) {
+		sent.context.num_entropies_accepted = static_cast<uint8_t>(num_accepted);
+
+		net_messages::server_step_entropy serialized_per_client;
+		serialized_per_client.Release();
+		REQUIRE(serialized_per_client.write_payload(sent));
+
+		net_messages::server_step_entropy patched;
+		patched.Release();
+		REQUIRE(patched.write_payload(preserialized, sent.context));
+
+		REQUIRE(patched.bytes == serialized_per_client.bytes);
+
+		networked_server_step_entropy received;
+		REQUIRE(patched.read_payload(received));
+		REQUIRE(received == sent);
+	}
+}
+
+TEST_CASE("NetSerialization PredictedServerEntropy") {
+	server_step_entropy_predictor encoder;
+	server_step_entropy_predictor decoder;
+
+	const auto second = mode_player_id(1);
+
+	std::size_t unpredicted_bytes = 0;
+	std::size_t predicted_bytes = 0;
+
+	for (int i = 0; i < 50; ++i) {
+		networked_server_step_entropy sent;
+
+		{
+			/* A steady sweep of the crosshair, slowly accelerating. */
+			total_mode_player_entropy t;
+			t.cosmic.motions[game_motion_type::MOVE_CROSSHAIR] = { static_cast<short>(100 + i), static_cast<short>(-40 - i / 2) };
+
+			if (i % 7 == 0) {
+				t.cosmic.intents.push_back({ game_intent_type::SPRINT, intent_change::PRESSED });
+			}
+
+			sent.payload.players.push_back({ mode_player_id::first(), t });
+		}
+
+		if (i % 3 != 0) {
+			/* Appears in some steps only, so it is sometimes predicted from no motion. */
+			total_mode_player_entropy t;
+			t.cosmic.motions[game_motion_type::MOVE_CROSSHAIR] = { 2000, static_cast<short>(5 - i % 4) };
+
+			sent.payload.players.push_back({ second, t });
+		}
+
+		preserialized_server_step_entropy unpredicted;
+		preserialized_server_step_entropy predicted;
+
+		REQUIRE(unpredicted.write(sent));
+		REQUIRE(predicted.write(sent, std::addressof(encoder)));
+
+		encoder.update(sent.payload);
+
+		unpredicted_bytes += unpredicted.bytes.size();
+		predicted_bytes += predicted.bytes.size();
+
+		REQUIRE(predicted.bytes.size() <= unpredicted.bytes.size());
+
+		net_messages::server_step_entropy ss;
+		ss.Release();
+		ss.bytes = predicted.bytes;
+
+		networked_server_step_entropy received;
+		REQUIRE(ss.read_payload(received, std::as_const(decoder)));
+		REQUIRE(received == sent);
+
+		decoder.update(received.payload);
+
+		/* Unpredicted steps can be read with or without the history. */
+		ss.bytes = unpredicted.bytes;
+
+		networked_server_step_entropy received_unpredicted;
+		REQUIRE(ss.read_payload(received_unpredicted));
+		REQUIRE(received_unpredicted == sent);
+	}
+
+	REQUIRE(predicted_bytes < unpredicted_bytes);
+
+	{
+		/* A predicted step cannot be read without the history. */
+		networked_server_step_entropy sent;
+
+		total_mode_player_entropy t;
+		t.cosmic.motions[game_motion_type::MOVE_CROSSHAIR] = { 150, -65 };
+		sent.payload.players.push_back({ mode_player_id::first(), t });
+
+		preserialized_server_step_entropy predicted;
+		REQUIRE(predicted.write(sent, std::addressof(encoder)));
+
+		net_messages::server_step_entropy ss;
+		ss.Release();
+		ss.bytes = predicted.bytes;
+
+		networked_server_step_entropy received;
+		REQUIRE(!ss.read_payload(received));
+	}
+}
 #endif
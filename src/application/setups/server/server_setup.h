@@ -42,6 +42,7 @@
 
 #include "augs/misc/getpid.h"
 #include "application/setups/server/rcon_level.h"
+#include "augs/templates/thread_pool.h"
 
 struct netcode_socket_t;
 struct config_lua_table;
@@ -89,8 +90,6 @@ class server_setup :
 
 	server_step_type current_simulation_step = 0;
 
-	augs::serialization_buffers buffers;
-
 	entropy_accumulator local_collected;
 	compact_server_step_entropy step_collected;
 	bool reinference_necessary = false;
@@ -101,6 +100,16 @@ class server_setup :
 
 	unsigned ticks_until_sending_packets = 0;
 	unsigned ticks_until_sending_hash = 0;
+	unsigned ticks_until_sending_pool_hashes = 0;
+
+	/* Updated with every sent hash, rehashing only the entities modified since. */
+	solvable_hash_tree hash_tree;
+
+	/* The tree whose pool hashes were sent last, kept to answer hash_subtree_request. */
+	solvable_hash_tree sent_pool_hashes_tree;
+	std::optional<uint32_t> sent_pool_hashes_step;
+	solvable_hash_subtree sent_subtree;
+
 	net_time_t when_last_sent_net_statistics = 0;
 	net_time_t when_last_sent_admin_public_settings = 0;
 	net_time_t when_last_sent_heartbeat_to_server_list = 0;
@@ -125,6 +134,15 @@ class server_setup :
 
 	server_nat_traversal nat_traversal;
 
+	augs::thread_pool logic_pool = 0;
+	augs::thread_pool* shared_logic_pool = nullptr;
+
+	std::vector<const server_setup*> arenas_sharing_common;
+	void share_common_significant_of_equal_arena();
+
+	std::shared_ptr<const arena_state_snapshot> last_arena_snapshot;
+	server_step_entropy_predictor step_predictor;
+
 public:
 	net_time_t last_logged_at = 0;
 	server_profiler profiler;
@@ -146,6 +164,8 @@ private:
 
 	void handle_client_messages();
 	void advance_clients_state();
+	void request_arena_state_for(server_client_state&);
+	void send_compressed_arena_states();
 	void send_server_step_entropies(const compact_server_step_entropy& total);
 	void send_packets_if_its_time();
 
@@ -182,6 +202,8 @@ private:
 	mode_player_id get_admin_player_id() const;
 
 	void reinfer_if_necessary_for(const compact_server_step_entropy& entropy);
+
+	solve_settings make_solve_settings();
 	bool server_list_enabled() const;
 	bool has_sent_any_heartbeats() const;
 	void shutdown();
@@ -338,7 +360,7 @@ public:
 					arena.advance(
 						unpacked, 
 						callbacks, 
-						solve_settings()
+						make_solve_settings()
 					);
 				}
 				else {
@@ -363,7 +385,7 @@ public:
 					arena.advance(
 						unpacked, 
 						new_callbacks, 
-						solve_settings()
+						make_solve_settings()
 					);
 
 					if (logically_set(unpacked.general.added_player)) {
@@ -437,6 +459,24 @@ public:
 	bool should_have_admin_character() const;
 
 	void sleep_until_next_tick();
+	static void sleep_until(net_time_t next_tick_time, float sleep_mult);
+
+	/* 
+		For when a single process hosts many arenas:
+		they can solve their steps with one pool of workers,
+		and their ticks can be spread evenly so that they do not all wake up at once.
+	*/
+
+	void share_logic_pool(augs::thread_pool&);
+	void offset_ticks_by(net_time_t);
+
+	/*
+		Arenas on the same map then read a single copy of the common significant state and logical assets.
+		Checked again whenever this server chooses an arena.
+	*/
+
+	void share_common_significant_with(std::vector<const server_setup*> other_arenas);
+	net_time_t get_next_tick_time() const;
 
 	void update_stats(server_network_info&) const;
 
@@ -52,6 +52,7 @@ struct server_vars {
 	unsigned max_buffered_client_commands = 1000;
 
 	unsigned state_hash_once_every_tick = 1;
+	unsigned pool_hashes_once_every_tick = 64;
 	float send_net_statistics_update_once_every_secs = 1;
 
 	float max_kick_ban_linger_secs = 2;
@@ -63,6 +64,9 @@ struct server_vars {
 	unsigned max_bots = 0;
 	float log_performance_once_every_secs = 1;
 	float sleep_mult = 0.1f;
+
+	unsigned logic_workers = 0;
+	bool verify_parallel_solve = false;
 	// END GEN INTROSPECTOR
 };
 
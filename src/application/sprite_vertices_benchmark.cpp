@@ -0,0 +1,142 @@
+#include "augs/log.h"
+#include "augs/misc/timing/timer.h"
+#include "augs/drawing/sprite_helpers.h"
+#include "augs/drawing/drawing.h"
+
+#include "game/cosmos/cosmos.h"
+#include "game/cosmos/entity_handle.h"
+#include "game/cosmos/for_each_entity.h"
+#include "game/modes/test_mode.h"
+#include "test_scenes/test_scene_settings.h"
+
+#include "application/intercosm.h"
+#include "application/sprite_vertices_benchmark.h"
+
+struct benchmarked_sprite {
+	vec2 pos;
+	vec2i size;
+	float rotation = 0.f;
+	rgba color;
+};
+
+static bool vertices_match(const augs::vertex& a, const augs::vertex& b) {
+	return a.pos == b.pos && a.texcoord == b.texcoord && a.color == b.color;
+}
+
+static bool quad_matches(const augs::vertex_quad& q, const augs::vertex_triangle& t1, const augs::vertex_triangle& t2) {
+	const auto& indices = augs::vertex_quad_indices;
+
+	for (std::size_t i = 0; i < 3; ++i) {
+		if (!vertices_match(q.vertices[indices[i]], t1.vertices[i])) {
+			return false;
+		}
+
+		if (!vertices_match(q.vertices[indices[i + 3]], t2.vertices[i])) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool perform_sprite_vertices_benchmark(sol::state& lua, const unsigned passes) {
+#if BUILD_TEST_SCENES
+	LOG("Performing %x sprite vertices benchmark passes.", passes);
+
+	auto scene = std::make_unique<intercosm>();
+	auto ruleset = test_mode_ruleset();
+
+	scene->make_test_scene(lua, { false, 60 }, ruleset);
+
+	const auto& cosm = scene->world;
+
+	std::vector<benchmarked_sprite> sprites;
+
+	cosm.for_each_having<invariants::sprite>(
+		[&](const auto typed_handle) {
+			if (const auto transform = typed_handle.find_logic_transform()) {
+				const auto& sprite = typed_handle.template get<invariants::sprite>();
+
+				sprites.push_back({ transform->pos, sprite.size, transform->rotation, sprite.color });
+			}
+		}
+	);
+
+	LOG("(Sprite vertices benchmark) Sprites: %x", sprites.size());
+
+	/* The image does not matter for the generation, only its texcoords have to be distinct. */
+	auto entry = augs::atlas_entry();
+	entry.atlas_space = xywh(0.25f, 0.5f, 0.125f, 0.0625f);
+
+	augs::vertex_triangle_buffer triangles;
+	augs::vertex_quad_buffer quads;
+
+	auto measure = [&](auto& output) {
+		auto timer = augs::timer();
+
+		for (unsigned p = 0; p < passes; ++p) {
+			output.clear();
+
+			for (const auto& s : sprites) {
+				augs::detail_sprite(output, entry, s.size, s.pos, s.rotation, s.color);
+			}
+		}
+
+		return timer.get<std::chrono::microseconds>() / 1000.0;
+	};
+
+	const auto triangles_ms = measure(triangles);
+	const auto quads_ms = measure(quads);
+
+	const auto triangle_bytes = triangles.size() * sizeof(augs::vertex_triangle);
+	const auto quad_bytes = quads.size() * sizeof(augs::vertex_quad);
+
+	const auto total_passes = std::max(1u, passes);
+
+	LOG("(Sprite vertices benchmark) Triangles: %x bytes per frame, %x ms per frame", triangle_bytes, triangles_ms / total_passes);
+	LOG("(Sprite vertices benchmark) Quads: %x bytes per frame, %x ms per frame", quad_bytes, quads_ms / total_passes);
+
+	if (quads_ms > 0.0) {
+		LOG("(Sprite vertices benchmark) Speedup: %x", triangles_ms / quads_ms);
+	}
+
+	if (passes == 0) {
+		return true;
+	}
+
+	if (triangles.size() != quads.size() * 2) {
+		LOG("(Sprite vertices benchmark) %x triangles were written for %x quads.", triangles.size(), quads.size());
+		return false;
+	}
+
+	for (std::size_t i = 0; i < quads.size(); ++i) {
+		if (!quad_matches(quads[i], triangles[2 * i], triangles[2 * i + 1])) {
+			LOG("(Sprite vertices benchmark) Sprite %x at %x differs.", i, sprites[i].pos);
+			return false;
+		}
+	}
+
+	/* What a drawer without a quad output writes for the quads of neons retained by static_layers_cache. */
+	augs::vertex_triangle_buffer expanded;
+	const auto expanding = augs::drawer { expanded };
+
+	for (const auto& q : quads) {
+		expanding.push_quad(q);
+	}
+
+	for (std::size_t i = 0; i < quads.size(); ++i) {
+		if (!quad_matches(quads[i], expanded[2 * i], expanded[2 * i + 1])) {
+			LOG("(Sprite vertices benchmark) Sprite %x at %x was expanded differently.", i, sprites[i].pos);
+			return false;
+		}
+	}
+
+	return true;
+#else
+	(void)lua;
+	(void)passes;
+
+	LOG("Sprite vertices benchmark requires BUILD_TEST_SCENES.");
+	return false;
+#endif
+}
@@ -0,0 +1,12 @@
+#pragma once
+#include "3rdparty/sol2/sol/forward.hpp"
+
+/*
+	Builds the test scene and writes the geometry of every sprite in it,
+	once as two triangles per sprite and once as a single indexed quad,
+	logging the bytes generated per frame and the time it took for each format.
+
+	Returns false if any quad, once expanded with vertex_quad_indices, differs from its triangles.
+*/
+
+bool perform_sprite_vertices_benchmark(sol::state& lua, unsigned passes);
@@ -0,0 +1,81 @@
+#include <atomic>
+#include <thread>
+
+#include "augs/log.h"
+#include "augs/misc/timing/timer.h"
+#include "augs/templates/thread_pool.h"
+
+#include "application/thread_pool_benchmark.h"
+
+bool perform_thread_pool_benchmark(const unsigned tasks) {
+	const auto num_workers = std::max(1u, std::thread::hardware_concurrency()) - 1;
+
+	LOG("Performing thread pool benchmark with %x tasks and %x workers.", tasks, num_workers);
+
+	augs::thread_pool pool(num_workers);
+
+	std::atomic<unsigned> executed = 0;
+	bool all_executed = true;
+
+	auto measure = [&](const auto& name, auto&& post_and_wait) {
+		executed = 0;
+
+		auto timer = augs::timer();
+		post_and_wait();
+		const auto ns = timer.get<std::chrono::nanoseconds>();
+
+		LOG("(Thread pool benchmark) %x: %f2 ns per task", name, tasks ? ns / tasks : 0.0);
+
+		if (executed.load() != tasks) {
+			LOG("(Thread pool benchmark) %x: executed %x out of %x tasks.", name, executed.load(), tasks);
+			all_executed = false;
+		}
+	};
+
+	auto empty_task = [&executed]() {
+		executed.fetch_add(1, std::memory_order_relaxed);
+	};
+
+	measure("Frame batch", [&]() {
+		for (unsigned i = 0; i < tasks; ++i) {
+			pool.enqueue(empty_task);
+		}
+
+		pool.submit();
+		pool.help_until_no_tasks();
+		pool.wait_for_all_tasks_to_complete();
+	});
+
+	measure("Task group", [&]() {
+		augs::task_group group;
+
+		for (unsigned i = 0; i < tasks; ++i) {
+			pool.run(group, empty_task);
+		}
+
+		pool.wait(group);
+	});
+
+	measure("Parallel for", [&]() {
+		pool.parallel_for(tasks, 1, [&](const std::size_t first, const std::size_t last) {
+			executed.fetch_add(static_cast<unsigned>(last - first), std::memory_order_relaxed);
+		});
+	});
+
+	measure("Nested parallel for", [&]() {
+		const unsigned outer = 16;
+
+		pool.parallel_for(outer, 1, [&](const std::size_t first, const std::size_t last) {
+			for (std::size_t o = first; o < last; ++o) {
+				const auto inner_first = tasks * o / outer;
+				const auto inner_last = tasks * (o + 1) / outer;
+
+				pool.parallel_for(inner_last - inner_first, 1, [&](const std::size_t b, const std::size_t e) {
+					executed.fetch_add(static_cast<unsigned>(e - b), std::memory_order_relaxed);
+				});
+			}
+		});
+	});
+
+	return all_executed;
+}
@@ -0,0 +1,9 @@
+#pragma once
+
+/*
+	Measures the overhead per task of augs::thread_pool
+	by posting empty tasks through each of its interfaces:
+	the frame batch, a task group, a flat and a nested parallel_for.
+*/
+
+bool perform_thread_pool_benchmark(unsigned tasks);
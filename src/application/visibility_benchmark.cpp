@@ -0,0 +1,136 @@
+#include "augs/log.h"
+#include "augs/misc/timing/timer.h"
+
+#include "game/cosmos/cosmos.h"
+#include "game/cosmos/entity_handle.h"
+#include "game/cosmos/for_each_entity.h"
+#include "game/enums/filters.h"
+#include "game/modes/test_mode.h"
+#include "game/stateless_systems/visibility_system.h"
+#include "test_scenes/test_scene_settings.h"
+
+#include "application/intercosm.h"
+#include "application/visibility_benchmark.h"
+
+static bool responses_match(const visibility_response& a, const visibility_response& b) {
+	/* The engines find the same hits, so the only allowed differences come from the order of the fixtures. */
+	const auto epsilon_px = 0.01f;
+
+	if (a.edges.size() != b.edges.size()) {
+		return false;
+	}
+
+	for (std::size_t i = 0; i < a.edges.size(); ++i) {
+		if (!a.edges[i].first.compare(b.edges[i].first, epsilon_px)) {
+			return false;
+		}
+
+		if (!a.edges[i].second.compare(b.edges[i].second, epsilon_px)) {
+			return false;
+		}
+	}
+
+	return
+		a.discontinuities.size() == b.discontinuities.size()
+		&& a.vertex_hits.size() == b.vertex_hits.size()
+	;
+}
+
+bool perform_visibility_benchmark(sol::state& lua, const unsigned passes) {
+#if BUILD_TEST_SCENES
+	LOG("Performing %x visibility benchmark passes.", passes);
+
+	auto scene = std::make_unique<intercosm>();
+	auto ruleset = test_mode_ruleset();
+
+	scene->make_test_scene(lua, { false, 60 }, ruleset);
+
+	const auto& cosm = scene->world;
+
+	std::vector<visibility_request> requests;
+
+	cosm.for_each_having<components::light>(
+		[&](const auto light_entity) {
+			const auto& light = light_entity.template get<components::light>();
+
+			visibility_request request;
+			request.eye_transform = light_entity.get_logic_transform();
+			request.queried_rect = light.calc_reach_trimmed();
+			request.filter = predefined_queries::line_of_sight();
+			request.subject = light_entity;
+
+			requests.push_back(request);
+		}
+	);
+
+	cosm.for_each_having<components::sentience>(
+		[&](const auto character) {
+			visibility_request request;
+			request.eye_transform = character.get_logic_transform();
+			request.queried_rect = vec2(1920, 1080);
+			request.filter = predefined_queries::line_of_sight();
+			request.subject = character;
+
+			requests.push_back(request);
+		}
+	);
+
+	LOG("(Visibility benchmark) Requests: %x", requests.size());
+
+	std::vector<debug_line> lines;
+	const auto system = visibility_system(lines);
+
+	auto measure = [&](const visibility_engine_type engine, std::vector<visibility_response>& responses) {
+		responses.resize(requests.size());
+
+		auto timer = augs::timer();
+
+		for (unsigned p = 0; p < passes; ++p) {
+			for (std::size_t i = 0; i < requests.size(); ++i) {
+				system.calc_visibility(cosm, requests[i], responses[i], engine);
+			}
+		}
+
+		return timer.get<std::chrono::microseconds>() / 1000.0;
+	};
+
+	std::vector<visibility_response> ray_cast_responses;
+	std::vector<visibility_response> sweep_responses;
+
+	const auto ray_cast_ms = measure(visibility_engine_type::RAY_CAST, ray_cast_responses);
+	const auto sweep_ms = measure(visibility_engine_type::SWEEP, sweep_responses);
+
+	const auto total_requests = std::max(std::size_t(1), requests.size() * passes);
+
+	LOG("(Visibility benchmark) Ray cast: %x ms, %x ms per request", ray_cast_ms, ray_cast_ms / total_requests);
+	LOG("(Visibility benchmark) Sweep: %x ms, %x ms per request", sweep_ms, sweep_ms / total_requests);
+
+	if (sweep_ms > 0.0) {
+		LOG("(Visibility benchmark) Speedup: %x", ray_cast_ms / sweep_ms);
+	}
+
+	bool all_match = true;
+
+	for (std::size_t i = 0; i < requests.size(); ++i) {
+		if (!responses_match(ray_cast_responses[i], sweep_responses[i])) {
+			LOG(
+				"(Visibility benchmark) Request %x at %x differs: %x vs %x edges.",
+				i,
+				requests[i].eye_transform.pos,
+				ray_cast_responses[i].edges.size(),
+				sweep_responses[i].edges.size()
+			);
+
+			all_match = false;
+		}
+	}
+
+	return all_match;
+#else
+	(void)lua;
+	(void)passes;
+
+	LOG("Visibility benchmark requires BUILD_TEST_SCENES.");
+	return false;
+#endif
+}
@@ -0,0 +1,11 @@
+#pragma once
+#include "3rdparty/sol2/sol/forward.hpp"
+
+/*
+	Builds the test scene and calculates the visibility of every light and every character in it
+	with each visibility_engine_type, the way the fog of war and the light rendering request it.
+
+	Returns false if the engines disagree about any of the visibility polygons.
+*/
+
+bool perform_visibility_benchmark(sol::state& lua, unsigned passes);
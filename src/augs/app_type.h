@@ -3,6 +3,7 @@
 enum class app_type {
 	MASTERSERVER,
 	DEDICATED_SERVER,
+	SPECTATOR_RELAY,
 	GAME_CLIENT
 };
 
@@ -12,6 +13,7 @@ inline std::string get_preffix_for(const app_type t) {
 	switch (t) {
 		case app_type::MASTERSERVER: return "masterserver_";
 		case app_type::DEDICATED_SERVER: return "dedi_server_";
+		case app_type::SPECTATOR_RELAY: return "relay_";
 		default: return "";
 	}
 }
@@ -17,6 +17,21 @@ namespace augs {
 	struct drawer {
 		vertex_triangle_buffer& output_buffer;
 
+		/* 
+			If set, sprites are written here as quads instead of as triangle pairs to output_buffer.
+			Only for outputs whose drawing order does not matter, as quads are drawn after all triangles.
+		*/
+
+		vertex_quad_buffer* quad_output = nullptr;
+
+		drawer(
+			vertex_triangle_buffer& output_buffer,
+			vertex_quad_buffer* const quad_output = nullptr
+		) :
+			output_buffer(output_buffer),
+			quad_output(quad_output)
+		{}
+
 		operator vertex_triangle_buffer&() const {
 			return output_buffer;
 		}
@@ -171,6 +186,21 @@ namespace augs {
 			output_buffer.emplace_back(std::forward<Args>(args)...);
 			return *this;
 		}
+
+		self push_quad(const vertex_quad& q) const {
+			if (quad_output != nullptr) {
+				quad_output->push_back(q);
+				return *this;
+			}
+
+			const auto& i = vertex_quad_indices;
+			const auto& v = q.vertices;
+
+			output_buffer.push_back({{ v[i[0]], v[i[1]], v[i[2]] }});
+			output_buffer.push_back({{ v[i[3]], v[i[4]], v[i[5]] }});
+
+			return *this;
+		}
 	};
 
 	struct drawer_with_default : public drawer {
@@ -181,9 +211,10 @@ namespace augs {
 
 		drawer_with_default(
 			vertex_triangle_buffer& output_buffer,
-			const atlas_entry default_texture
+			const atlas_entry default_texture,
+			vertex_quad_buffer* const quad_output = nullptr
 		) :
-			base({ output_buffer }),
+			base(output_buffer, quad_output),
 			default_texture(default_texture)
 		{}
 		
@@ -104,4 +104,36 @@ namespace augs {
 		t1.vertices[1].color = t2.vertices[1].color = col;
 		t1.vertices[2].color = t2.vertices[2].color = col;
 	}
+
+	FORCE_INLINE void write_sprite_quad(
+		vertex_quad& q,
+		const augs::atlas_entry considered_texture,
+		const std::array<vec2, 4>& v,
+		const rgba col = white,
+		const flip_flags flip = flip_flags()
+	) {
+		std::array<vec2, 4> texcoords = {
+			vec2(0.f, 0.f),
+			vec2(1.f, 0.f),
+			vec2(1.f, 1.f),
+			vec2(0.f, 1.f)
+		};
+
+		if (flip.horizontally) {
+			for (auto& v : texcoords) {
+				v.x = 1.f - v.x;
+			}
+		}
+		if (flip.vertically) {
+			for (auto& v : texcoords) {
+				v.y = 1.f - v.y;
+			}
+		}
+
+		for (int i = 0; i < 4; ++i) {
+			q.vertices[i].pos = v[i];
+			q.vertices[i].texcoord = considered_texture.get_atlas_space_uv(texcoords[i]);
+			q.vertices[i].color = col;
+		}
+	}
 }
@@ -92,14 +92,9 @@ namespace augs {
 			target_color *= in.colorize;
 		}
 
-		auto triangles = make_sprite_triangles(
-			considered_texture,
-			points,
-			target_color, 
-			in.flip 
-		);
+		const bool color_wave = spr.effect == sprite_special_effect::COLOR_WAVE;
 
-		if (spr.effect == sprite_special_effect::COLOR_WAVE) {
+		auto calc_wave_colors = [&]() {
 			auto left_col = rgba(hsv{ std::fmod(in.global_time_seconds * spr.effect_speed_multiplier / 2.f, 1.f), 1.0, 1.0 });
 			auto right_col = rgba(hsv{ std::fmod(in.global_time_seconds * spr.effect_speed_multiplier / 2.f / 2.f + 0.3f, 1.f), 1.0, 1.0 });
 
@@ -109,6 +104,40 @@ namespace augs {
 			left_col.a = target_color.a;
 			right_col.a = target_color.a;
 
+			return std::make_pair(left_col, right_col);
+		};
+
+		if (const auto quads = in.output.quad_output) {
+			auto& q = quads->emplace_back();
+
+			write_sprite_quad(
+				q,
+				considered_texture,
+				points,
+				target_color,
+				in.flip
+			);
+
+			if (color_wave) {
+				const auto [left_col, right_col] = calc_wave_colors();
+
+				q.vertices[0].color = q.vertices[3].color = left_col;
+				q.vertices[1].color = q.vertices[2].color = right_col;
+			}
+
+			return;
+		}
+
+		auto triangles = make_sprite_triangles(
+			considered_texture,
+			points,
+			target_color, 
+			in.flip 
+		);
+
+		if (color_wave) {
+			const auto [left_col, right_col] = calc_wave_colors();
+
 			auto& t1 = triangles[0];
 			auto& t2 = triangles[1];
 
@@ -29,6 +29,10 @@ namespace augs {
 		}
 
 	public:
+		static constexpr std::size_t num_queues_v = sizeof...(Queues);
+
+		template <class T>
+		static constexpr std::size_t index_of_v = index_in_v<T, Queues...>;
 
 		template <class T>
 		void post(T&& message_object) {
@@ -67,6 +71,24 @@ namespace augs {
 			});
 		}
 
+		template <class F>
+		void for_each_queue(F&& callback) {
+			std::size_t i = 0;
+
+			::unfold<make_vector, Queues...>(queues, [&](auto& q) {
+				callback(i++, q);
+			});
+		}
+
+		template <class F>
+		void for_each_queue(F&& callback) const {
+			std::size_t i = 0;
+
+			::unfold<make_vector, Queues...>(queues, [&](const auto& q) {
+				callback(i++, q);
+			});
+		}
+
 		auto& operator+=(const storage_for_message_queues& b) {
 			auto c = [&](auto& q) {
 				concatenate(q, std::get<remove_cref<decltype(q)>>(b.queues));
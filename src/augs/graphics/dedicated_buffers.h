@@ -66,10 +66,14 @@ namespace augs {
 		vertex_line_buffer lines;
 		special_buffer specials;
 
+		/* Drawn after the triangles, so only written where the order of drawing does not matter. */
+		vertex_quad_buffer quads;
+
 		void clear() {
 			triangles.clear();
 			lines.clear();
 			specials.clear();
+			quads.clear();
 		}
 	};
 
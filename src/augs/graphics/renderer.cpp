@@ -56,6 +56,20 @@ namespace augs {
 		push_command(std::move(cmd));
 	}
 
+	void renderer::call_quads(const vertex_quad_buffer& buffer) {
+		if (buffer.empty()) {
+			return;
+		}
+
+		num_total_triangles_drawn += buffer.size() * 2;
+
+		drawcall_command cmd;
+		cmd.quads = buffer.data();
+		cmd.count = buffer.size();
+
+		push_command(std::move(cmd));
+	}
+
 	void renderer::call_and_clear_triangles() {
 		const auto& triangles = triangle_buffers.get();
 		const auto& specials = special_buffers.get();
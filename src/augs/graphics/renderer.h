@@ -171,6 +171,7 @@ namespace augs {
 		void set_additive_blending();
 		
 		void call_triangles(const vertex_triangle_buffer&);
+		void call_quads(const vertex_quad_buffer&);
 
 		void call_triangles(dedicated_buffer_vector, uint32_t index);
 		void call_triangles(dedicated_buffer);
@@ -44,9 +44,42 @@ namespace augs {
 			GLuint triangle_buffer_id = 0xdeadbeef;
 			GLuint special_buffer_id = 0xdeadbeef;
 			GLuint imgui_elements_id = 0xdeadbeef;
+			GLuint quad_indices_id = 0xdeadbeef;
 			GLuint vao_buffer = 0xdeadbeef;
+
+			std::size_t quad_indices_capacity = 0;
 		};
 
+#if BUILD_OPENGL
+		/* 
+			Every quad is indexed the same way, so a single index buffer is shared by all quad drawcalls.
+			It is only regenerated when a drawcall has more quads than ever before.
+		*/
+
+		static void reserve_quad_indices(GLuint& id, std::size_t& capacity, const std::size_t quads_n) {
+			GL_CHECK(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, id));
+
+			if (quads_n <= capacity) {
+				return;
+			}
+
+			capacity = std::max(capacity * 2, std::max(quads_n, std::size_t(4096)));
+
+			std::vector<uint32_t> indices;
+			indices.reserve(capacity * vertex_quad_indices.size());
+
+			for (std::size_t q = 0; q < capacity; ++q) {
+				const auto first_vertex = static_cast<uint32_t>(q * 4);
+
+				for (const auto i : vertex_quad_indices) {
+					indices.push_back(first_vertex + i);
+				}
+			}
+
+			GL_CHECK(glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(uint32_t) * indices.size(), indices.data(), GL_STATIC_DRAW));
+		}
+#endif
+
 		renderer_backend::~renderer_backend() = default;
 
 		renderer_backend::renderer_backend() : platform(std::make_unique<renderer_backend::platform_data>()) {
@@ -80,6 +113,7 @@ namespace augs {
 			GL_CHECK(glBindVertexArray(platform->vao_buffer));
 
 			GL_CHECK(glGenBuffers(1, &platform->imgui_elements_id));
+			GL_CHECK(glGenBuffers(1, &platform->quad_indices_id));
 
 			GL_CHECK(glGenBuffers(1, &platform->triangle_buffer_id));
 			GL_CHECK(glBindBuffer(GL_ARRAY_BUFFER, platform->triangle_buffer_id));
@@ -131,6 +165,7 @@ namespace augs {
 			const auto& p = *platform;
 
 			const auto triangles = cmd.triangles;
+			const auto quads = cmd.quads;
 			const auto lines = cmd.lines;
 			const auto specials = cmd.specials;
 
@@ -150,6 +185,13 @@ namespace augs {
 				GL_CHECK(glDrawArrays(GL_TRIANGLES, 0, cnt * 3));
 			}
 
+			if (quads) {
+				reserve_quad_indices(platform->quad_indices_id, platform->quad_indices_capacity, cmd.count);
+
+				GL_CHECK(buffer_data(GL_ARRAY_BUFFER, sizeof(vertex_quad) * cnt, quads, GL_STREAM_DRAW));
+				GL_CHECK(glDrawElements(GL_TRIANGLES, cnt * 6, GL_UNSIGNED_INT, nullptr));
+			}
+
 			if (lines) {
 				GL_CHECK(buffer_data(GL_ARRAY_BUFFER, sizeof(vertex_line) * cnt, lines, GL_STREAM_DRAW));
 				GL_CHECK(glDrawArrays(GL_LINES, 0, cnt * 2));
@@ -210,6 +252,15 @@ namespace augs {
 
 							perform(translated_cmd);
 						}
+
+						if (const auto quads_n = buffers.quads.size(); quads_n > 0) {
+							drawcall_command translated_cmd;
+
+							translated_cmd.quads = buffers.quads.data();
+							translated_cmd.count = quads_n;
+
+							perform(translated_cmd);
+						}
 					};
 
 					if constexpr(std::is_invocable_v<C, A>) {
@@ -41,6 +41,7 @@ namespace augs {
 
 	struct drawcall_command {
 		const vertex_triangle* triangles = nullptr;
+		const vertex_quad* quads = nullptr;
 		const vertex_line* lines = nullptr;
 		const special* specials = nullptr;
 
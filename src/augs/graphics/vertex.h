@@ -28,6 +28,23 @@ namespace augs {
 		vertex& get_vert(int i) { return vertices[i]; }
 	};
 
+	/*
+		A sprite as four corners instead of two triangles with two vertices repeated.
+		The corners are in the order of make_sprite_points,
+		and vertex_quad_indices split the quad into the same triangles as write_sprite_triangles.
+	*/
+
+	struct vertex_quad {
+		std::array<vertex, 4> vertices;
+
+		vertex& get_vert(int i) { return vertices[i]; }
+	};
+
+	inline constexpr std::array<uint32_t, 6> vertex_quad_indices = {
+		0, 2, 3,
+		0, 1, 2
+	};
+
 	struct vertex_line {
 		vertex vertices[2];
 
@@ -41,6 +58,7 @@ namespace augs {
 	};
 
 	using vertex_triangle_buffer = std::vector<vertex_triangle>;
+	using vertex_quad_buffer = std::vector<vertex_quad>;
 	using vertex_line_buffer = std::vector<vertex_line>;
 	using special_buffer = std::vector<special>;
 }
\ No newline at end of file
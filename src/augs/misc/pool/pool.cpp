@@ -3,8 +3,10 @@
 #include "augs/misc/pool/pool.h"
 #include "augs/misc/pool/pool_io.hpp"
 #include "augs/misc/pool/pool_allocate.h"
+#include "augs/misc/pool/soa_pool_io.hpp"
 #include "augs/misc/constant_size_vector.h"
 #include "augs/readwrite/readwrite_test_cycle.h"
+#include "augs/readwrite/to_bytes.h"
 
 using p_t = augs::pool<int, of_size<6>::make_nontrivial_constant_vector, unsigned short>;
 using k_t = p_t::key_type; 
@@ -176,4 +178,139 @@ TEST_CASE("Pool Readwrite") {
 	test_pool<augs::pool<float, make_vector, unsigned char>>();
 }
 
+struct soa_test_object {
+	int a = 0;
+	float b = 0.f;
+
+	bool operator==(const soa_test_object& o) const {
+		return a == o.a && b == o.b;
+	}
+};
+
+namespace augs {
+	template <>
+	struct soa_layout<soa_test_object> {
+		using column_list = type_list<int, float>;
+
+		template <class S, class F>
+		static void for_each_column(S& object, F callback) {
+			callback(object.a);
+			callback(object.b);
+		}
+
+		static soa_test_object assemble(const int a, const float b) {
+			return { a, b };
+		}
+	};
+}
+
+TEST_CASE("Pool SoaMatchesAos") {
+	using aos_t = augs::pool<soa_test_object, make_vector, unsigned short, type_list<double>>;
+	using soa_t = augs::soa_pool<soa_test_object, make_vector, unsigned short, type_list<double>>;
+
+	aos_t aos;
+	soa_t soa;
+
+	std::vector<aos_t::key_type> keys;
+
+	auto require_same_bytes = [&]() {
+		std::vector<std::byte> aos_bytes;
+		std::vector<std::byte> soa_bytes;
+
+		augs::assign_bytes(aos_bytes, aos);
+		augs::assign_bytes(soa_bytes, soa);
+
+		REQUIRE(aos_bytes == soa_bytes);
+	};
+
+	for (int i = 0; i < 20; ++i) {
+		const auto object = soa_test_object { i, i * 0.5f };
+
+		const auto aos_key = aos.allocate(object).key;
+		const auto soa_key = soa.allocate(object).key;
+
+		REQUIRE(aos_key == soa_key);
+		keys.push_back(aos_key);
+
+		aos.get_corresponding<double>(aos.get(aos_key)) = i * 2.0;
+		soa.get_corresponding<double>(soa_key) = i * 2.0;
+	}
+
+	require_same_bytes();
+
+	{
+		std::vector<std::pair<aos_t::undo_free_input_type, soa_test_object>> undos;
+
+		for (std::size_t i = 0; i < keys.size(); i += 3) {
+			const auto content = aos.get(keys[i]);
+			const auto aos_undo = aos.free(keys[i]);
+			const auto soa_undo = soa.free(keys[i]);
+
+			REQUIRE(aos_undo.has_value());
+			REQUIRE(soa_undo.has_value());
+			REQUIRE(aos_undo->real_index == soa_undo->real_index);
+
+			undos.push_back({ *aos_undo, content });
+		}
+
+		require_same_bytes();
+
+		const auto freed_bytes = augs::to_bytes(aos);
+
+		for (auto it = undos.rbegin(); it != undos.rend(); ++it) {
+			const auto aos_result = aos.undo_free(it->first, it->second);
+			const auto soa_result = soa.undo_free(it->first, it->second);
+
+			REQUIRE(aos_result.key == soa_result.key);
+			REQUIRE(aos_result.object.a == soa_result.object);
+			REQUIRE(aos_result.object.b == soa.get<float>(soa_result.object));
+		}
+
+		require_same_bytes();
+
+		for (std::size_t i = 0; i < keys.size(); i += 3) {
+			aos.free(keys[i]);
+			soa.free(keys[i]);
+		}
+
+		REQUIRE(freed_bytes == augs::to_bytes(aos));
+		require_same_bytes();
+	}
+
+	for (const auto& k : keys) {
+		REQUIRE(aos.alive(k) == soa.alive(k));
+
+		if (aos.alive(k)) {
+			REQUIRE(aos.get(k).a == soa.get<int>(k));
+			REQUIRE(aos.get(k).b == soa.get<float>(k));
+			REQUIRE(aos.get(k) == soa.assemble(k));
+			REQUIRE(aos.get_corresponding<double>(aos.get(k)) == soa.get_corresponding<double>(k));
+			REQUIRE(soa.get_corresponding<double>(k) == soa.get<int>(k) * 2.0);
+		}
+		else {
+			REQUIRE(soa.find<int>(k) == nullptr);
+		}
+	}
+
+	REQUIRE(aos.size() == soa.size());
+	REQUIRE(soa.get_column<int>().size() == soa.size());
+	REQUIRE(soa.get_column<float>().size() == soa.size());
+	REQUIRE(soa.get_corresponding_array<double>().size() == soa.size());
+
+	{
+		std::vector<std::byte> aos_bytes;
+		augs::assign_bytes(aos_bytes, aos);
+
+		soa_t reloaded;
+		auto s = augs::cref_memory_stream(aos_bytes);
+		augs::read_bytes(s, reloaded);
+
+		std::vector<std::byte> reloaded_bytes;
+		augs::assign_bytes(reloaded_bytes, reloaded);
+
+		REQUIRE(aos_bytes == reloaded_bytes);
+		REQUIRE(reloaded.get_corresponding_array<double>().size() == reloaded.size());
+	}
+}
+
 #endif
@@ -7,6 +7,7 @@
 #endif
 
 #include "augs/templates/maybe_const.h"
+#include "augs/templates/remove_cref.h"
 #include "augs/templates/traits/container_traits.h"
 #include "augs/templates/container_templates.h"
 
@@ -316,6 +317,44 @@ namespace augs {
 			;
 		}
 
+		bool layout_equal(const pool& b) const {
+			auto trivially_equal = [](const auto& x, const auto& y) {
+				using V = typename remove_cref<decltype(x)>::value_type;
+				static_assert(std::is_trivially_copyable_v<V>);
+
+				return 
+					x.size() == y.size()
+					&& !std::memcmp(x.data(), y.data(), x.size() * sizeof(V))
+				;
+			};
+
+			return 
+				trivially_equal(slots, b.slots)
+				&& trivially_equal(indirectors, b.indirectors)
+				&& trivially_equal(free_indirectors, b.free_indirectors)
+			;
+		}
+
+		/*
+			Copies only the objects at the indirection indices passed by for_each_indirection_index,
+			and all synchronized arrays.
+			The caller guarantees that both pools have an equal layout
+			and that all the other objects are already equal.
+		*/
+
+		template <class F>
+		void assign_objects_from(const pool& b, F&& for_each_indirection_index) {
+			for_each_indirection_index([&](const std::size_t indirection_index) {
+				const auto real_index = indirectors[indirection_index].real_index;
+
+				if (real_index != static_cast<size_type>(-1)) {
+					objects[real_index] = b.objects[real_index];
+				}
+			});
+
+			synchronized_arrays = b.synchronized_arrays;
+		}
+
 		template <class F>
 		void for_each_id_and_object(F f) {
 			key_type id;
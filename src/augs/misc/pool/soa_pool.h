@@ -0,0 +1,669 @@
+#pragma once
+#include <cstring>
+#include <optional>
+
+#if !IS_PRODUCTION_BUILD
+#include "augs/ensure.h"
+#endif
+
+#include "augs/templates/maybe_const.h"
+#include "augs/templates/nth_type_in.h"
+#include "augs/templates/remove_cref.h"
+#include "augs/templates/per_type.h"
+#include "augs/templates/traits/container_traits.h"
+#include "augs/templates/container_templates.h"
+
+#include "augs/misc/pool/pool_structs.h"
+#include "augs/misc/pool/pooled_object_id.h"
+
+namespace augs {
+	/*
+		Describes how an object of type T is split into columns.
+
+		template <>
+		struct soa_layout<T> {
+			using column_list = type_list<...>;
+
+			// Calls callback with a reference to every column of the object, in the order of column_list.
+			template <class S, class F>
+			static void for_each_column(S& object, F callback);
+
+			// Reconstructs the object from its columns, in the order of column_list.
+			static T assemble(const Columns&...);
+		};
+	*/
+
+	template <class T>
+	struct soa_layout;
+
+	/*
+		A structure-of-arrays counterpart of augs::pool.
+
+		Identification is exactly the same as in augs::pool -
+		the same slots, indirectors and versioning, so the ids are interchangeable
+		given the same sequence of allocations and frees.
+
+		Objects are however never stored as a whole - every column lives in its own dense array,
+		so iterating over a single column touches only the memory of that column.
+
+		The byte serialization writes the objects as if they were stored in augs::pool<T>,
+		so the two are interchangeable in streams and files.
+
+		Synchronized arrays are kept exactly like in augs::pool -
+		one element per object, moved around together with the object's columns.
+
+		Wherever augs::pool deals in references to whole objects,
+		soa_pool deals in references to the element of the first column (mapped_type),
+		so generic code written against augs::pool mostly works unchanged.
+		The other columns of the same object are then reached with get<C>(first_column_element).
+	*/
+
+	template <class T, template <class> class make_container_type, class size_type, class synchronized_array_list = type_list<>, class... id_keys>
+	class soa_pool {
+	public:
+		using value_type = T;
+		using layout_type = soa_layout<T>;
+		using column_list = typename layout_type::column_list;
+		using mapped_type = nth_type_in_list_t<0, column_list>;
+
+		/* What augs::pool<T> would hold its objects in. Only used to (de)serialize. */
+		using object_pool_type = make_container_type<T>;
+
+		using key_type = pooled_object_id<size_type, id_keys...>;
+		using unversioned_id_type = unversioned_id<size_type, id_keys...>;
+		using undo_free_input_type = pool_undo_free_input<size_type, id_keys...>;
+
+		using used_size_type = size_type;
+
+		static constexpr bool has_synchronized_arrays = !std::is_same_v<synchronized_array_list, type_list<>>;
+
+	protected:
+		using pool_slot_type = pool_slot<size_type>;
+		using pool_indirector_type = pool_indirector<size_type>;
+
+		make_container_type<pool_slot_type> slots;
+		make_container_type<pool_indirector_type> indirectors;
+		make_container_type<size_type> free_indirectors;
+		per_type_container<column_list, make_container_type> columns;
+		per_type_container<synchronized_array_list, make_container_type> synchronized_arrays;
+
+		template <class>
+		struct assembler;
+
+		template <template <class...> class List, class... Columns>
+		struct assembler<List<Columns...>> {
+			template <class S>
+			static T assemble(S& self, const size_type real_index) {
+				return layout_type::assemble(self.columns.template get_for<Columns>()[real_index]...);
+			}
+		};
+
+		bool correct_range(const key_type key) const {
+			return
+				key.indirection_index != static_cast<size_type>(-1)
+				&& key.indirection_index < indirectors.size()
+			;
+		}
+
+		static bool versions_match(const pool_indirector_type& indirector, const key_type& key) {
+			return indirector.version == key.version && indirector.real_index != static_cast<size_type>(-1);
+		}
+
+		template <class C, class S>
+		static auto find_impl(S& self, const key_type key) -> maybe_const_ptr_t<std::is_const_v<S>, C> {
+			if (!self.correct_range(key)) {
+				return nullptr;
+			}
+
+			const auto& indirector = self.indirectors[key.indirection_index];
+
+			if (!versions_match(indirector, key)) {
+				return nullptr;
+			}
+
+			return std::addressof(self.template get_column<C>()[indirector.real_index]);
+		}
+
+		template <class C, class S>
+		static auto& get_impl(S& self, const key_type key) {
+#if !IS_PRODUCTION_BUILD
+			ensure(self.correct_range(key));
+			ensure(versions_match(self.indirectors[key.indirection_index], key));
+#endif
+			return self.template get_column<C>()[self.indirectors[key.indirection_index].real_index];
+		}
+
+		void push_back_columns(T&& object) {
+			layout_type::for_each_column(object, [this](auto& c) {
+				using C = remove_cref<decltype(c)>;
+				columns.template get_for<C>().emplace_back(std::move(c));
+			});
+
+			if constexpr(has_synchronized_arrays) {
+				synchronized_arrays.for_each_container([](auto& container) {
+					container.emplace_back();
+				});
+			}
+		}
+
+		void pop_back_columns() {
+			columns.for_each_container([](auto& column) {
+				column.pop_back();
+			});
+
+			if constexpr(has_synchronized_arrays) {
+				synchronized_arrays.for_each_container([](auto& container) {
+					container.pop_back();
+				});
+			}
+		}
+
+		auto objects_capacity() const {
+			return get_column<mapped_type>().capacity();
+		}
+
+		auto& first_column() {
+			return get_column<mapped_type>();
+		}
+
+		const auto& first_column() const {
+			return get_column<mapped_type>();
+		}
+
+		template <class C, class S, class M>
+		static auto& get_sibling_impl(S& self, M& object) {
+			return self.template get_column<C>()[index_in(self.first_column(), object)];
+		}
+
+	public:
+		soa_pool() : soa_pool(0u) {}
+
+		explicit soa_pool(const size_type slot_count) {
+			reserve(slot_count);
+		}
+
+		void reserve(const size_type new_capacity) {
+			if (new_capacity == static_cast<size_type>(-1)) {
+				throw std::runtime_error("Last element index is reserved for signifying unused indirectors.");
+			}
+
+			const auto old_capacity = capacity();
+
+			if (new_capacity <= old_capacity) {
+				return;
+			}
+
+			slots.reserve(new_capacity);
+			columns.reserve(new_capacity);
+
+			if constexpr(has_synchronized_arrays) {
+				synchronized_arrays.reserve(new_capacity);
+			}
+
+			indirectors.resize(new_capacity);
+			free_indirectors.reserve(new_capacity);
+
+			for (size_type i = 0; i < (new_capacity - old_capacity); ++i) {
+				free_indirectors.push_back(new_capacity - i - 1);
+			}
+		}
+
+		struct allocation_result {
+			key_type key;
+			mapped_type& object;
+
+			operator key_type() const {
+				return key;
+			}
+		};
+
+		template <class... Args>
+		allocation_result allocate(Args&&... args) {
+			if (size() == capacity()) {
+				if (size() < max_size()) {
+					const auto new_size = static_cast<std::size_t>(size()) * 2 + 1;
+					reserve(static_cast<size_type>(std::min(static_cast<std::size_t>(max_size()), new_size)));
+				}
+				else {
+					throw std::runtime_error("Pool is full and cannot be further expanded!");
+				}
+			}
+
+			const auto next_free_indirector = free_indirectors.back();
+			free_indirectors.pop_back();
+
+			auto& allocated_indirector = indirectors[next_free_indirector];
+			allocated_indirector.real_index = size();
+
+			key_type allocated_id;
+			allocated_id.version = allocated_indirector.version;
+			allocated_id.indirection_index = next_free_indirector;
+
+			pool_slot_type allocated_slot;
+			allocated_slot.pointing_indirector = next_free_indirector;
+
+			slots.push_back(allocated_slot);
+			push_back_columns(T(std::forward<Args>(args)...));
+
+			return { allocated_id, first_column().back() };
+		}
+
+		void undo_last_allocate(const key_type key) {
+			if (!correct_range(key)) {
+				return;
+			}
+
+			auto& indirector = indirectors[key.indirection_index];
+
+			if (!versions_match(indirector, key)) {
+				return;
+			}
+
+			if (indirector.real_index != size() - 1) {
+				throw std::runtime_error("Undoing allocations in bad order.");
+			}
+
+			free_indirectors.push_back(key.indirection_index);
+			indirector.real_index = static_cast<size_type>(-1);
+
+			slots.pop_back();
+			pop_back_columns();
+		}
+
+		std::optional<undo_free_input_type> free(const key_type key) {
+			if (!correct_range(key)) {
+				return std::nullopt;
+			}
+
+			auto& indirector = indirectors[key.indirection_index];
+
+			if (!versions_match(indirector, key)) {
+				return std::nullopt;
+			}
+
+			const auto removed_at_index = indirector.real_index;
+
+			undo_free_input_type result;
+			result.indirection_index = key.indirection_index;
+			result.real_index = removed_at_index;
+
+			free_indirectors.push_back(key.indirection_index);
+
+			++indirector.version;
+			indirector.real_index = static_cast<size_type>(-1);
+
+			if (removed_at_index != size() - 1) {
+				const auto indirector_of_last_element = slots.back().pointing_indirector;
+				indirectors[indirector_of_last_element].real_index = removed_at_index;
+
+				slots[removed_at_index] = std::move(slots.back());
+
+				columns.for_each_container([removed_at_index](auto& column) {
+					column[removed_at_index] = std::move(column.back());
+				});
+
+				if constexpr(has_synchronized_arrays) {
+					synchronized_arrays.for_each_container([removed_at_index](auto& container) {
+						container[removed_at_index] = std::move(container.back());
+					});
+				}
+			}
+
+			slots.pop_back();
+			pop_back_columns();
+
+			return result;
+		}
+
+		template <class... Args>
+		allocation_result undo_free(
+			const undo_free_input_type in,
+			Args&&... removed_content
+		) {
+			static_assert(sizeof...(Args) > 0, "Specify what to construct.");
+
+			const auto indirection_index = in.indirection_index;
+			const auto real_index = in.real_index;
+
+			if (free_indirectors.back() == indirection_index) {
+				free_indirectors.pop_back();
+			}
+			else {
+				erase_element(free_indirectors, indirection_index);
+			}
+
+			auto& indirector = indirectors[indirection_index];
+
+			indirector.real_index = real_index;
+			--indirector.version;
+
+			key_type new_key;
+			new_key.version = indirector.version;
+			new_key.indirection_index = indirection_index;
+
+			const auto last_index = size();
+
+			pool_slot_type slot; 
+			slot.pointing_indirector = indirection_index;
+
+			slots.push_back(slot);
+			push_back_columns(T(std::forward<Args>(removed_content)...));
+
+			if (real_index < last_index) {
+				/* Move the object that took the place of the freed one back to the end. */
+				indirectors[slots[real_index].pointing_indirector].real_index = last_index;
+
+				std::swap(slots[real_index], slots[last_index]);
+
+				columns.for_each_container([real_index, last_index](auto& column) {
+					std::swap(column[real_index], column[last_index]);
+				});
+
+				if constexpr(has_synchronized_arrays) {
+					synchronized_arrays.for_each_container([real_index, last_index](auto& container) {
+						std::swap(container[real_index], container[last_index]);
+					});
+				}
+			}
+
+			return { new_key, first_column()[real_index] };
+		}
+
+		auto get_versioned(const unversioned_id_type key) const {
+			key_type ver;
+			ver.indirection_index = key.indirection_index;
+			ver.version = indirectors[key.indirection_index].version;
+			return ver;
+		}
+
+		auto find_versioned(const unversioned_id_type key) const {
+			key_type ver;
+
+			if (key.indirection_index != static_cast<size_type>(-1) && key.indirection_index < indirectors.size()) {
+				ver.indirection_index = key.indirection_index;
+				ver.version = indirectors[key.indirection_index].version;
+			}
+
+			return ver;
+		}
+
+		auto to_id(const size_type real_object_index) const {
+			return get_nth_id(real_object_index);
+		}
+
+		mapped_type& get(const key_type key) {
+			return get_impl<mapped_type>(*this, key);
+		}
+
+		const mapped_type& get(const key_type key) const {
+			return get_impl<mapped_type>(*this, key);
+		}
+
+		mapped_type* find(const key_type key) {
+			return find_impl<mapped_type>(*this, key);
+		}
+
+		const mapped_type* find(const key_type key) const {
+			return find_impl<mapped_type>(*this, key);
+		}
+
+		mapped_type* data() {
+			return first_column().data();
+		}
+
+		const mapped_type* data() const {
+			return first_column().data();
+		}
+
+		/* The element of column C that belongs to the same object as the element of the first column. */
+
+		template <class C>
+		C& get(mapped_type& object) {
+			return get_sibling_impl<C>(*this, object);
+		}
+
+		template <class C>
+		const C& get(const mapped_type& object) const {
+			return get_sibling_impl<C>(*this, object);
+		}
+
+		template <class C>
+		auto& get_column() {
+			return columns.template get_for<C>();
+		}
+
+		template <class C>
+		const auto& get_column() const {
+			return columns.template get_for<C>();
+		}
+
+		template <class C>
+		C& get(const key_type key) {
+			return get_impl<C>(*this, key);
+		}
+
+		template <class C>
+		const C& get(const key_type key) const {
+			return get_impl<C>(*this, key);
+		}
+
+		template <class C>
+		C* find(const key_type key) {
+			return find_impl<C>(*this, key);
+		}
+
+		template <class C>
+		const C* find(const key_type key) const {
+			return find_impl<C>(*this, key);
+		}
+
+		template <class C>
+		auto& get_corresponding_array() {
+			return synchronized_arrays.template get_for<C>();
+		}
+
+		template <class C>
+		const auto& get_corresponding_array() const {
+			return synchronized_arrays.template get_for<C>();
+		}
+
+		template <class C>
+		C& get_corresponding(const mapped_type& object) {
+			return get_corresponding_array<C>()[index_in(first_column(), object)];
+		}
+
+		template <class C>
+		const C& get_corresponding(const mapped_type& object) const {
+			return get_corresponding_array<C>()[index_in(first_column(), object)];
+		}
+
+		template <class C>
+		C& get_corresponding(const key_type key) {
+			return get_corresponding_array<C>()[indirectors[key.indirection_index].real_index];
+		}
+
+		template <class C>
+		const C& get_corresponding(const key_type key) const {
+			return get_corresponding_array<C>()[indirectors[key.indirection_index].real_index];
+		}
+
+		T assemble(const key_type key) const {
+			return assembler<column_list>::assemble(*this, indirectors[key.indirection_index].real_index);
+		}
+
+		T assemble_nth(const size_type real_index) const {
+			return assembler<column_list>::assemble(*this, real_index);
+		}
+
+		bool alive(const key_type key) const {
+			return correct_range(key) && versions_match(indirectors[key.indirection_index], key);
+		}
+
+		bool dead(const key_type key) const {
+			return !alive(key);
+		}
+
+		auto get_nth_id(const size_type i) const {
+			key_type id;
+
+			const auto& s = slots[i];
+			id.indirection_index = s.pointing_indirector;
+			id.version = indirectors[s.pointing_indirector].version;
+
+			return id;
+		}
+
+		template <class F>
+		void for_each_id_and_object(F f) {
+			for (size_type i = 0; i < size(); ++i) {
+				f(get_nth_id(i), first_column()[i]);
+			}
+		}
+
+		template <class F>
+		void for_each_id_and_object(F f) const {
+			for (size_type i = 0; i < size(); ++i) {
+				f(get_nth_id(i), first_column()[i]);
+			}
+		}
+
+		auto find_nth_id(const size_type i) const {
+			key_type id;
+
+			if (i < slots.size()) {
+				const auto& s = slots[i];
+
+				id.indirection_index = s.pointing_indirector;
+
+				if (s.pointing_indirector < indirectors.size()) {
+					id.version = indirectors[s.pointing_indirector].version;
+				}
+			}
+
+			return id;
+		}
+
+		auto size() const {
+			return static_cast<size_type>(slots.size());
+		}
+
+		auto capacity() const {
+			return static_cast<size_type>(indirectors.size());
+		}
+
+		auto max_size() const {
+			const auto size_type_limit = static_cast<size_type>(std::numeric_limits<size_type>::max() - 1);
+			const auto container_limit = static_cast<size_type>(std::min(
+				static_cast<std::size_t>(size_type_limit),
+				static_cast<std::size_t>(first_column().max_size())
+			));
+
+			return std::min(size_type_limit, container_limit);
+		}
+
+		bool empty() const {
+			return size() == 0;
+		}
+
+		bool size_at_capacity() const {
+			return size() == capacity();
+		}
+
+		bool can_still_expand() const {
+			return size() < max_size();
+		}
+
+		bool full() const {
+			return size_at_capacity() && !can_still_expand();
+		}
+
+		const auto& get_indirectors() const {
+			return indirectors;
+		}
+
+		bool layout_equal(const soa_pool& b) const {
+			auto trivially_equal = [](const auto& x, const auto& y) {
+				using V = typename remove_cref<decltype(x)>::value_type;
+				static_assert(std::is_trivially_copyable_v<V>);
+
+				return 
+					x.size() == y.size()
+					&& !std::memcmp(x.data(), y.data(), x.size() * sizeof(V))
+				;
+			};
+
+			return 
+				trivially_equal(slots, b.slots)
+				&& trivially_equal(indirectors, b.indirectors)
+				&& trivially_equal(free_indirectors, b.free_indirectors)
+			;
+		}
+
+		/* See augs::pool::assign_objects_from. */
+
+		template <class F>
+		void assign_objects_from(const soa_pool& b, F&& for_each_indirection_index) {
+			for_each_indirection_index([&](const std::size_t indirection_index) {
+				const auto real_index = indirectors[indirection_index].real_index;
+
+				if (real_index != static_cast<size_type>(-1)) {
+					columns.for_each_container([&](auto& column) {
+						using V = typename remove_cref<decltype(column)>::value_type;
+						column[real_index] = b.columns.template get_for<V>()[real_index];
+					});
+				}
+			});
+
+			synchronized_arrays = b.synchronized_arrays;
+		}
+
+		void clear() {
+			const auto c = capacity();
+
+			slots.clear();
+			columns.clear();
+			indirectors.clear();
+			free_indirectors.clear();
+
+			if constexpr(has_synchronized_arrays) {
+				synchronized_arrays.clear();
+			}
+
+			reserve(c);
+		}
+
+		template <class Archive>
+		void write_object_bytes(Archive& ar) const;
+
+		template <class Archive>
+		void read_object_bytes(Archive& ar);
+
+		template <class Archive>
+		void write_object_lua(Archive& ar) const;
+
+		template <class Archive>
+		void read_object_lua(const Archive& ar);
+	};
+}
+
+namespace augs {
+	template <class A, class T, template <class> class C, class S, class SA, class... K>
+	void read_object_bytes(A& ar, soa_pool<T, C, S, SA, K...>& storage) {
+		storage.read_object_bytes(ar);
+	}
+
+	template <class A, class T, template <class> class C, class S, class SA, class... K>
+	void write_object_bytes(A& ar, const soa_pool<T, C, S, SA, K...>& storage) {
+		storage.write_object_bytes(ar);
+	}
+
+	template <class A, class T, template <class> class C, class S, class SA, class... K>
+	void read_object_lua(const A& ar, soa_pool<T, C, S, SA, K...>& storage) {
+		storage.read_object_lua(ar);
+	}
+
+	template <class A, class T, template <class> class C, class S, class SA, class... K>
+	void write_object_lua(A& ar, const soa_pool<T, C, S, SA, K...>& storage) {
+		storage.write_object_lua(ar);
+	}
+}
@@ -0,0 +1,9 @@
+#pragma once
+
+namespace augs {
+	template <class T>
+	struct soa_layout;
+
+	template <class T, template <class> class C, class S, class SA, class... K>
+	class soa_pool;
+}
@@ -0,0 +1,172 @@
+#pragma once
+#include <memory>
+#include "augs/misc/pool/soa_pool.h"
+
+#include "augs/readwrite/byte_readwrite_declaration.h"
+#include "augs/readwrite/lua_readwrite_declaration.h"
+
+#if READWRITE_OVERLOAD_TRAITS_INCLUDED || LUA_READWRITE_OVERLOAD_TRAITS_INCLUDED
+#error "I/O traits were included BEFORE I/O overloads, which may cause them to be omitted under some compilers."
+#endif
+
+namespace augs {
+	/*
+		The objects are assembled into a temporary object_pool_type
+		and written exactly as augs::pool writes its objects,
+		so that the two are interchangeable in streams
+		and archives that specialize the writing of object_pool_type apply to both.
+	*/
+
+	template <class T, template <class> class C, class S, class SA, class... K>
+	template <class Archive>
+	void soa_pool<T, C, S, SA, K...>::write_object_bytes(Archive& ar) const {
+		{
+			/* Might be large if statically allocated. */
+			const auto objects = std::make_unique<object_pool_type>();
+			objects->reserve(objects_capacity());
+
+			for (S i = 0; i < size(); ++i) {
+				objects->emplace_back(assemble_nth(i));
+			}
+
+			augs::write_capacity_bytes(ar, *objects);
+			augs::write_bytes(ar, *objects);
+		}
+
+		auto w = [&ar](const auto& object) {
+			augs::write_capacity_bytes(ar, object);
+			augs::write_bytes(ar, object);
+		};
+
+		w(slots);
+		w(indirectors);
+		w(free_indirectors);
+	}
+
+	template <class T, template <class> class C, class S, class SA, class... K>
+	template <class Archive>
+	void soa_pool<T, C, S, SA, K...>::read_object_bytes(Archive& ar) {
+		columns.clear();
+
+		{
+			const auto objects = std::make_unique<object_pool_type>();
+
+			augs::read_capacity_bytes(ar, *objects);
+			augs::read_bytes(ar, *objects);
+
+			columns.reserve(objects->capacity());
+
+			for (auto& object : *objects) {
+				push_back_columns(std::move(object));
+			}
+		}
+
+		auto r = [&ar](auto& object) {
+			augs::read_capacity_bytes(ar, object);
+			augs::read_bytes(ar, object);
+		};
+
+		r(slots);
+		r(indirectors);
+		r(free_indirectors);
+
+		if constexpr(has_synchronized_arrays) {
+			synchronized_arrays.clear();
+			synchronized_arrays.for_each_container(
+				[&](auto& container) {
+					container.resize(slots.size());
+				}
+			);
+		}
+	}
+
+	/* Same format as augs::pool::write_object_lua. */
+
+	template <class T, template <class> class C, class S, class SA, class... K>
+	template <class Archive>
+	void soa_pool<T, C, S, SA, K...>::write_object_lua(Archive& into) const {
+		auto objects_table = into.create();
+		auto indirectors_table = into.create();
+
+		for (S i = 0; i < size(); ++i) {
+			const auto lua_table_index = static_cast<int>(i + 1);
+
+			write_table_or_field(objects_table, assemble_nth(i), lua_table_index);
+
+			const auto pointing = slots[i].pointing_indirector;
+			const auto version = indirectors[pointing].version;
+
+			auto meta_entry_table = indirectors_table.create();
+
+			write_table_or_field(meta_entry_table, pointing, "pointing");
+			write_table_or_field(meta_entry_table, version, "version");
+
+			indirectors_table[lua_table_index] = meta_entry_table;
+		}
+
+		into["objects"] = objects_table;
+		into["indirectors"] = indirectors_table;
+	}
+
+	template <class T, template <class> class C, class S, class SA, class... K>
+	template <class Archive>
+	void soa_pool<T, C, S, SA, K...>::read_object_lua(const Archive& from) {
+		columns.clear();
+		slots.clear();
+		indirectors.clear();
+		free_indirectors.clear();
+
+		auto objects_table = from["objects"];
+		auto indirectors_table = from["indirectors"];
+
+		int counter = 1;
+
+		while (true) {
+			auto object_entry = objects_table[counter];
+			auto meta_entry = indirectors_table[counter];
+
+			if (object_entry.valid() && meta_entry.valid()) {
+				{
+					T object;
+					read_lua(object_entry, object);
+					push_back_columns(std::move(object));
+				}
+
+				S pointing;
+				S version;
+
+				general_from_lua_value(meta_entry["pointing"], pointing);
+				general_from_lua_value(meta_entry["version"], version);
+
+				indirectors.resize(std::max(indirectors.size(), static_cast<std::size_t>(pointing) + 1));
+
+				indirectors[pointing].real_index = static_cast<S>(slots.size());
+				indirectors[pointing].version = version;
+
+				pool_slot_type slot;
+				slot.pointing_indirector = pointing;
+				slots.emplace_back(std::move(slot));
+			}
+			else {
+				break;
+			}
+
+			++counter;
+		}
+
+		for (std::size_t i = 0; i < indirectors.size(); ++i) {
+			if (indirectors[i].real_index == static_cast<S>(-1)) {
+				free_indirectors.push_back(static_cast<S>(i));
+			}
+		}
+
+		if constexpr(has_synchronized_arrays) {
+			synchronized_arrays.clear();
+			synchronized_arrays.for_each_container(
+				[&](auto& container) {
+					container.resize(slots.size());
+				}
+			);
+		}
+	}
+}
@@ -0,0 +1,150 @@
+#if BUILD_UNIT_TESTS
+#include <Catch/single_include/catch2/catch.hpp>
+#include "augs/network/jitter_buffer.h"
+
+namespace {
+	constexpr double step_secs = 1.0 / 60;
+
+	struct counted_unpack {
+		std::size_t commands = 0;
+		int sum = 0;
+	};
+
+	template <class B>
+	counted_unpack unpack_step(B& buffer, const augs::jitter_buffer_settings& settings) {
+		counted_unpack out;
+
+		out.commands = buffer.unpack(settings, [&out](const int c) { out.sum += c; });
+
+		return out;
+	}
+}
+
+TEST_CASE("JitterBuffer RingWrapsAround") {
+	augs::jitter_buffer<int> buffer;
+	buffer.set_capacity(3);
+
+	augs::jitter_buffer_settings settings;
+	settings.max_adaptive_steps = 0;
+	settings.catch_up_above_steps = 100;
+
+	int next = 0;
+	int expected = 0;
+
+	for (int step = 0; step < 20; ++step) {
+		REQUIRE(buffer.acquire(int(next++), step * step_secs, step_secs));
+
+		const auto unpacked = unpack_step(buffer, settings);
+
+		REQUIRE(unpacked.commands == 1);
+		REQUIRE(unpacked.sum == expected++);
+	}
+
+	REQUIRE(buffer.acquire(1, 0.0, step_secs));
+	REQUIRE(buffer.acquire(2, 0.0, step_secs));
+	REQUIRE(buffer.acquire(3, 0.0, step_secs));
+	REQUIRE(!buffer.acquire(4, 0.0, step_secs));
+
+	REQUIRE(buffer.get_stats().overruns == 1);
+	REQUIRE(buffer.size() == 3);
+}
+
+TEST_CASE("JitterBuffer CatchUp") {
+	augs::jitter_buffer_settings settings;
+	settings.max_adaptive_steps = 0;
+	settings.catch_up_above_steps = 2;
+
+	{
+		/* The whole excess is consumed at once. */
+		augs::jitter_buffer<int> buffer;
+		buffer.set_capacity(16);
+
+		settings.catch_up = augs::jitter_catch_up_type::SQUASH;
+
+		for (int i = 0; i < 5; ++i) {
+			buffer.acquire(1, 0.0, step_secs);
+		}
+
+		const auto unpacked = unpack_step(buffer, settings);
+
+		REQUIRE(unpacked.commands == 5);
+		REQUIRE(unpacked.sum == 5);
+		REQUIRE(buffer.empty());
+		REQUIRE(buffer.get_stats().steps_caught_up == 4);
+	}
+
+	{
+		/* One extra command per step. */
+		augs::jitter_buffer<int> buffer;
+		buffer.set_capacity(16);
+
+		settings.catch_up = augs::jitter_catch_up_type::STRETCH;
+
+		for (int i = 0; i < 5; ++i) {
+			buffer.acquire(1, 0.0, step_secs);
+		}
+
+		REQUIRE(unpack_step(buffer, settings).commands == 2);
+		REQUIRE(unpack_step(buffer, settings).commands == 2);
+		REQUIRE(unpack_step(buffer, settings).commands == 1);
+		REQUIRE(buffer.empty());
+	}
+}
+
+TEST_CASE("JitterBuffer AdaptsToJitter") {
+	augs::jitter_buffer<int> buffer;
+	buffer.set_capacity(64);
+
+	augs::jitter_buffer_settings settings;
+	settings.max_adaptive_steps = 4;
+
+	double now = 0.0;
+
+	/* Commands arriving on time need no buffering. */
+
+	for (int step = 0; step < 200; ++step) {
+		buffer.acquire(1, now, step_secs);
+		REQUIRE(unpack_step(buffer, settings).commands == 1);
+
+		now += step_secs;
+	}
+
+	REQUIRE(buffer.get_stats().target_depth == 0);
+	REQUIRE(buffer.get_stats().underruns == 0);
+
+	/* Every other step, two commands arrive at once. */
+
+	for (int step = 0; step < 200; ++step) {
+		if (step % 2 == 1) {
+			buffer.acquire(1, now, step_secs);
+			buffer.acquire(1, now, step_secs);
+		}
+
+		unpack_step(buffer, settings);
+		now += step_secs;
+	}
+
+	const auto& stats = buffer.get_stats();
+
+	REQUIRE(stats.target_depth > 0);
+	REQUIRE(stats.target_depth <= settings.max_adaptive_steps);
+	REQUIRE(stats.underruns > 0);
+	REQUIRE(stats.steps_extrapolated >= stats.underruns);
+
+	/* Once deep enough, the same pattern no longer underruns. */
+
+	const auto underruns_before = stats.underruns;
+
+	for (int step = 0; step < 200; ++step) {
+		if (step % 2 == 1) {
+			buffer.acquire(1, now, step_secs);
+			buffer.acquire(1, now, step_secs);
+		}
+
+		unpack_step(buffer, settings);
+		now += step_secs;
+	}
+
+	REQUIRE(buffer.get_stats().underruns <= underruns_before + 1);
+}
+#endif
@@ -1,108 +1,202 @@
 #pragma once
 #include <vector>
+#include <cmath>
+#include <cstddef>
+#include <algorithm>
 
 namespace augs {
-	template<class command>
+	enum class jitter_catch_up_type {
+		/* Consume the whole excess in a single step. */
+		SQUASH,
+		/* Consume one extra command per step until the target depth is reached. */
+		STRETCH
+	};
+
+	struct jitter_buffer_settings {
+		/* Catching up begins once the buffer holds this many commands more than the target depth. */
+		unsigned catch_up_above_steps = 2;
+		unsigned max_squashed_at_once = 255;
+
+		/* 0 disables the adaptation - the target depth is then always 0. */
+		unsigned max_adaptive_steps = 4;
+		float jitter_multiplier = 2.f;
+
+		jitter_catch_up_type catch_up = jitter_catch_up_type::STRETCH;
+	};
+
+	struct jitter_buffer_stats {
+		std::size_t depth = 0;
+		std::size_t target_depth = 0;
+
+		/* Smoothed deviation of the inter-arrival times from the step, in steps. */
+		double jitter_steps = 0.0;
+
+		std::size_t underruns = 0;
+		std::size_t overruns = 0;
+		std::size_t steps_extrapolated = 0;
+		std::size_t steps_caught_up = 0;
+	};
+
+	/*
+		Buffers the commands that arrive over the network so that one of them can be consumed every step.
+
+		The commands are kept in a ring buffer of fixed capacity,
+		so neither acquiring nor unpacking them moves or allocates anything.
+
+		The target depth follows the measured jitter of the arrivals:
+		it grows quickly whenever the commands arrive irregularly
+		and decays slowly once they arrive on time again,
+		so only the connections that need it pay with latency.
+	*/
+
+	template <class command>
 	class jitter_buffer {
-		size_t lower_limit = 3;
-		unsigned steps_extrapolated = 0;
+		static constexpr double jitter_attack_v = 1.0 / 8;
+		static constexpr double jitter_release_v = 1.0 / 256;
 
-		bool initial_filling = true;
-	public:
-		std::vector<command> buffer;
-		
-		void acquire_new_command(const command& c) {
-			buffer.push_back(c);
-
-			if (initial_filling) {
-				if (buffer.size() >= lower_limit) {
-					initial_filling = false;
-				}
-			}
+		std::vector<command> ring;
+		std::size_t first = 0;
+		std::size_t count = 0;
+
+		double last_arrival = -1.0;
+		bool catching_up = false;
+		bool underrunning = false;
+
+		jitter_buffer_stats stats;
+
+		std::size_t index_of(const std::size_t i) const {
+			const auto idx = first + i;
+			return idx >= ring.size() ? idx - ring.size() : idx;
 		}
 
-		void acquire_new_command(command&& c) {
-			buffer.emplace_back(c);
+		void update_jitter(const double arrival_time, const double step_secs) {
+			if (last_arrival >= 0.0 && step_secs > 0.0) {
+				const auto deviation = std::abs((arrival_time - last_arrival) / step_secs - 1.0);
+				const auto rate = deviation > stats.jitter_steps ? jitter_attack_v : jitter_release_v;
 
-			if (initial_filling) {
-				if (buffer.size() >= lower_limit) {
-					initial_filling = false;
-				}
+				stats.jitter_steps += (deviation - stats.jitter_steps) * rate;
 			}
+
+			last_arrival = arrival_time;
 		}
-		
-		template <class Iter>
-		void acquire_new_commands(Iter first, Iter last) {
-			buffer.insert(buffer.end(), first, last);
-
-			if (initial_filling) {
-				if (buffer.size() >= lower_limit) {
-					initial_filling = false;
-				}
-			}
+
+		void update_target(const jitter_buffer_settings& settings) {
+			const auto wanted = std::round(stats.jitter_steps * settings.jitter_multiplier);
+			const auto limit = static_cast<double>(settings.max_adaptive_steps);
+
+			stats.target_depth = static_cast<std::size_t>(std::clamp(wanted, 0.0, limit));
 		}
 
-		std::vector<command> unpack_commands_once() {
-			std::vector<command> next_commands;
+		std::size_t calc_num_to_unpack(const jitter_buffer_settings& settings) {
+			const auto target = stats.target_depth;
 
-			if (!initial_filling) {
-				const auto steps_to_unpack = steps_extrapolated + 1;
+			if (count >= target + settings.catch_up_above_steps) {
+				catching_up = true;
+			}
 
-				if (buffer.size() >= steps_to_unpack) {
-					next_commands.assign(buffer.begin(), buffer.begin() + steps_to_unpack);
-					buffer		  .erase(buffer.begin(), buffer.begin() + steps_to_unpack);
-				}
+			if (count <= target) {
+				catching_up = false;
+			}
 
-				const bool unpacked_successfully = next_commands.size() > 0;
+			if (!catching_up) {
+				return 1;
+			}
 
-				if (unpacked_successfully) {
-					steps_extrapolated = 0;
-				}
-				else {
-					++steps_extrapolated;
-				}
+			const auto max_at_once = std::max(std::size_t(1), std::size_t(settings.max_squashed_at_once));
+
+			if (settings.catch_up == jitter_catch_up_type::SQUASH) {
+				catching_up = false;
+				return std::min(count - target, max_at_once);
 			}
 
-			return next_commands;
+			return std::min(std::size_t(2), max_at_once);
 		}
 
-		bool unpack_next_command(command& next_command) {
-			if (!initial_filling) {
-				if (buffer.size() > 0) {
-					next_command = std::move(buffer.front());
-					buffer.erase(buffer.begin());
+	public:
+		/* Allocates all slots at once and discards the buffered commands. */
 
-					return true;
-				}
-			}
+		void set_capacity(const std::size_t new_capacity) {
+			ring.clear();
+			ring.resize(new_capacity);
 
-			return false;
+			first = 0;
+			count = 0;
+			stats.depth = 0;
 		}
 
-		void allow_to_refill() {
-			initial_filling = true;
+		std::size_t capacity() const {
+			return ring.size();
 		}
 
-		bool is_still_refilling() const {
-			return initial_filling;
+		std::size_t size() const {
+			return count;
 		}
 
-		size_t get_available_command_count() const {
-			return buffer.size();
+		bool empty() const {
+			return count == 0;
 		}
 
-		size_t get_lower_limit() const {
-			return lower_limit;
+		/* Returns false if the buffer is full, in which case the command is dropped. */
+
+		bool acquire(command&& c, const double arrival_time, const double step_secs) {
+			update_jitter(arrival_time, step_secs);
+
+			if (count == ring.size()) {
+				++stats.overruns;
+				return false;
+			}
+
+			ring[index_of(count)] = std::move(c);
+			stats.depth = ++count;
+
+			return true;
 		}
 
-		void set_lower_limit(size_t new_lower_limit) {
-			lower_limit = new_lower_limit;
+		/*
+			Call once per step.
+			Passes every command due in this step to the callback, oldest first,
+			and returns how many were passed - 0 means that the input has to be extrapolated.
+		*/
+
+		template <class F>
+		std::size_t unpack(const jitter_buffer_settings& settings, F&& callback) {
+			update_target(settings);
+
+			if (count == 0) {
+				if (last_arrival >= 0.0) {
+					if (!underrunning) {
+						++stats.underruns;
+						underrunning = true;
+					}
+
+					++stats.steps_extrapolated;
+				}
+
+				return 0;
+			}
+
+			underrunning = false;
+
+			const auto n = std::min(calc_num_to_unpack(settings), count);
+
+			for (std::size_t i = 0; i < n; ++i) {
+				auto& slot = ring[first];
+				callback(slot);
+				slot = command();
+
+				first = index_of(1);
+			}
+
+			count -= n;
+
+			stats.depth = count;
+			stats.steps_caught_up += n - 1;
+
+			return n;
 		}
 
-		unsigned get_steps_extrapolated() const {
-			return steps_extrapolated;
+		const jitter_buffer_stats& get_stats() const {
+			return stats;
 		}
 	};
-
-
-}
\ No newline at end of file
+}
@@ -0,0 +1,284 @@
+#include <array>
+#include <cstring>
+#include <algorithm>
+#include <thread>
+#include <chrono>
+
+#include "augs/network/netcode_socket_includes.h"
+#include "augs/network/netcode_socket_batch.h"
+
+#if BATCHED_SOCKET_IO
+#include <sys/epoll.h>
+#endif
+
+namespace augs {
+#if BATCHED_SOCKET_IO
+	static netcode_address_t from_sockaddr(const sockaddr_storage& addr) {
+		netcode_address_t out;
+		std::memset(&out, 0, sizeof(out));
+
+		if (addr.ss_family == AF_INET6) {
+			const auto& addr_ipv6 = reinterpret_cast<const sockaddr_in6&>(addr);
+			out.type = NETCODE_ADDRESS_IPV6;
+
+			for (int i = 0; i < 8; ++i) {
+				uint16_t part;
+				std::memcpy(&part, reinterpret_cast<const uint8_t*>(&addr_ipv6.sin6_addr) + i * 2, sizeof(part));
+				out.data.ipv6[i] = ntohs(part);
+			}
+
+			out.port = ntohs(addr_ipv6.sin6_port);
+		}
+		else if (addr.ss_family == AF_INET) {
+			const auto& addr_ipv4 = reinterpret_cast<const sockaddr_in&>(addr);
+			const auto s_addr = addr_ipv4.sin_addr.s_addr;
+			out.type = NETCODE_ADDRESS_IPV4;
+
+			out.data.ipv4[0] = (uint8_t) ( ( s_addr & 0x000000FF ) );
+			out.data.ipv4[1] = (uint8_t) ( ( s_addr & 0x0000FF00 ) >> 8 );
+			out.data.ipv4[2] = (uint8_t) ( ( s_addr & 0x00FF0000 ) >> 16 );
+			out.data.ipv4[3] = (uint8_t) ( ( s_addr & 0xFF000000 ) >> 24 );
+
+			out.port = ntohs(addr_ipv4.sin_port);
+		}
+
+		return out;
+	}
+
+	static socklen_t to_sockaddr(const netcode_address_t& in, sockaddr_storage& out) {
+		std::memset(&out, 0, sizeof(out));
+
+		if (in.type == NETCODE_ADDRESS_IPV6) {
+			auto& addr_ipv6 = reinterpret_cast<sockaddr_in6&>(out);
+			addr_ipv6.sin6_family = AF_INET6;
+
+			for (int i = 0; i < 8; ++i) {
+				const uint16_t part = htons(in.data.ipv6[i]);
+				std::memcpy(reinterpret_cast<uint8_t*>(&addr_ipv6.sin6_addr) + i * 2, &part, sizeof(part));
+			}
+
+			addr_ipv6.sin6_port = htons(in.port);
+			return sizeof(sockaddr_in6);
+		}
+
+		auto& addr_ipv4 = reinterpret_cast<sockaddr_in&>(out);
+		addr_ipv4.sin_family = AF_INET;
+		addr_ipv4.sin_addr.s_addr =
+			( ( (uint32_t) in.data.ipv4[0] ) ) |
+			( ( (uint32_t) in.data.ipv4[1] ) << 8 ) |
+			( ( (uint32_t) in.data.ipv4[2] ) << 16 ) |
+			( ( (uint32_t) in.data.ipv4[3] ) << 24 )
+		;
+
+		addr_ipv4.sin_port = htons(in.port);
+		return sizeof(sockaddr_in);
+	}
+#endif
+
+	netcode_socket_batch::netcode_socket_batch(const std::vector<netcode_socket_t*>& sockets) : sockets(sockets) {
+		received_bytes.resize(max_batch_v * NETCODE_MAX_PACKET_BYTES);
+		received_from.resize(max_batch_v);
+		received_sizes.resize(max_batch_v);
+
+#if BATCHED_SOCKET_IO
+		epoll_handle = epoll_create1(0);
+
+		if (epoll_handle == -1) {
+			LOG("epoll_create1 failed: %x. Falling back to polling.", std::strerror(errno));
+			return;
+		}
+
+		for (std::size_t i = 0; i < sockets.size(); ++i) {
+			epoll_event ev;
+			std::memset(&ev, 0, sizeof(ev));
+
+			ev.events = EPOLLIN;
+			ev.data.u64 = i;
+
+			if (epoll_ctl(epoll_handle, EPOLL_CTL_ADD, sockets[i]->handle, &ev) == -1) {
+				LOG("epoll_ctl failed for socket %x: %x. Falling back to polling.", i, std::strerror(errno));
+
+				close(epoll_handle);
+				epoll_handle = -1;
+				return;
+			}
+		}
+#endif
+	}
+
+	netcode_socket_batch::~netcode_socket_batch() {
+#if BATCHED_SOCKET_IO
+		if (epoll_handle != -1) {
+			close(epoll_handle);
+		}
+#endif
+	}
+
+	void netcode_socket_batch::wait(const double timeout_secs) {
+		ready.clear();
+
+#if BATCHED_SOCKET_IO
+		if (epoll_handle != -1) {
+			std::array<epoll_event, 64> events;
+
+			const auto timeout_ms = static_cast<int>(std::max(0.0, timeout_secs * 1000));
+			const auto n = epoll_wait(epoll_handle, events.data(), static_cast<int>(events.size()), timeout_ms);
+
+			for (int i = 0; i < n; ++i) {
+				ready.push_back(static_cast<std::size_t>(events[i].data.u64));
+			}
+
+			return;
+		}
+#endif
+
+		if (!received_anything && timeout_secs > 0.0) {
+			std::this_thread::sleep_for(std::chrono::duration<double>(timeout_secs));
+		}
+
+		for (std::size_t i = 0; i < sockets.size(); ++i) {
+			ready.push_back(i);
+		}
+	}
+
+	std::size_t netcode_socket_batch::receive_batch(const std::size_t socket_index) {
+		auto& socket = *sockets[socket_index];
+
+#if BATCHED_SOCKET_IO
+		if (epoll_handle != -1) {
+			std::array<mmsghdr, max_batch_v> headers;
+			std::array<iovec, max_batch_v> buffers;
+			std::array<sockaddr_storage, max_batch_v> addresses;
+
+			for (std::size_t i = 0; i < max_batch_v; ++i) {
+				buffers[i].iov_base = received_bytes.data() + i * NETCODE_MAX_PACKET_BYTES;
+				buffers[i].iov_len = NETCODE_MAX_PACKET_BYTES;
+
+				auto& h = headers[i];
+				std::memset(&h, 0, sizeof(h));
+
+				h.msg_hdr.msg_name = &addresses[i];
+				h.msg_hdr.msg_namelen = sizeof(sockaddr_storage);
+				h.msg_hdr.msg_iov = &buffers[i];
+				h.msg_hdr.msg_iovlen = 1;
+			}
+
+			const auto n = recvmmsg(socket.handle, headers.data(), max_batch_v, MSG_DONTWAIT, nullptr);
+
+			if (n <= 0) {
+				return 0;
+			}
+
+			for (int i = 0; i < n; ++i) {
+				received_from[i] = from_sockaddr(addresses[i]);
+				received_sizes[i] = static_cast<int>(headers[i].msg_len);
+			}
+
+			return static_cast<std::size_t>(n);
+		}
+#endif
+
+		std::size_t n = 0;
+
+		while (n < max_batch_v) {
+			const auto bytes = netcode_socket_receive_packet(
+				&socket,
+				&received_from[n],
+				received_bytes.data() + n * NETCODE_MAX_PACKET_BYTES,
+				NETCODE_MAX_PACKET_BYTES
+			);
+
+			if (bytes < 1) {
+				break;
+			}
+
+			received_sizes[n++] = bytes;
+		}
+
+		return n;
+	}
+
+	void netcode_socket_batch::send(
+		const std::size_t socket_index,
+		const netcode_address_t& to,
+		const void* const data,
+		const std::size_t num_bytes
+	) {
+		queued_send entry;
+		entry.socket_index = socket_index;
+		entry.to = to;
+		entry.offset = queued_bytes.size();
+		entry.size = num_bytes;
+
+		const auto bytes = reinterpret_cast<const std::byte*>(data);
+
+		queued_bytes.insert(queued_bytes.end(), bytes, bytes + num_bytes);
+		queued_sends.push_back(entry);
+	}
+
+	void netcode_socket_batch::flush_sends() {
+#if BATCHED_SOCKET_IO
+		std::array<mmsghdr, max_batch_v> headers;
+		std::array<iovec, max_batch_v> buffers;
+		std::array<sockaddr_storage, max_batch_v> addresses;
+
+		std::size_t first = 0;
+
+		while (first < queued_sends.size()) {
+			/* sendmmsg takes a single socket, so batch the consecutive sends of the same one. */
+
+			const auto socket_index = queued_sends[first].socket_index;
+			std::size_t n = 0;
+
+			while (
+				n < max_batch_v
+				&& first + n < queued_sends.size()
+				&& queued_sends[first + n].socket_index == socket_index
+			) {
+				const auto& entry = queued_sends[first + n];
+
+				buffers[n].iov_base = queued_bytes.data() + entry.offset;
+				buffers[n].iov_len = entry.size;
+
+				auto& h = headers[n];
+				std::memset(&h, 0, sizeof(h));
+
+				h.msg_hdr.msg_name = &addresses[n];
+				h.msg_hdr.msg_namelen = to_sockaddr(entry.to, addresses[n]);
+				h.msg_hdr.msg_iov = &buffers[n];
+				h.msg_hdr.msg_iovlen = 1;
+
+				++n;
+			}
+
+			const auto handle = sockets[socket_index]->handle;
+			std::size_t sent = 0;
+
+			while (sent < n) {
+				const auto result = sendmmsg(handle, headers.data() + sent, static_cast<unsigned>(n - sent), 0);
+
+				if (result <= 0) {
+					/* Datagrams can be dropped anyway, so don't retry. */
+					break;
+				}
+
+				sent += static_cast<std::size_t>(result);
+			}
+
+			first += n;
+		}
+#else
+		for (auto& entry : queued_sends) {
+			netcode_socket_send_packet(
+				sockets[entry.socket_index],
+				&entry.to,
+				queued_bytes.data() + entry.offset,
+				static_cast<int>(entry.size)
+			);
+		}
+#endif
+
+		queued_sends.clear();
+		queued_bytes.clear();
+	}
+}
@@ -0,0 +1,107 @@
+#pragma once
+#include <vector>
+#include <cstddef>
+#include "augs/network/netcode_sockets.h"
+
+#if PLATFORM_UNIX && defined(__linux__)
+#define BATCHED_SOCKET_IO 1
+#else
+#define BATCHED_SOCKET_IO 0
+#endif
+
+namespace augs {
+	/*
+		Waits on many netcode sockets at once,
+		and receives and sends their datagrams in batches.
+
+		With BATCHED_SOCKET_IO, the sockets are waited on with epoll
+		and drained with recvmmsg, while the queued datagrams are sent with sendmmsg,
+		so that a single system call handles up to max_batch_v datagrams.
+
+		Elsewhere, every socket is polled with netcode_socket_receive_packet
+		and waiting only sleeps if the previous pass received nothing.
+	*/
+
+	class netcode_socket_batch {
+	public:
+		static constexpr std::size_t max_batch_v = 64;
+
+		/* So that a flooded socket cannot starve the others. */
+		static constexpr std::size_t max_batches_per_socket_v = 16;
+
+	private:
+		struct queued_send {
+			std::size_t socket_index = 0;
+			netcode_address_t to;
+			std::size_t offset = 0;
+			std::size_t size = 0;
+		};
+
+		std::vector<netcode_socket_t*> sockets;
+		std::vector<std::size_t> ready;
+
+		std::vector<queued_send> queued_sends;
+		std::vector<std::byte> queued_bytes;
+
+		std::vector<std::byte> received_bytes;
+		std::vector<netcode_address_t> received_from;
+		std::vector<int> received_sizes;
+
+		bool received_anything = true;
+
+#if BATCHED_SOCKET_IO
+		int epoll_handle = -1;
+#endif
+
+		std::size_t receive_batch(std::size_t socket_index);
+
+	public:
+		explicit netcode_socket_batch(const std::vector<netcode_socket_t*>& sockets);
+		~netcode_socket_batch();
+
+		netcode_socket_batch(const netcode_socket_batch&) = delete;
+		netcode_socket_batch& operator=(const netcode_socket_batch&) = delete;
+
+		/* Blocks until any of the sockets can be read from or the timeout passes. */
+		void wait(double timeout_secs);
+
+		/*
+			Receives the datagrams of all sockets that were ready after the last wait,
+			calling callback(socket_index, from, bytes, num_bytes) for each.
+			Returns the number of datagrams received.
+		*/
+
+		template <class F>
+		std::size_t receive(F&& callback) {
+			std::size_t total = 0;
+
+			for (const auto socket_index : ready) {
+				for (std::size_t b = 0; b < max_batches_per_socket_v; ++b) {
+					const auto n = receive_batch(socket_index);
+
+					for (std::size_t i = 0; i < n; ++i) {
+						callback(
+							socket_index,
+							received_from[i],
+							received_bytes.data() + i * NETCODE_MAX_PACKET_BYTES,
+							received_sizes[i]
+						);
+					}
+
+					total += n;
+
+					if (n < max_batch_v) {
+						break;
+					}
+				}
+			}
+
+			received_anything = total > 0;
+			return total;
+		}
+
+		/* The datagram is copied and sent with the next flush_sends. */
+		void send(std::size_t socket_index, const netcode_address_t& to, const void* data, std::size_t num_bytes);
+		void flush_sends();
+	};
+}
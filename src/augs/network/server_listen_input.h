@@ -15,6 +15,9 @@ namespace augs {
 	struct dedicated_server_input {
 		// GEN INTROSPECTOR struct augs::dedicated_server_input
 		bool dummy = false;
+
+		/* Additional arenas are hosted by the same process at consecutive ports. */
+		unsigned num_arenas = 1;
 		// END GEN INTROSPECTOR
 	};
 }
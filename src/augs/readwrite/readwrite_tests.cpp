@@ -10,6 +10,8 @@
 
 #include "augs/string/string_templates.h"
 #include "augs/readwrite/readwrite_test_cycle.h"
+#include "augs/readwrite/crc32_stream.h"
+#include "3rdparty/crc32/crc32.h"
 
 #include "augs/math/vec2.h"
 #include "augs/math/transform.h"
@@ -256,6 +258,34 @@ TEST_CASE("Byte readwrite Pointers") {
 	readwrite_test_cycle(abcde);
 }
 
+TEST_CASE("Byte readwrite Crc32Stream") {
+	std::vector<std::vector<int>> abc;
+	abc.resize(5);
+
+	for (std::size_t i = 0; i < abc.size(); ++i) {
+		for (std::size_t j = 0; j < i * 7 + 3; ++j) {
+			abc[i].push_back(static_cast<int>(i * 1000 + j));
+		}
+	}
+
+	augs::memory_stream ss;
+	augs::write_bytes(ss, abc);
+
+	augs::crc32_stream crc;
+	augs::write_bytes(crc, abc);
+
+	REQUIRE(crc.get_hash() == crc32buf(reinterpret_cast<const char*>(ss.data()), ss.get_write_pos()));
+
+	for (std::size_t len = 0; len < 20; ++len) {
+		const auto bytes = reinterpret_cast<const std::byte*>(abc[4].data());
+
+		augs::crc32_stream partial;
+		partial.write(bytes, len);
+
+		REQUIRE(partial.get_hash() == crc32buf(reinterpret_cast<const char*>(bytes), len));
+	}
+}
+
 TEST_CASE("Lua readwrite General") {
 	auto lua = augs::create_lua_state();
 	
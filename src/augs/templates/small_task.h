@@ -0,0 +1,141 @@
+#pragma once
+#include <new>
+#include <cstddef>
+#include <cstring>
+#include <utility>
+#include <type_traits>
+
+namespace augs {
+	/*
+		A move-only void() callable that stores the callable inline
+		if it fits in inline_capacity bytes - which is the case for lambdas capturing
+		a handful of references and small values - so posting it to the thread_pool
+		does not touch the heap.
+
+		Larger callables are still accepted, but are allocated on the heap.
+	*/
+
+	template <std::size_t inline_capacity>
+	class small_task {
+		using storage_type = std::aligned_storage_t<inline_capacity, alignof(std::max_align_t)>;
+
+		/*
+			Null move_to means that the stored bytes can simply be copied,
+			null destroy means that there is nothing to destroy.
+			This is the case for most lambdas, as they capture references and plain values.
+		*/
+
+		struct vtable {
+			void (*call)(void*);
+			void (*move_to)(void* from, void* to);
+			void (*destroy)(void*);
+		};
+
+		template <class F>
+		static constexpr bool fits_inline_v =
+			sizeof(F) <= inline_capacity
+			&& alignof(F) <= alignof(std::max_align_t)
+			&& std::is_nothrow_move_constructible_v<F>
+		;
+
+		template <class F>
+		static constexpr vtable inline_vtable_v = {
+			[](void* s) { (*reinterpret_cast<F*>(s))(); },
+
+			std::is_trivially_copyable_v<F> ? nullptr : +[](void* from, void* to) {
+				auto& f = *reinterpret_cast<F*>(from);
+				new (to) F(std::move(f));
+				f.~F();
+			},
+
+			std::is_trivially_destructible_v<F> ? nullptr : +[](void* s) { 
+				reinterpret_cast<F*>(s)->~F(); 
+			}
+		};
+
+		template <class F>
+		static constexpr vtable heap_vtable_v = {
+			[](void* s) { (**reinterpret_cast<F**>(s))(); },
+			nullptr,
+			[](void* s) { delete *reinterpret_cast<F**>(s); }
+		};
+
+		void move_from(small_task& b) {
+			if (b.vt != nullptr) {
+				if (b.vt->move_to != nullptr) {
+					b.vt->move_to(&b.storage, &storage);
+				}
+				else {
+					std::memcpy(&storage, &b.storage, sizeof(storage_type));
+				}
+
+				vt = b.vt;
+				b.vt = nullptr;
+			}
+		}
+
+		storage_type storage;
+		const vtable* vt = nullptr;
+
+	public:
+		void reset() {
+			if (vt != nullptr) {
+				if (vt->destroy != nullptr) {
+					vt->destroy(&storage);
+				}
+
+				vt = nullptr;
+			}
+		}
+
+		small_task() = default;
+
+		template <
+			class F,
+			class = std::enable_if_t<!std::is_same_v<std::decay_t<F>, small_task>>
+		>
+		small_task(F&& f) {
+			using T = std::decay_t<F>;
+
+			if constexpr(fits_inline_v<T>) {
+				new (&storage) T(std::forward<F>(f));
+				vt = &inline_vtable_v<T>;
+			}
+			else {
+				new (&storage) T*(new T(std::forward<F>(f)));
+				vt = &heap_vtable_v<T>;
+			}
+		}
+
+		small_task(small_task&& b) noexcept {
+			move_from(b);
+		}
+
+		small_task& operator=(small_task&& b) noexcept {
+			if (this != &b) {
+				reset();
+				move_from(b);
+			}
+
+			return *this;
+		}
+
+		small_task(const small_task&) = delete;
+		small_task& operator=(const small_task&) = delete;
+
+		~small_task() {
+			reset();
+		}
+
+		void operator()() {
+			vt->call(&storage);
+		}
+
+		explicit operator bool() const {
+			return vt != nullptr;
+		}
+
+		template <class F>
+		static constexpr bool stored_inline_v = fits_inline_v<std::decay_t<F>>;
+	};
+}
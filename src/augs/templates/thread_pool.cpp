@@ -0,0 +1,101 @@
+#if BUILD_UNIT_TESTS
+#include <array>
+#include <atomic>
+#include <Catch/single_include/catch2/catch.hpp>
+#include "augs/templates/thread_pool.h"
+
+TEST_CASE("ThreadPool SmallTask") {
+	int calls = 0;
+
+	auto small = [&calls]() { ++calls; };
+
+	std::array<char, 256> big_capture = {};
+	big_capture[100] = 3;
+
+	auto big = [&calls, big_capture]() { calls += big_capture[100]; };
+
+	using task_type = augs::thread_pool::task_type;
+
+	static_assert(task_type::stored_inline_v<decltype(small)>);
+	static_assert(!task_type::stored_inline_v<decltype(big)>);
+
+	task_type a = small;
+	task_type b = big;
+
+	a();
+	b();
+
+	REQUIRE(calls == 4);
+
+	task_type moved = std::move(b);
+	REQUIRE(!b);
+
+	moved();
+	REQUIRE(calls == 7);
+}
+
+TEST_CASE("ThreadPool FrameBatch") {
+	for (const std::size_t num_workers : { 0u, 1u, 4u }) {
+		augs::thread_pool pool(num_workers);
+
+		std::atomic<int> sum = 0;
+
+		for (int frame = 0; frame < 10; ++frame) {
+			for (int i = 0; i < 100; ++i) {
+				pool.enqueue([&sum, i]() { sum += i; });
+			}
+
+			pool.submit();
+			pool.help_until_no_tasks();
+			pool.wait_for_all_tasks_to_complete();
+
+			REQUIRE(sum.load() == 4950 * (frame + 1));
+		}
+	}
+}
+
+TEST_CASE("ThreadPool IndependentGroups") {
+	augs::thread_pool pool(3);
+
+	std::atomic<int> first_done = 0;
+	std::atomic<int> second_done = 0;
+
+	augs::task_group first;
+	augs::task_group second;
+
+	for (int i = 0; i < 50; ++i) {
+		pool.run(first, [&first_done]() { ++first_done; });
+		pool.run(second, [&second_done]() { ++second_done; });
+	}
+
+	pool.wait(first);
+	REQUIRE(first_done.load() == 50);
+
+	pool.wait(second);
+	REQUIRE(second_done.load() == 50);
+}
+
+TEST_CASE("ThreadPool NestedParallelFor") {
+	for (const std::size_t num_workers : { 0u, 2u, 8u }) {
+		augs::thread_pool pool(num_workers);
+
+		std::atomic<std::size_t> total = 0;
+
+		pool.parallel_for(16, 1, [&](const std::size_t first, const std::size_t last) {
+			for (std::size_t outer = first; outer < last; ++outer) {
+				pool.parallel_for(1000, 64, [&](const std::size_t b, const std::size_t e) {
+					std::size_t local = 0;
+
+					for (std::size_t i = b; i < e; ++i) {
+						local += i;
+					}
+
+					total += local;
+				});
+			}
+		});
+
+		REQUIRE(total.load() == 16 * 499500);
+	}
+}
+#endif
@@ -1,66 +1,256 @@
 #pragma once
+#include <array>
 #include <vector>
 #include <thread>
 #include <mutex>
 #include <atomic>
+#include <algorithm>
 #include <condition_variable>
-#include <functional>
+
+#include "augs/ensure.h"
+#include "augs/templates/small_task.h"
 
 namespace augs {
+	/*
+		Counts the tasks of a single batch that are yet to complete.
+
+		Any number of groups may be in flight at once,
+		and waiting for one of them never waits for the others.
+	*/
+
+	class task_group {
+		friend class thread_pool;
+
+		std::atomic<std::size_t> pending = 0;
+
+	public:
+		task_group() = default;
+		task_group(const task_group&) = delete;
+		task_group& operator=(const task_group&) = delete;
+
+		~task_group() {
+			ensure(is_complete());
+		}
+
+		bool is_complete() const {
+			return pending.load(std::memory_order_acquire) == 0;
+		}
+	};
+
+	/*
+		A work-stealing scheduler.
+
+		Every worker owns a deque of tasks:
+		it pushes and pops at the back of its own deque,
+		and once it runs out of work, it steals from the front of the others.
+		Threads that are not workers of this pool - e.g. the main or the audio thread -
+		share one additional deque.
+		Each deque has its own lock, so posting rarely contends.
+
+		Tasks are stored in a small_task, so the typical lambda is posted without a heap allocation.
+
+		Waiting for a task_group executes other tasks in the meantime,
+		so tasks can themselves post and wait for nested tasks (see parallel_for)
+		without the risk of exhausting the workers.
+
+		enqueue, submit, help_until_no_tasks and wait_for_all_tasks_to_complete
+		post and wait for one implicit group - the batch of the current frame.
+	*/
+
 	class thread_pool {
-		std::vector<std::thread> workers;
-		std::vector<std::function<void()>> tasks;
-		std::vector<std::function<void()>> cold_tasks;
+	public:
+		static constexpr std::size_t max_workers_v = 64;
+		static constexpr std::size_t task_inline_capacity_v = 64;
+
+		using task_type = small_task<task_inline_capacity_v>;
+
+	private:
+		struct queued_task {
+			task_type fn;
+			task_group* group = nullptr;
+		};
+
+		/*
+			A ring buffer that keeps its capacity,
+			so that once it has grown, posting tasks never allocates.
+		*/
+
+		class task_deque {
+			std::vector<queued_task> ring;
+			std::size_t first = 0;
+			std::size_t count = 0;
+
+			auto& at(const std::size_t i) {
+				return ring[(first + i) & (ring.size() - 1)];
+			}
 
-		int tasks_completed = 0;
-		int tasks_posted = 0;
+			void grow() {
+				std::vector<queued_task> bigger(std::max(ring.size() * 2, std::size_t(64)));
 
-		std::mutex queue_mutex;
-		std::condition_variable cv;
+				for (std::size_t i = 0; i < count; ++i) {
+					bigger[i] = std::move(at(i));
+				}
+
+				ring = std::move(bigger);
+				first = 0;
+			}
+
+		public:
+			bool empty() const {
+				return count == 0;
+			}
+
+			void push_back(queued_task&& t) {
+				if (count == ring.size()) {
+					grow();
+				}
 
-		std::condition_variable completion_variable;
-		std::mutex completion_mutex;
+				at(count++) = std::move(t);
+			}
 
+			void pop_back(queued_task& out) {
+				out = std::move(at(--count));
+			}
+
+			void pop_front(queued_task& out) {
+				out = std::move(at(0));
+				first = (first + 1) & (ring.size() - 1);
+				--count;
+			}
+		};
+
+		struct alignas(64) task_queue {
+			std::mutex lock;
+			task_deque tasks;
+		};
+
+		/*
+			The deque at index 0 is shared by all threads that are not workers of this pool,
+			the deque at index i + 1 belongs to the i-th worker.
+
+			The deques are never reallocated,
+			so that a thread outside the pool may help it even while it is being resized.
+		*/
+
+		std::array<task_queue, max_workers_v + 1> queues;
+		std::atomic<std::size_t> num_queues = 1;
+
+		std::vector<std::thread> workers;
+		std::vector<queued_task> cold_tasks;
+
+		task_group submitted;
+
+		std::atomic<std::size_t> num_queued = 0;
+		std::atomic<std::size_t> num_sleeping = 0;
+
+		std::atomic<bool> any_submitted = false;
 		std::atomic<bool> shall_quit = false;
 
-		auto lock_queue() {
-			return std::unique_lock<std::mutex>(queue_mutex);
+		std::mutex sleep_mutex;
+		std::condition_variable wake_workers;
+		std::condition_variable wake_posted;
+
+		static inline thread_local const thread_pool* current_pool = nullptr;
+		static inline thread_local std::size_t current_queue = 0;
+
+		std::size_t own_queue_index() const {
+			return current_pool == this ? current_queue : 0;
+		}
+
+		void wake(const bool all) {
+			if (num_sleeping.load() > 0) {
+				std::scoped_lock lk(sleep_mutex);
+
+				if (all) {
+					wake_workers.notify_all();
+				}
+				else {
+					wake_workers.notify_one();
+				}
+			}
 		}
 
-		auto lock_completion() {
-			return std::unique_lock<std::mutex>(completion_mutex);
+		void push(task_type&& fn, task_group& group) {
+			group.pending.fetch_add(1, std::memory_order_relaxed);
+
+			{
+				auto& q = queues[own_queue_index()];
+
+				std::scoped_lock lk(q.lock);
+				q.tasks.push_back({ std::move(fn), std::addressof(group) });
+			}
+
+			num_queued.fetch_add(1);
+			wake(false);
 		}
 
-		void register_completion() {
+		bool try_pop(queued_task& out) {
+			if (num_queued.load() == 0) {
+				return false;
+			}
+
+			const auto own = own_queue_index();
+
 			{
-				auto lock = lock_completion();
-				++tasks_completed;
+				auto& q = queues[own];
+				std::scoped_lock lk(q.lock);
+
+				if (!q.tasks.empty()) {
+					q.tasks.pop_back(out);
+					num_queued.fetch_sub(1);
+
+					return true;
+				}
+			}
 
-				if (tasks_completed == tasks_posted) {
-					completion_variable.notify_all();
+			const auto n = num_queues.load();
+
+			for (std::size_t k = 1; k < n; ++k) {
+				auto& q = queues[(own + k) % n];
+				std::scoped_lock lk(q.lock);
+
+				if (!q.tasks.empty()) {
+					q.tasks.pop_front(out);
+					num_queued.fetch_sub(1);
+
+					return true;
 				}
 			}
+
+			return false;
 		}
 
-		auto make_continuous_worker() {
-			return [this] {
-				for (;;) {
-					std::function<void()> task;
+		static void execute(queued_task& t) {
+			t.fn();
 
-					{
-						auto lock = lock_queue();
-						cv.wait(lock, [this]{ return shall_quit || !tasks.empty(); });
+			/* Destroy the captures before the group may be considered complete. */
+			t.fn.reset();
 
-						if (shall_quit.load() && tasks.empty()) {
-							return;
-						}
+			t.group->pending.fetch_sub(1, std::memory_order_acq_rel);
+		}
+
+		auto make_continuous_worker(const std::size_t queue_index) {
+			return [this, queue_index] {
+				current_pool = this;
+				current_queue = queue_index;
+
+				for (;;) {
+					queued_task task;
 
-						task = std::move(tasks.back());
-						tasks.pop_back();
+					if (try_pop(task)) {
+						execute(task);
+						continue;
 					}
 
-					task();
-					register_completion();
+					std::unique_lock<std::mutex> lk(sleep_mutex);
+
+					num_sleeping.fetch_add(1);
+					wake_workers.wait(lk, [this]{ return shall_quit.load() || num_queued.load() > 0; });
+					num_sleeping.fetch_sub(1);
+
+					if (shall_quit.load() && num_queued.load() == 0) {
+						return;
+					}
 				}
 			};
 		}
@@ -76,8 +266,12 @@ namespace augs {
 				return;
 			}
 
-			shall_quit.store(true);
-			cv.notify_all();
+			{
+				std::scoped_lock lk(sleep_mutex);
+				shall_quit.store(true);
+			}
+
+			wake_workers.notify_all();
 			join_all();
 			workers.clear();
 		}
@@ -91,71 +285,124 @@ namespace augs {
 			quit_all_workers();
 		}
 
-		void resize(const std::size_t num_workers) {
+		void resize(std::size_t num_workers) {
 			quit_all_workers();
 			shall_quit.store(false);
 
+			num_workers = std::min(num_workers, max_workers_v);
+			num_queues.store(num_workers + 1);
+
 			for (std::size_t i = 0; i < num_workers; ++i) {
-				workers.emplace_back(make_continuous_worker());
+				workers.emplace_back(make_continuous_worker(i + 1));
 			}
 		}
 
+		std::size_t size() const {
+			return workers.size();
+		}
+
+		/* Posts a task immediately. */
+
+		template <class F>
+		void run(task_group& group, F&& f) {
+			push(task_type(std::forward<F>(f)), group);
+		}
+
+		/* Executes the posted tasks until all tasks of the group are complete. */
+
+		void wait(task_group& group) {
+			while (!group.is_complete()) {
+				queued_task task;
+
+				if (try_pop(task)) {
+					execute(task);
+				}
+				else {
+					std::this_thread::yield();
+				}
+			}
+		}
+
+		/*
+			Calls f(first, last) for consecutive ranges of at most grain indices,
+			covering [0, count), and returns once all of them have completed.
+			The calling thread executes the first range itself.
+
+			Can be called from within another task.
+		*/
+
+		template <class F>
+		void parallel_for(const std::size_t count, std::size_t grain, F&& f) {
+			if (count == 0) {
+				return;
+			}
+
+			grain = std::max(grain, std::size_t(1));
+
+			task_group group;
+
+			for (std::size_t first = grain; first < count; first += grain) {
+				const auto last = std::min(first + grain, count);
+
+				run(group, [&f, first, last]() { f(first, last); });
+			}
+
+			f(std::size_t(0), std::min(grain, count));
+
+			wait(group);
+		}
+
+		/* Stores a task of the frame batch, to be posted with submit. */
+
 		template <class F>
 		void enqueue(F&& f) {
-			cold_tasks.emplace_back(std::move(f));
+			cold_tasks.push_back({ task_type(std::forward<F>(f)), std::addressof(submitted) });
 		}
 
+		/* Posts all enqueued tasks, spreading them evenly across the deques. */
+
 		void submit() {
-			{
-				auto lock = lock_queue();
-				ensure(tasks.empty());
-				std::swap(cold_tasks, tasks);
-
-				{
-					auto lock = lock_completion();
-					tasks_completed = 0;
-					tasks_posted = tasks.size();
+			const auto total = cold_tasks.size();
+			const auto n = num_queues.load();
+
+			submitted.pending.fetch_add(total, std::memory_order_relaxed);
+
+			for (std::size_t i = 0; i < std::min(n, total); ++i) {
+				auto& q = queues[i];
+				std::scoped_lock lk(q.lock);
+
+				for (std::size_t j = i; j < total; j += n) {
+					q.tasks.push_back(std::move(cold_tasks[j]));
 				}
 			}
 
+			num_queued.fetch_add(total);
 			cold_tasks.clear();
-			completion_variable.notify_all();
-			cv.notify_all();
-		}
 
-		std::size_t size() const {
-			return workers.size();
+			{
+				std::scoped_lock lk(sleep_mutex);
+				any_submitted.store(true);
+			}
+
+			wake_posted.notify_all();
+			wake(true);
 		}
 
 		void sleep_until_tasks_posted() {
-			auto lock = lock_completion();
-			completion_variable.wait(lock, [this]{ return tasks_posted > 0; });
+			std::unique_lock<std::mutex> lk(sleep_mutex);
+			wake_posted.wait(lk, [this]{ return any_submitted.load(); });
 		}
 
 		void help_until_no_tasks() {
-			for (;;) {
-				std::function<void()> task;
-
-				{
-					auto lock = lock_queue();
-
-					if (tasks.empty()) {
-						return;
-					}
-
-					task = std::move(tasks.back());
-					tasks.pop_back();
-				}
+			queued_task task;
 
-				task();
-				register_completion();
+			while (try_pop(task)) {
+				execute(task);
 			}
 		}
 
 		void wait_for_all_tasks_to_complete() {
-			auto lock = lock_completion();
-			completion_variable.wait(lock, [this]{ return tasks_posted == tasks_completed; });
+			wait(submitted);
 		}
 	};
 }
-
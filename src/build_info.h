@@ -81,6 +81,21 @@ Options:
                                 Contrary to the --dedicated-server option, this lets you play on your own server within the same game instance.
     --dedicated-server          The same as --server, but applies some settings suitable for a dedicated server instance.
                                 For example - the game will be started without a window.
+    --relay                     Connect to the server specified with --connect (or spectator_relay.upstream inside the config file) as a spectator
+                                and rebroadcast the game to other spectators, in accordance with spectator_relay inside the config file.
+    --load-test N               Connect N headless clients that play at random to the server specified with --connect
+                                (or load_test_swarm.target inside the config file) and report the load of the server.
+                                If N is 0, load_test_swarm.num_clients from the config file is used.
+    --test-spectator-relay N    Start a server, a relay and a client connected to the relay on free loopback ports
+                                and fail unless the client matches the server at N steps within 20 seconds.
+    --benchmark-masterserver N  Run a masterserver on the loopback interface, flood it with heartbeats from N fake gameservers
+                                and report how many heartbeats it processes per second.
+    --benchmark-visibility N    Calculate the visibility of every light and character in the test scene N times with each visibility engine,
+                                report their timings and fail if they disagree.
+    --benchmark-sprite-vertices N  Write the vertices of every sprite in the test scene N times as triangles and as indexed quads,
+                                report the bytes generated per frame and the timings, and fail if the two formats disagree.
+    --benchmark-reprediction-copy N  Play N recorded steps of a firefight in the test scene, reassigning the predicted cosmos after each,
+                                report the time of copying only the dirty entities versus the whole solvable, and fail if the copies disagree.
 
 If editor_file_path is supplied and it is a directory,
 the game will automatically launch the editor to try and open the project inside it, if there is one. 
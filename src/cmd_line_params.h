@@ -2,6 +2,7 @@
 #include "augs/filesystem/path.h"
 #include "augs/app_type.h"
 #include "augs/network/network_types.h"
+#include "augs/string/string_templates.h"
 
 struct cmd_line_params {
 	augs::path_type exe_path;
@@ -16,6 +17,13 @@ struct cmd_line_params {
 	bool upgraded_successfully = false;
 	bool should_connect = false;
 	int test_fp_consistency = -1;
+	/* What follows "--benchmark-", e.g. "visibility". work.cpp maps it to the benchmark to run. */
+	std::string benchmark;
+	int benchmark_amount = -1;
+	std::string measure_demo_steps;
+	int test_authoritative_solve = -1;
+	int test_spectator_relay = -1;
+	int load_test_clients = -1;
 	std::string connect_address;
 
 	bool disallow_nat_traversal = false;
@@ -56,9 +64,28 @@ struct cmd_line_params {
 			else if (a == "--masterserver") {
 				type = app_type::MASTERSERVER;
 			}
+			else if (a == "--relay") {
+				type = app_type::SPECTATOR_RELAY;
+			}
 			else if (a == "--test-fp-consistency") {
 				test_fp_consistency = std::atoi(argv[i++]);
 			}
+			else if (begins_with(a, "--benchmark-")) {
+				benchmark = a.substr(std::string("--benchmark-").length());
+				benchmark_amount = std::atoi(argv[i++]);
+			}
+			else if (a == "--measure-demo-steps") {
+				measure_demo_steps = argv[i++];
+			}
+			else if (a == "--test-authoritative-solve") {
+				test_authoritative_solve = std::atoi(argv[i++]);
+			}
+			else if (a == "--test-spectator-relay") {
+				test_spectator_relay = std::atoi(argv[i++]);
+			}
+			else if (a == "--load-test") {
+				load_test_clients = std::atoi(argv[i++]);
+			}
 			else if (a == "--nat-punch-port") {
 				first_udp_command_port = std::atoi(argv[i++]);
 			}
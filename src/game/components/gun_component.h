@@ -121,7 +121,7 @@ namespace invariants {
 		bool allow_chambering_with_akimbo = false;
 		bool allow_charge_in_chamber_magazine_when_chamber_loaded = true;
 		bool delay_shell_spawn_until_chambering = false;
-		pad_bytes<1> pad;
+		bool fires_lightweight_projectiles = false;
 
 		constrained_entity_flavour_id<invariants::missile, components::sender> magic_missile_flavour;
 		recoil_player_instance_def recoil;
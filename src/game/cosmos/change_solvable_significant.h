@@ -14,5 +14,6 @@ void cosmic::change_solvable_significant(C& cosm, F&& callback) {
 		}
 	});
 
+	cosm.invalidate_dirty_tracking();
 	status = callback(cosm.get_solvable({}).significant);
 }
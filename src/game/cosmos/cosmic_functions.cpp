@@ -68,6 +68,7 @@ void cosmic::set_specific_name(const entity_handle& handle, const entity_name_st
 }
 
 void cosmic::clear(cosmos& cosm) {
+	cosm.invalidate_dirty_tracking();
 	cosm.get_solvable({}).clear();
 	
 	cosm.change_common_significant([&](cosmos_common_significant& c) {
@@ -152,6 +153,7 @@ void cosmic::infer_all_entities(cosmos& in) {
 }
 
 void cosmic::reserve_storage_for_entities(cosmos& cosm, const cosmic_pool_size_type s) {
+	cosm.invalidate_dirty_tracking();
 	cosm.get_solvable({}).reserve_storage_for_entities(s);
 }
 
@@ -330,14 +332,13 @@ ref_typed_entity_handle<entity_type> cosmic::specific_clone_entity(const ref_typ
 	auto& cosm = in_entity.get_cosmos();
 
 	return cosmic::specific_create_entity(cosm, source_entity.get_flavour_id(), [&](const auto new_entity, auto&&...) {
-		const auto& source_components = source_entity.get({}).component_state;
-		auto& new_solvable = new_entity.get({});
-		auto& new_components = new_solvable.component_state;
-
 		/* Initial copy-assignment */
-		new_components = source_components; 
+		source_entity.for_each_component([&](const auto& source_component) {
+			using T = remove_cref<decltype(source_component)>;
+			new_entity.template get_raw_component<T>({}) = source_component;
+		});
 
-		cosmic::make_suitable_for_cloning(new_solvable);
+		cosmic::make_suitable_for_cloning(new_entity);
 
 		if (const auto slot = source_entity.get_current_slot()) {
 			if (const auto source_transform = source_entity.find_logic_transform()) {
@@ -76,6 +76,9 @@ public:
 	template <class E>
 	static void make_suitable_for_cloning(entity_solvable<E>& solvable);
 
+	template <class E>
+	static void make_suitable_for_cloning(ref_typed_entity_handle<E> handle);
+
 	template <class entity_type>
 	static ref_typed_entity_handle<entity_type> specific_clone_entity(ref_typed_entity_handle<entity_type> source_entity);
 
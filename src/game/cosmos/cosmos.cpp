@@ -1,11 +1,9 @@
 #include "augs/ensure_rel.h"
-#include "3rdparty/crc32/crc32.h"
-
-#include "augs/readwrite/memory_stream.h"
 
 #include "augs/misc/randomization.h"
 
 #include "game/cosmos/cosmos.h"
+#include "game/cosmos/solvable_hash.h"
 #include "game/cosmos/entity_handle.h"
 #include "game/cosmos/create_entity.hpp"
 #include "game/cosmos/change_common_significant.hpp"
@@ -13,12 +11,17 @@
 
 #include "augs/readwrite/lua_readwrite.h"
 #include "augs/readwrite/byte_readwrite.h"
+#include "augs/readwrite/to_bytes.h"
 
 #include "game/cosmos/for_each_entity.h"
 
 #include <atomic>
 
 std::atomic<int> cosmos_counter = 0;
+std::atomic<dirty_tracking_token> dirty_tracking_counter = 0;
+
+/* Catches component writes that bypass entity handles and thus the dirty tracking. */
+#define VERIFY_DIRTY_TRACKED_ASSIGNMENT !IS_PRODUCTION_BUILD
 
 void cosmos::request_resample() {
 	resample = true;
@@ -50,6 +53,8 @@ cosmos& cosmos::operator=(const cosmos& b) {
 	solvable = b.solvable;
 	profiler = b.profiler;
 
+	invalidate_dirty_tracking();
+
 	cosmic::after_solvable_copy(*this, b);
 	return *this;
 }
@@ -59,23 +64,7 @@ const cosmos cosmos::zero = {};
 template <class T>
 T cosmos::calculate_solvable_signi_hash() const {
 	if constexpr(std::is_same_v<T, uint32_t>) {
-		augs::memory_stream ss;
-
-		augs::write_bytes(ss, get_clock().now);
-		augs::write_bytes(ss, get_entities_count());
-
-		for_each_having<components::sentience>(
-			[&](const auto& it) {
-				const auto& b = it.template get<components::rigid_body>();
-				const auto& c = b.get_raw_component().physics_transforms.m_xf;
-				const auto& s = it.template get<components::sentience>();
-
-				augs::write_bytes(ss, c);
-				augs::write_bytes(ss, s.meters);
-			}
-		);
-
-		return crc32buf(reinterpret_cast<char*>(ss.data()), ss.get_write_pos());
+		return calculate_solvable_hash(*this);
 	}
 	else {
 		static_assert(always_false_v<T>, "Unsupported hash type.");
@@ -142,6 +131,20 @@ void cosmos::set(const cosmos_solvable_significant& new_signi) {
 	});
 }
 
+bool cosmos::share_common_significant_if_equal(const cosmos& b) {
+	if (shares_common_significant_with(b)) {
+		return true;
+	}
+
+	if (augs::to_bytes(get_common_significant()) != augs::to_bytes(b.get_common_significant())) {
+		return false;
+	}
+
+	/* The contents are the same, so nothing inferred from them has to change. */
+	common.share_significant_of(b.common);
+	return true;
+}
+
 void cosmos::reinfer_everything() {
 	common.reinfer();
 	cosmic::reinfer_solvable(*this);
@@ -158,7 +161,53 @@ void cosmos::set_fixed_delta(const augs::delta& dt) {
 }
 
 void cosmos::assign_solvable(const cosmos& b) {
-	solvable = b.solvable;
+	if (dirty_entity_tracker::synchronized_with_each_other(dirty_entities, b.dirty_entities)) {
+		solvable.assign_modified_from(b.solvable, dirty_entities, b.dirty_entities);
+
+#if VERIFY_DIRTY_TRACKED_ASSIGNMENT
+		ensure_eq(calculate_solvable_hash(b), calculate_solvable_hash(*this));
+#endif
+	}
+	else {
+		solvable = b.solvable;
+		invalidate_dirty_tracking();
+	}
 
 	cosmic::after_solvable_copy(*this, b);
+
+	const auto token = ++dirty_tracking_counter;
+	const auto& significant = get_solvable().significant;
+
+	dirty_entities.synchronize(token, significant);
+	b.dirty_entities.synchronize(token, significant);
+}
+
+#if BUILD_UNIT_TESTS
+#include <Catch/single_include/catch2/catch.hpp>
+#include <memory>
+
+TEST_CASE("Cosmos SharedCommonSignificant") {
+	auto a = std::make_unique<cosmos>();
+	auto b = std::make_unique<cosmos>(*a);
+
+	REQUIRE(b->shares_common_significant_with(*a));
+
+	a->change_common_significant([](cosmos_common_significant& common) {
+		common.ambient_light_color = rgba(1, 2, 3, 4);
+		return changer_callback_result::DONT_REFRESH;
+	});
+
+	REQUIRE(!b->shares_common_significant_with(*a));
+	REQUIRE(b->get_common_significant().ambient_light_color != a->get_common_significant().ambient_light_color);
+
+	REQUIRE(!b->share_common_significant_if_equal(*a));
+
+	b->change_common_significant([](cosmos_common_significant& common) {
+		common.ambient_light_color = rgba(1, 2, 3, 4);
+		return changer_callback_result::DONT_REFRESH;
+	});
+
+	REQUIRE(b->share_common_significant_if_equal(*a));
+	REQUIRE(b->shares_common_significant_with(*a));
 }
+#endif
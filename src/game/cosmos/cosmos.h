@@ -8,13 +8,13 @@
 #include "game/cosmos/cosmic_profiler.h"
 #include "game/cosmos/cosmos_common_significant_access.h"
 #include "game/cosmos/private_cosmos_solvable.h"
+#include "game/cosmos/dirty_entity_tracker.h"
 #include "game/cosmos/entity_id.h"
 #include "game/cosmos/handle_getters_declaration.h"
+#include "game/cosmos/cosmos_id_type.h"
 
 #include "game/enums/processing_subjects.h"
 
-using cosmos_id_type = int;
-
 class cosmos {
 	template <class C, class F>
 	static void for_each_in_impl(C& self, const processing_subjects f, F callback) {
@@ -26,6 +26,9 @@ class cosmos {
 	cosmos_common common;
 	private_cosmos_solvable solvable;
 
+	/* Mutable, because the source of assign_solvable is synchronized as well. */
+	mutable dirty_entity_tracker dirty_entities;
+
 	cosmos_id_type cosmos_id = 0;
 	mutable bool resample = true;
 
@@ -71,15 +74,26 @@ public:
 	std::string summary() const;
 
 	const cosmos_common_significant& get_common_significant() const {
-		return common.significant;
+		return common.get_significant();
 	}
 
 	cosmos_common_significant& get_common_significant(cosmos_common_significant_access) {
-		return common.significant;
+		return common.get_significant_for_writing();
 	}
 
 	const cosmos_common_significant& get_common_significant(cosmos_common_significant_access) const {
-		return common.significant;
+		return common.get_significant();
+	}
+
+	/*
+		If the common significant state of both cosmoi is equal,
+		makes this cosmos share the one of the other, so that only one copy stays in memory.
+	*/
+
+	bool share_common_significant_if_equal(const cosmos& other);
+
+	bool shares_common_significant_with(const cosmos& other) const {
+		return common.shares_significant_with(other.common);
 	}
 
 	const common_assets& get_common_assets() const {
@@ -306,8 +320,32 @@ public:
 
 	void set_fixed_delta(const augs::delta& dt);
 
+	/*
+		Copies the solvable from b.
+		If the two cosmoses were last synchronized with each other through this very function,
+		only the entities that were modified in either of them since then are copied.
+	*/
+
 	void assign_solvable(const cosmos& b);
 
+	void mark_modified(const entity_id id) {
+		dirty_entities.mark(id);
+	}
+
+	/* Must be called whenever the solvable is changed without going through entity handles. */
+	void invalidate_dirty_tracking() {
+		dirty_entities.invalidate();
+	}
+
+	const auto& get_dirty_entities() const {
+		return dirty_entities;
+	}
+
+	/* Called by solvable_hash_tree::update. Returns the generation of the tracking that the tree should remember. */
+	uint64_t clear_unhashed_entities() const {
+		return dirty_entities.clear_unhashed(get_solvable().significant);
+	}
+
 	template <class T>
 	T calculate_solvable_signi_hash() const;
 
@@ -1,8 +1,38 @@
 #pragma once
+#include <memory>
 #include "game/cosmos/cosmos_common_significant.h"
 
-struct cosmos_common {
-	cosmos_common_significant significant;
+/*
+	The significant state is read-only and shared between the copies of a cosmos,
+	and between cosmoi loaded from the same map, e.g. the arenas hosted by a single server process.
+	It is copied only when a cosmos that shares it is about to write to it.
+*/
+
+class cosmos_common {
+	std::shared_ptr<const cosmos_common_significant> significant = std::make_shared<cosmos_common_significant>();
+
+public:
+	const cosmos_common_significant& get_significant() const {
+		return *significant;
+	}
+
+	/* Never keep the result across a copy of the owning cosmos, as the copy will share it again. */
+	cosmos_common_significant& get_significant_for_writing() {
+		if (significant.use_count() > 1) {
+			significant = std::make_shared<cosmos_common_significant>(*significant);
+		}
+
+		/* Every instance is allocated as non-const, so this is well-defined. */
+		return const_cast<cosmos_common_significant&>(*significant);
+	}
+
+	void share_significant_of(const cosmos_common& b) {
+		significant = b.significant;
+	}
+
+	bool shares_significant_with(const cosmos_common& b) const {
+		return significant == b.significant;
+	}
 
 	void reinfer();
 };
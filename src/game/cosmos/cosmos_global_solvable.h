@@ -1,5 +1,6 @@
 #pragma once
 #include "game/detail/inventory/item_mounting.h"
+#include "game/detail/missile/lightweight_projectile.h"
 #include "game/cosmos/step_declaration.h"
 
 struct cosmos_global_solvable {
@@ -7,6 +8,14 @@ struct cosmos_global_solvable {
 	pending_item_mounts_type pending_item_mounts;
 	// END GEN INTROSPECTOR
 
+	/*
+		Not introspected, so that the .solv files saved before it existed stay loadable.
+		Rounds only live for a fraction of a second, so no arena is ever saved with any.
+		The network state, the clones and the solvable hash handle it explicitly.
+	*/
+
+	lightweight_projectiles_type lightweight_projectiles;
+
 	void solve_item_mounting(logic_step);
 	void clear();
 };
@@ -0,0 +1,3 @@
+#pragma once
+
+using cosmos_id_type = int;
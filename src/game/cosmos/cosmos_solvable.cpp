@@ -6,6 +6,8 @@
 #include "game/cosmos/on_entity_meta.h"
 #include "augs/templates/introspection_utils/rewrite_members.h"
 #include "augs/misc/pool/pool_allocate.h"
+#include "game/cosmos/dirty_entity_tracker.h"
+#include "game/organization/for_each_entity_type.h"
 
 const cosmos_solvable cosmos_solvable::zero;
 
@@ -69,6 +71,43 @@ void cosmos_solvable::destroy_all_caches() {
 	new (&inferred) cosmos_solvable_inferred;
 }
 
+void cosmos_solvable::assign_modified_from(
+	const cosmos_solvable& b,
+	dirty_entity_tracker& this_dirty,
+	const dirty_entity_tracker& b_dirty
+) {
+	significant.clk = b.significant.clk;
+	significant.specific_names = b.significant.specific_names;
+	significant.global = b.significant.global;
+
+	for_each_entity_type([&](auto e) {
+		using E = decltype(e);
+
+		auto& target = significant.get_pool<E>();
+		const auto& source = b.significant.get_pool<E>();
+
+		const auto type = entity_type_id::of<E>();
+
+		if (
+			!target.layout_equal(source) 
+			|| dirty_entity_tracker::whole_pool_dirty(this_dirty, b_dirty, type)
+		) {
+			target = source;
+			this_dirty.mark_whole_pool_unhashed(type);
+			return;
+		}
+
+		target.assign_objects_from(source, [&](auto copy_object) {
+			dirty_entity_tracker::for_each_dirty_in_either(this_dirty, b_dirty, type, [&](const std::size_t i) {
+				copy_object(i);
+				this_dirty.mark_unhashed(type, i);
+			});
+		});
+	});
+
+	inferred = b.inferred;
+}
+
 void cosmos_solvable::increment_step() {
 	++significant.clk.now.step;
 }
@@ -112,3 +151,232 @@ std::optional<cosmic_pool_undo_free_input> cosmos_solvable::free_entity(const en
 void cosmos_solvable::undo_last_allocate_entity(const entity_id id) {
 	return significant.on_pool(id.type_id, [id](auto& p){ return p.undo_last_allocate(id.raw); });
 }
+
+#if BUILD_UNIT_TESTS && BUILD_TEST_SCENES
+#include <Catch/single_include/catch2/catch.hpp>
+#include "augs/misc/lua/lua_utils.h"
+#include <sol2/sol.hpp>
+#include "game/cosmos/solvable_hash.h"
+#include "game/cosmos/just_create_entity.h"
+#include "game/cosmos/solvers/standard_solver.h"
+#include "game/modes/test_mode.h"
+#include "test_scenes/test_scene_settings.h"
+#include "test_scenes/create_test_scene_entity.h"
+#include "application/intercosm.h"
+#include "application/authoritative_solve_test.h"
+#include "game/cosmos/cosmic_functions.h"
+#include "game/cosmos/entity_handle.h"
+#include "game/cosmos/for_each_entity.h"
+#include "augs/readwrite/to_bytes.h"
+
+TEST_CASE("CosmosSolvable DirtyTrackedAssignmentMatchesFullCopy") {
+	auto lua = augs::create_lua_state();
+
+	auto scene = std::make_unique<intercosm>();
+	auto ruleset = test_mode_ruleset();
+
+	scene->make_test_scene(lua, { false, 60 }, ruleset);
+
+	auto& referential = scene->world;
+	const auto predicted = std::make_unique<cosmos>(referential);
+
+	const auto steps = 120u;
+	const auto recorded = record_test_scene_match(referential, steps);
+
+	auto advance = [](cosmos& cosm, cosmic_entropy entropy) {
+		entropy.clear_dead_entities(cosm);
+		standard_solver()({ cosm, entropy, solve_settings() }, solver_callbacks());
+	};
+
+	auto wall_pos = [](const unsigned i) {
+		return vec2(-2000.f + 40.f * i, 3000.f);
+	};
+
+	std::vector<entity_id> walls;
+	unsigned partial_assignments = 0;
+
+	for (unsigned i = 0; i < steps; ++i) {
+		advance(referential, recorded[i]);
+
+		/* Creation, component writes, cloning, deletion and undone deletion in the referential cosmos */
+
+		if (walls.empty() || i % 4 == 0) {
+			walls.push_back(create_test_scene_entity(referential, test_plain_sprited_bodies::BRICK_WALL, wall_pos(i)).get_id());
+		}
+		else if (i % 4 == 1) {
+			referential[walls.back()].set_logic_transform(transformr(wall_pos(i), 45.f));
+		}
+		else if (i % 4 == 2) {
+			walls.push_back(just_clone_entity(referential[walls.back()]).get_id());
+		}
+		else {
+			cosmic::delete_entity(referential[walls.front()]);
+			walls.erase(walls.begin());
+
+			if (!walls.empty()) {
+				referential[walls.front()].dispatch([&](const auto typed_handle) {
+					const auto deleted_content = typed_handle.assemble_solvable();
+
+					if (const auto undo = cosmic::delete_entity(typed_handle)) {
+						cosmic::undo_delete_entity(referential, *undo, deleted_content, reinference_type::ONLY_AFFECTED);
+					}
+				});
+			}
+		}
+
+		/* Predicted-only changes that the assignment must revert */
+
+		advance(*predicted, recorded[(i + 1) % steps]);
+
+		if (i % 10 == 0) {
+			create_test_scene_entity(*predicted, test_plain_sprited_bodies::BRICK_WALL, wall_pos(i) + vec2(0, 200));
+		}
+
+		if (dirty_entity_tracker::synchronized_with_each_other(predicted->get_dirty_entities(), referential.get_dirty_entities())) {
+			++partial_assignments;
+		}
+
+		predicted->assign_solvable(referential);
+
+		const auto full_copy = std::make_unique<cosmos>(referential);
+
+		REQUIRE(calculate_solvable_hash(*predicted) == calculate_solvable_hash(*full_copy));
+	}
+
+	REQUIRE(partial_assignments > 0);
+}
+
+TEST_CASE("CosmosSolvable IncrementalHashMatchesRebuild") {
+	auto lua = augs::create_lua_state();
+
+	auto scene = std::make_unique<intercosm>();
+	auto ruleset = test_mode_ruleset();
+
+	scene->make_test_scene(lua, { false, 60 }, ruleset);
+
+	auto& referential = scene->world;
+	const auto predicted = std::make_unique<cosmos>(referential);
+
+	const auto steps = 60u;
+	const auto recorded = record_test_scene_match(referential, steps);
+
+	auto advance = [](cosmos& cosm, cosmic_entropy entropy) {
+		entropy.clear_dead_entities(cosm);
+		standard_solver()({ cosm, entropy, solve_settings() }, solver_callbacks());
+	};
+
+	auto require_same_as_rebuilt = [](const solvable_hash_tree& updated, const cosmos& cosm) {
+		solvable_hash_tree rebuilt;
+		rebuilt.rebuild(cosm);
+
+		REQUIRE(updated.get_root() == calculate_solvable_hash(cosm));
+		REQUIRE(updated.get_root() == rebuilt.get_root());
+		REQUIRE(updated.get_pool_hashes() == rebuilt.get_pool_hashes());
+		REQUIRE(updated.get_entities().size() == rebuilt.get_entities().size());
+		REQUIRE(!find_divergence(rebuilt, updated).has_value());
+	};
+
+	solvable_hash_tree referential_tree;
+	solvable_hash_tree predicted_tree;
+
+	std::vector<entity_id> walls;
+	bool rehashed_only_some = false;
+
+	for (unsigned i = 0; i < steps; ++i) {
+		advance(referential, recorded[i]);
+
+		if (walls.empty() || i % 3 == 0) {
+			walls.push_back(create_test_scene_entity(referential, test_plain_sprited_bodies::BRICK_WALL, vec2(-2000.f + 40.f * i, 3000.f)).get_id());
+		}
+		else if (i % 3 == 1) {
+			referential[walls.back()].set_logic_transform(transformr(vec2(-2000.f + 40.f * i, 3100.f), 30.f));
+		}
+		else {
+			cosmic::delete_entity(referential[walls.front()]);
+			walls.erase(walls.begin());
+		}
+
+		referential_tree.update(referential);
+		require_same_as_rebuilt(referential_tree, referential);
+
+		if (i > 0 && referential_tree.get_num_rehashed_entities() < referential.get_entities_count()) {
+			rehashed_only_some = true;
+		}
+
+		/* The entities copied by a partial assignment must be rehashed too. */
+
+		advance(*predicted, recorded[(i + 1) % steps]);
+		predicted->assign_solvable(referential);
+
+		predicted_tree.update(*predicted);
+		require_same_as_rebuilt(predicted_tree, *predicted);
+	}
+
+	REQUIRE(rehashed_only_some);
+}
+TEST_CASE("CosmosSolvable StructOfArraysEntities") {
+	static_assert(is_soa_entity_v<complex_decoration>);
+
+	auto lua = augs::create_lua_state();
+
+	auto scene = std::make_unique<intercosm>();
+	auto ruleset = test_mode_ruleset();
+
+	scene->make_test_scene(lua, { false, 60 }, ruleset);
+
+	auto& cosm = scene->world;
+	const auto& pool = cosm.get_solvable().significant.get_pool<complex_decoration>();
+
+	REQUIRE(pool.size() > 1);
+
+	{
+		std::size_t iterated = 0;
+
+		cosm.for_each_entity([&](const auto& typed_handle) {
+			if constexpr(std::is_same_v<entity_type_of<decltype(typed_handle)>, complex_decoration>) {
+				REQUIRE(typed_handle.get_id() == typed_entity_id<complex_decoration>(pool.get_nth_id(iterated)));
+				REQUIRE(&typed_handle.template get<components::transform>() == &pool.get_column<components::transform>()[iterated]);
+				++iterated;
+			}
+		});
+
+		REQUIRE(iterated == pool.size());
+	}
+
+	auto components_bytes = [](const auto& solvable) {
+		return augs::to_bytes(solvable.component_state);
+	};
+
+	const auto id = typed_entity_id<complex_decoration>(pool.get_nth_id(0));
+	const auto source_content = cosm[id].assemble_solvable();
+
+	{
+		const auto hash_before = calculate_solvable_hash(cosm);
+
+		const auto undo = cosmic::delete_entity(cosm[id]);
+
+		REQUIRE(undo.has_value());
+		REQUIRE(cosm[id].dead());
+
+		cosmic::undo_delete_entity(cosm, *undo, source_content, reinference_type::ONLY_AFFECTED);
+
+		REQUIRE(cosm[id].alive());
+		REQUIRE(components_bytes(cosm[id].assemble_solvable()) == components_bytes(source_content));
+		REQUIRE(calculate_solvable_hash(cosm) == hash_before);
+	}
+
+	{
+		const auto clone = cosmic::specific_clone_entity(*cosm[id]);
+
+		REQUIRE(clone.get_id() != id);
+		REQUIRE(components_bytes(clone.assemble_solvable()) == components_bytes(source_content));
+
+		const auto moved = transformr(vec2(1234.f, 5678.f), 90.f);
+		clone.set_logic_transform(moved);
+
+		REQUIRE(clone.get_logic_transform() == moved);
+		REQUIRE(cosm[id].get_logic_transform() == source_content.get<components::transform>());
+	}
+}
+
+#endif
@@ -15,6 +15,8 @@
 #include "game/cosmos/entity_id.h"
 #include "game/cosmos/entity_creation_error.h"
 
+class dirty_entity_tracker;
+
 struct entity_creation_input {
 	raw_entity_flavour_id flavour_id;
 };
@@ -67,6 +69,19 @@ public:
 
 	void destroy_all_caches();
 
+	/*
+		Equivalent to *this = b, provided that both solvables were equal
+		when the trackers were last synchronized with each other.
+		Only the entities marked in either tracker are copied,
+		unless the layout of their pool has changed in the meantime.
+	*/
+
+	void assign_modified_from(
+		const cosmos_solvable& b,
+		dirty_entity_tracker& this_dirty,
+		const dirty_entity_tracker& b_dirty
+	);
+
 	void increment_step();
 	void clear();
 
@@ -9,20 +9,19 @@ void cosmos_solvable::for_each_entity_impl(S& self, F callback) {
 			using P = decltype(p);
 			using pool_type = remove_cref<P>;
 
-			using Solvable = typename pool_type::mapped_type;
-			using E = entity_type_of<Solvable>;
+			using E = typename pool_type::value_type::used_entity_type;
 
 			if constexpr(Predicate<E>::value) {
 				using index_type = typename pool_type::used_size_type;
 
 				for (index_type i = 0; i < p.size(); ++i) {
-					using R = decltype(callback(p.data()[i], i));
+					using R = decltype(callback(p.data()[i], i, E()));
 					
 					if constexpr(std::is_same_v<R, void>) {
-						callback(p.data()[i], i);
+						callback(p.data()[i], i, E());
 					}
 					else {
-						const auto result = callback(p.data()[i], i);
+						const auto result = callback(p.data()[i], i, E());
 
 						if constexpr(std::is_same_v<R, callback_result>) {
 							if (result == callback_result::ABORT) {
@@ -42,5 +42,8 @@ class cosmos_solvable_access {
 	template <class T, class H>
 	friend auto& get_corresponding(const H& handle);
 
+	template <bool, class, template <class> class>
+	friend class specific_entity_handle;
+
 	cosmos_solvable_access() {}
 };
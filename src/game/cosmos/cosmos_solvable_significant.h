@@ -7,6 +7,7 @@
 
 #include "game/cosmos/entity_pools.h"
 #include "game/cosmos/entity_solvable.h"
+#include "game/cosmos/entity_soa_layout.h"
 
 #include "game/common_state/entity_name_str.h"
 #include "game/cosmos/entity_id.h"
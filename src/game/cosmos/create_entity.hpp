@@ -21,10 +21,12 @@ ref_typed_entity_handle<E> cosmic::specific_create_entity_detail(
 	const auto new_allocation = cosm.get_solvable({}).template allocate_next_entity<E>({ flavour_id.raw });
 	const auto handle = ref_typed_entity_handle<E> { cosm, { new_allocation.object, new_allocation.key } };
 
-	{
-		auto& object = new_allocation.object;
-		object.component_state = initial_components;
-	}
+	for_each_through_std_get(initial_components, [&](const auto& initial_component) {
+		using T = remove_cref<decltype(initial_component)>;
+		handle.template get_raw_component<T>({}) = initial_component;
+	});
+
+	cosm.mark_modified(handle.get_id());
 
 	pre_construction(handle, handle.get({}));
 	construct_pre_inference(handle);
@@ -110,9 +112,9 @@ ref_typed_entity_handle<E> cosmic::undo_delete_entity(
 	auto& s = cosm.get_solvable({});
 
 	const auto new_allocation = s.template undo_free_entity<E>(undo_delete_input, deleted_content);
-	new_allocation.object.component_state = deleted_content.component_state;
-	
+
 	const auto handle = ref_typed_entity_handle<E> { cosm, { new_allocation.object, new_allocation.key } };
+	cosm.mark_modified(handle.get_id());
 
 	if (reinference == reinference_type::ONLY_AFFECTED) {
 		infer_caches_for(handle);
@@ -133,6 +135,13 @@ void cosmic::make_suitable_for_cloning(entity_solvable<E>& solvable) {
 	}
 }
 
+template <class E>
+void cosmic::make_suitable_for_cloning(const ref_typed_entity_handle<E> handle) {
+	if constexpr(entity_solvable<E>::template has<components::item>()) {
+		handle.template get_raw_component<components::item>({}).clear_slot_info();
+	}
+}
+
 template <class E>
 auto cosmos_solvable::allocate_new_entity(const entity_creation_input in) {
 	auto& pool = significant.get_pool<E>();
@@ -0,0 +1,220 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <memory>
+#include <cstdint>
+
+#include "augs/templates/remove_cref.h"
+#include "game/cosmos/entity_id.h"
+
+/*
+	Remembers which entities might have been modified:
+		- since the cosmos was last synchronized with another one through cosmos::assign_solvable,
+		  so that the next assignment only has to copy those (the "uncopied" flag);
+		- since the cosmos was last hashed by solvable_hash_tree::update,
+		  so that only those have to be rehashed (the "unhashed" flag).
+
+	An entity is marked whenever a mutable handle accesses any of its components,
+	so the set is always a conservative superset of what really changed.
+
+	Marking may happen concurrently from systems run by solve_scheduler,
+	hence the flags are atomic and are never resized while marking.
+	An entity allocated after the flags were last sized may lie beyond the flags -
+	the whole pool is then considered dirty.
+*/
+
+using dirty_tracking_token = uint64_t;
+
+class dirty_entity_tracker {
+	static constexpr uint8_t uncopied_v = 1 << 0;
+	static constexpr uint8_t unhashed_v = 1 << 1;
+
+	struct per_pool {
+		std::unique_ptr<std::atomic<uint8_t>[]> flags;
+		std::size_t num_flags = 0;
+		std::atomic<bool> overflowed = false;
+		std::atomic<bool> unhashed_overflowed = false;
+	};
+
+	static constexpr std::size_t num_pools_v = num_types_in_list_v<all_entity_types>;
+
+	std::array<per_pool, num_pools_v> pools;
+	dirty_tracking_token token = 0;
+
+	/*
+		Changes whenever the unhashed flags stop describing the changes since the last hashing,
+		e.g. when they are reallocated or when the solvable was changed without going through handles.
+	*/
+
+	uint64_t hashing_generation = 1;
+
+	template <class S, class F>
+	void resize_flags(const S& significant, F on_existing_flag) {
+		significant.for_each_entity_pool([&](const auto& pool) {
+			using E = typename remove_cref<decltype(pool)>::value_type::used_entity_type;
+
+			auto& p = pools[entity_type_id::of<E>().get_index()];
+			const auto n = static_cast<std::size_t>(pool.capacity());
+
+			if (p.num_flags != n) {
+				p.flags = std::make_unique<std::atomic<uint8_t>[]>(n);
+				p.num_flags = n;
+
+				/* Both kinds of flags were lost. */
+				token = 0;
+				++hashing_generation;
+
+				return;
+			}
+
+			for (std::size_t i = 0; i < n; ++i) {
+				on_existing_flag(p.flags[i]);
+			}
+		});
+	}
+
+public:
+	void mark(const entity_id id) {
+		auto& p = pools[id.type_id.get_index()];
+		const auto i = static_cast<std::size_t>(id.raw.indirection_index);
+
+		if (i < p.num_flags) {
+			p.flags[i].store(uncopied_v | unhashed_v, std::memory_order_relaxed);
+		}
+		else {
+			p.overflowed.store(true, std::memory_order_relaxed);
+			p.unhashed_overflowed.store(true, std::memory_order_relaxed);
+		}
+	}
+
+	/* Clears the uncopied flags and makes room for every indirector that the pools can currently hold. */
+	template <class S>
+	void synchronize(const dirty_tracking_token new_token, const S& significant) {
+		resize_flags(significant, [](auto& flag) {
+			flag.fetch_and(unhashed_v, std::memory_order_relaxed);
+		});
+
+		token = new_token;
+
+		for (auto& p : pools) {
+			p.overflowed.store(false, std::memory_order_relaxed);
+		}
+	}
+
+	/*
+		Called by solvable_hash_tree::update once it has rehashed the unhashed entities.
+		Returns the generation that the tree should remember.
+	*/
+
+	template <class S>
+	uint64_t clear_unhashed(const S& significant) {
+		resize_flags(significant, [](auto& flag) {
+			flag.fetch_and(uncopied_v, std::memory_order_relaxed);
+		});
+
+		for (auto& p : pools) {
+			p.unhashed_overflowed.store(false, std::memory_order_relaxed);
+		}
+
+		/* So that any other tree that has hashed this cosmos knows it can no longer rely on the flags. */
+		return ++hashing_generation;
+	}
+
+	/* Called when an entity changed because it was copied from another cosmos. */
+	void mark_unhashed(const entity_type_id type, const std::size_t indirection_index) {
+		auto& p = pools[type.get_index()];
+
+		if (indirection_index < p.num_flags) {
+			p.flags[indirection_index].fetch_or(unhashed_v, std::memory_order_relaxed);
+		}
+		else {
+			p.unhashed_overflowed.store(true, std::memory_order_relaxed);
+		}
+	}
+
+	void mark_whole_pool_unhashed(const entity_type_id type) {
+		pools[type.get_index()].unhashed_overflowed.store(true, std::memory_order_relaxed);
+	}
+
+	/* Called whenever the solvable is changed in a way that bypasses handles. */
+	void invalidate() {
+		token = 0;
+		++hashing_generation;
+	}
+
+	auto get_hashing_generation() const {
+		return hashing_generation;
+	}
+
+	bool whole_pool_unhashed(const entity_type_id type) const {
+		return pools[type.get_index()].unhashed_overflowed.load(std::memory_order_relaxed);
+	}
+
+	/* Calls callback with every indirection index that might have changed since the last hashing. */
+	template <class F>
+	void for_each_unhashed(const entity_type_id type, F callback) const {
+		const auto& p = pools[type.get_index()];
+
+		for (std::size_t i = 0; i < p.num_flags; ++i) {
+			if (p.flags[i].load(std::memory_order_relaxed) & unhashed_v) {
+				callback(i);
+			}
+		}
+	}
+
+	/*
+		Whether a and b were synchronized with each other the last time,
+		and none of them has been invalidated since.
+	*/
+	static bool synchronized_with_each_other(const dirty_entity_tracker& a, const dirty_entity_tracker& b) {
+		return a.token != 0 && a.token == b.token;
+	}
+
+	/* Whether the whole pool of this type must be considered dirty in either of the trackers. */
+	static bool whole_pool_dirty(
+		const dirty_entity_tracker& a,
+		const dirty_entity_tracker& b,
+		const entity_type_id type
+	) {
+		const auto& pa = a.pools[type.get_index()];
+		const auto& pb = b.pools[type.get_index()];
+
+		return
+			pa.overflowed.load(std::memory_order_relaxed)
+			|| pb.overflowed.load(std::memory_order_relaxed)
+			|| pa.num_flags != pb.num_flags
+		;
+	}
+
+	/* Calls callback with every indirection index that is dirty in either of the trackers. */
+	template <class F>
+	static void for_each_dirty_in_either(
+		const dirty_entity_tracker& a,
+		const dirty_entity_tracker& b,
+		const entity_type_id type,
+		F callback
+	) {
+		const auto& pa = a.pools[type.get_index()];
+		const auto& pb = b.pools[type.get_index()];
+
+		for (std::size_t i = 0; i < pa.num_flags; ++i) {
+			if ((pa.flags[i].load(std::memory_order_relaxed) | pb.flags[i].load(std::memory_order_relaxed)) & uncopied_v) {
+				callback(i);
+			}
+		}
+	}
+
+	static std::size_t count_dirty_in_either(
+		const dirty_entity_tracker& a,
+		const dirty_entity_tracker& b,
+		const entity_type_id type
+	) {
+		std::size_t count = 0;
+
+		for_each_dirty_in_either(a, b, type, [&count](const std::size_t) {
+			++count;
+		});
+
+		return count;
+	}
+};
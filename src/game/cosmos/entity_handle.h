@@ -127,6 +127,10 @@ public:
 #if !IS_PRODUCTION_BUILD
 		ensure(alive());
 #endif
+		if constexpr(!is_const) {
+			owner.mark_modified(raw_id);
+		}
+
 		return *ptr;
 	}
 
@@ -194,7 +198,7 @@ public:
 	template <class E>
 	decltype(auto) get_specific() const {
 		using handle_type = basic_ref_typed_entity_handle<is_const, E>;
-		using specific_ptr_type = maybe_const_ptr_t<is_const, entity_solvable<E>>;
+		using specific_ptr_type = maybe_const_ptr_t<is_const, entity_subject_t<E>>;
 
 		const auto specific_ptr = reinterpret_cast<specific_ptr_type>(ptr);
 		const auto stored_id = ref_stored_id_provider<handle_type>( *specific_ptr, typed_entity_id<E>(raw_id.raw) );
@@ -0,0 +1,13 @@
+#pragma once
+
+enum class entity_pool_storage {
+	/* All components of an entity are kept together, in entity_solvable<E>::component_state. */
+	ARRAY_OF_STRUCTS,
+
+	/* 
+		Every component type is kept in its own dense array, see augs::soa_pool.
+		Handles then point to the entity_solvable_meta of the entity
+		and reach the components through the pool.
+	*/
+	STRUCT_OF_ARRAYS
+};
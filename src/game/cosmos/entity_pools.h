@@ -3,20 +3,76 @@
 
 #include "augs/misc/declare_containers.h"
 #include "augs/misc/pool/pool_declaration.h"
+#include "augs/misc/pool/soa_pool_declaration.h"
 
 #include "game/organization/all_entity_types.h"
 
 #include "game/cosmos/pool_size_type.h"
+#include "game/cosmos/entity_pool_storage.h"
 #include "game/cosmos/per_entity_type.h"
 
+struct entity_solvable_meta;
+
 template <class E>
 struct entity_solvable;
 
+template <class T, entity_pool_storage storage>
+struct make_entity_pool_of;
+
+template <class T>
+struct make_entity_pool_of<T, entity_pool_storage::ARRAY_OF_STRUCTS> {
+	using type = std::conditional_t<
+		statically_allocate_entities,
+		augs::pool<entity_solvable<T>, of_size<T::statically_allocated_entities>::template make_nontrivial_constant_vector, cosmic_pool_size_type, typename T::synchronized_arrays>,
+		augs::pool<entity_solvable<T>, make_vector, cosmic_pool_size_type, typename T::synchronized_arrays>
+	>;
+};
+
+template <class T>
+struct make_entity_pool_of<T, entity_pool_storage::STRUCT_OF_ARRAYS> {
+	using type = std::conditional_t<
+		statically_allocate_entities,
+		augs::soa_pool<entity_solvable<T>, of_size<T::statically_allocated_entities>::template make_nontrivial_constant_vector, cosmic_pool_size_type, typename T::synchronized_arrays>,
+		augs::soa_pool<entity_solvable<T>, make_vector, cosmic_pool_size_type, typename T::synchronized_arrays>
+	>;
+};
+
+/*
+	An entity type chooses its storage by declaring:
+
+	static constexpr entity_pool_storage pool_storage = entity_pool_storage::STRUCT_OF_ARRAYS;
+
+	Types that declare nothing are stored as ARRAY_OF_STRUCTS.
+*/
+
+template <class T, class = void>
+struct entity_pool_storage_of {
+	static constexpr auto value = entity_pool_storage::ARRAY_OF_STRUCTS;
+};
+
+template <class T>
+struct entity_pool_storage_of<T, decltype(T::pool_storage, void())> {
+	static constexpr entity_pool_storage value = T::pool_storage;
+};
+
+template <class T>
+constexpr entity_pool_storage entity_pool_storage_v = entity_pool_storage_of<T>::value;
+
+template <class T>
+constexpr bool is_soa_entity_v = entity_pool_storage_v<T> == entity_pool_storage::STRUCT_OF_ARRAYS;
+
+/* What the handles of an entity of type T point to. */
+
+template <class T>
+using entity_subject_t = std::conditional_t<is_soa_entity_v<T>, entity_solvable_meta, entity_solvable<T>>;
+
+template <class T, entity_pool_storage storage = entity_pool_storage_v<T>>
+using make_entity_pool_with = typename make_entity_pool_of<T, storage>::type;
+
+template <class T>
+using make_entity_pool = make_entity_pool_with<T>;
+
 template <class T>
-using make_entity_pool = std::conditional_t<
-	statically_allocate_entities,
-	augs::pool<entity_solvable<T>, of_size<T::statically_allocated_entities>::template make_nontrivial_constant_vector, cosmic_pool_size_type, typename T::synchronized_arrays>,
-	augs::pool<entity_solvable<T>, make_vector, cosmic_pool_size_type, typename T::synchronized_arrays>
->;
+using make_entity_soa_pool = make_entity_pool_with<T, entity_pool_storage::STRUCT_OF_ARRAYS>;
 
 using all_entity_pools = per_entity_type_container<make_entity_pool>;
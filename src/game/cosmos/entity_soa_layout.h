@@ -0,0 +1,32 @@
+#pragma once
+#include "augs/templates/list_utils.h"
+#include "augs/misc/pool/soa_pool.h"
+#include "game/cosmos/entity_solvable.h"
+
+/*
+	Splits an entity into its meta and one column per component,
+	so that an entity pool can be stored as a structure of arrays.
+*/
+
+namespace augs {
+	template <class E>
+	struct soa_layout<entity_solvable<E>> {
+		using column_list = prepend_to_list_t<entity_solvable_meta, components_of<E>>;
+
+		template <class S, class F>
+		static void for_each_column(S& object, F callback) {
+			callback(static_cast<maybe_const_ref_t<std::is_const_v<S>, entity_solvable_meta>>(object));
+			object.for_each(callback);
+		}
+
+		template <class... C>
+		static entity_solvable<E> assemble(const entity_solvable_meta& meta, const C&... components) {
+			entity_solvable<E> object;
+
+			static_cast<entity_solvable_meta&>(object) = meta;
+			((object.template get<C>() = components), ...);
+
+			return object;
+		}
+	};
+}
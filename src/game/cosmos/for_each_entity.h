@@ -7,9 +7,9 @@
 template <template <class> class Predicate, class C, class F>
 void cosmic::for_each_entity(C& self, F callback) {
 	self.get_solvable({}).template for_each_entity<Predicate>(
-		[&](auto& object, const auto iteration_index) -> decltype(auto) {
+		[&](auto& object, const auto iteration_index, const auto entity_type_tag) -> decltype(auto) {
 			using O = decltype(object);
-			using E = entity_type_of<O>;
+			using E = remove_cref<decltype(entity_type_tag)>;
 			using iterated_handle_type = basic_iterated_entity_handle<is_const_ref_v<O>, E>;
 			
 			return callback(iterated_handle_type(self, { object, iteration_index } ));
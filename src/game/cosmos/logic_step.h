@@ -6,6 +6,8 @@
 #include "game/stateless_systems/destroy_system.h"
 #include "augs/misc/randomization_declaration.h"
 #include "game/cosmos/solvers/solve_structs.h"
+#include "game/organization/all_messages_declaration.h"
+#include "augs/templates/remove_cref.h"
 
 #define LOG_DELETIONS 0
 
@@ -80,6 +82,14 @@ public:
 		return get_cosmos().get_fixed_delta();
 	}
 
+	template <bool C = !is_const, class = std::enable_if_t<C>>
+	auto with_transient(
+		data_living_one_step& new_transient,
+		solve_result& new_result
+	) const {
+		return basic_logic_step(input, new_transient, step_rng, new_result);
+	}
+
 	operator const_logic_step() const {
 		return { input, transient, step_rng, result };
 	}
@@ -93,10 +103,24 @@ public:
 		return transient.messages.template get_queue<T>();
 	}
 
+	template <class T>
+	bool skips_messages_of_type() const {
+		if constexpr(is_audiovisual_message_v<remove_cref<T>>) {
+			return !get_settings().generate_audiovisual_messages;
+		}
+		else {
+			return false;
+		}
+	}
+
 	template <class T>
 	void post_message(T&& msg) const {
 		static_assert(!std::is_same_v<T, messages::queue_deletion>, "Use queue_deletion_of for better logging.");
 
+		if (skips_messages_of_type<T>()) {
+			return;
+		}
+
 		transient.messages.post(std::forward<T>(msg));
 	}
 
@@ -104,6 +128,10 @@ public:
 	void post_messages(const T& msgs) const {
 		static_assert(!std::is_same_v<typename T::value_type, messages::queue_deletion>, "Use queue_deletion_of for better logging.");
 
+		if (skips_messages_of_type<typename T::value_type>()) {
+			return;
+		}
+
 		transient.messages.post(msgs);
 	}
 
@@ -111,6 +139,10 @@ public:
 	void post_message_if(const std::optional<T>& msg) const {
 		static_assert(!std::is_same_v<T, messages::queue_deletion>, "Use queue_deletion_of for better logging.");
 
+		if (skips_messages_of_type<T>()) {
+			return;
+		}
+
 		if (msg.has_value()) {
 			transient.messages.post(*msg);
 		}
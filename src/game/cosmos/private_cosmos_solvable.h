@@ -4,6 +4,7 @@
 #include "game/cosmos/cosmos_solvable_inferred_access.h"
 
 struct cosmic_functions_detail;
+class dirty_entity_tracker;
 
 class private_cosmos_solvable {
 	cosmos_solvable solvable;
@@ -36,6 +37,14 @@ public:
 		return solvable.inferred;
 	}
 
+	void assign_modified_from(
+		const private_cosmos_solvable& b,
+		dirty_entity_tracker& this_dirty,
+		const dirty_entity_tracker& b_dirty
+	) {
+		solvable.assign_modified_from(b.solvable, this_dirty, b_dirty);
+	}
+
 	auto& get_global_solvable() {
 		return solvable.significant.global;
 	}
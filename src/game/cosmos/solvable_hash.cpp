@@ -0,0 +1,408 @@
+#include "augs/readwrite/crc32_stream.h"
+#include "augs/readwrite/byte_readwrite.h"
+#include "augs/string/typesafe_sprintf.h"
+#include "augs/string/get_type_name.h"
+
+#include "game/cosmos/cosmos.h"
+#include "game/cosmos/solvable_hash.h"
+#include "game/organization/for_each_entity_type.h"
+#include "augs/templates/for_each_type.h"
+
+/* Hashes the same bytes regardless of whether the pool stores the entities as structs or as arrays. */
+
+template <class P, class OnComponent>
+static solvable_hash_type hash_entity(
+	const P& pool,
+	const entity_id id,
+	const typename P::mapped_type& object,
+	OnComponent on_component
+) {
+	using E = typename P::value_type::used_entity_type;
+
+	augs::crc32_stream entity_hash;
+
+	augs::write_bytes(entity_hash, id);
+	augs::write_bytes(entity_hash, static_cast<const entity_solvable_meta&>(object));
+
+	unsigned c = 0;
+
+	auto hash_component = [&](const auto& component) {
+		augs::crc32_stream component_hash;
+		augs::write_bytes(component_hash, component);
+
+		const auto h = component_hash.get_hash();
+
+		on_component(c++, h);
+		augs::write_bytes(entity_hash, h);
+	};
+
+	if constexpr(is_soa_entity_v<E>) {
+		for_each_type_in_list<components_of<E>>([&](auto tag) {
+			using C = decltype(tag);
+			hash_component(pool.template get<C>(object));
+		});
+	}
+	else {
+		(void)pool;
+		object.for_each(hash_component);
+	}
+
+	return entity_hash.get_hash();
+}
+
+/*
+	Folds the hashes of all entities into the pool hashes and the root, in a fixed order.
+	get_entity_hash lets solvable_hash_tree reuse the hashes of unchanged entities,
+	while calculate_solvable_hash just hashes every entity.
+*/
+
+template <class GetEntityHash, class OnPool>
+static solvable_hash_type fold_solvable(
+	const cosmos& cosm,
+	GetEntityHash get_entity_hash,
+	OnPool on_pool
+) {
+	const auto& signi = cosm.get_solvable().significant;
+
+	augs::crc32_stream root;
+
+	augs::write_bytes(root, cosm.get_clock().now);
+	augs::write_bytes(root, signi.global);
+	augs::write_bytes(root, signi.global.lightweight_projectiles);
+	augs::write_bytes(root, static_cast<uint32_t>(cosm.get_entities_count()));
+
+	signi.for_each_entity_pool([&](const auto& pool) {
+		using E = typename remove_cref<decltype(pool)>::value_type::used_entity_type;
+
+		augs::crc32_stream pool_hash;
+		augs::write_bytes(pool_hash, static_cast<uint32_t>(pool.size()));
+
+		for_each_id_and_object(pool, [&](const auto& raw_id, const auto& object) {
+			const auto id = entity_id(raw_id, entity_type_id::of<E>());
+			augs::write_bytes(pool_hash, get_entity_hash(pool, id, object));
+		});
+
+		const auto h = pool_hash.get_hash();
+
+		on_pool(entity_type_id::of<E>(), h);
+		augs::write_bytes(root, h);
+	});
+
+	return root.get_hash();
+}
+
+solvable_hash_type calculate_solvable_hash(const cosmos& cosm) {
+	auto ignore = [](auto&&...) {};
+
+	return fold_solvable(
+		cosm,
+		[&](const auto& pool, const entity_id id, const auto& object) {
+			return hash_entity(pool, id, object, ignore);
+		},
+		ignore
+	);
+}
+
+void solvable_hash_tree::hash(const cosmos& cosm, const bool reuse_leaves) {
+	const auto& signi = cosm.get_solvable().significant;
+	const auto& tracker = cosm.get_dirty_entities();
+
+	/* Forget the leaves of the entities that might have changed. */
+
+	signi.for_each_entity_pool([&](const auto& pool) {
+		using E = typename remove_cref<decltype(pool)>::value_type::used_entity_type;
+
+		const auto type = entity_type_id::of<E>();
+		const auto num_components = num_types_in_list_v<components_of<E>>;
+
+		auto& l = leaves[type.get_index()];
+
+		if (!reuse_leaves || tracker.whole_pool_unhashed(type)) {
+			l.entities.clear();
+		}
+		else {
+			tracker.for_each_unhashed(type, [&](const std::size_t i) {
+				if (i < l.entities.size()) {
+					l.entities[i] = {};
+				}
+			});
+		}
+
+		const auto n = static_cast<std::size_t>(pool.capacity());
+
+		l.entities.resize(n);
+		l.component_hashes.resize(n * num_components);
+	});
+
+	entities.clear();
+	num_rehashed_entities = 0;
+
+	unsigned next_first_entity = 0;
+
+	root = fold_solvable(
+		cosm,
+		[&](const auto& pool, const entity_id id, const auto& object) {
+			using E = typename remove_cref<decltype(pool)>::value_type::used_entity_type;
+
+			const auto num_components = static_cast<unsigned>(num_types_in_list_v<components_of<E>>);
+			const auto i = static_cast<std::size_t>(id.raw.indirection_index);
+
+			auto& l = leaves[id.type_id.get_index()];
+			auto& leaf = l.entities[i];
+
+			entity_node node;
+			node.id = id;
+			node.first_component = static_cast<unsigned>(i) * num_components;
+			node.num_components = num_components;
+
+			if (leaf.id != id) {
+				leaf.id = id;
+				leaf.hash = hash_entity(pool, id, object, [&](const unsigned c, const solvable_hash_type h) {
+					l.component_hashes[node.first_component + c] = h;
+				});
+
+				++num_rehashed_entities;
+			}
+
+			node.hash = leaf.hash;
+			entities.push_back(node);
+
+			return leaf.hash;
+		},
+		[&](const entity_type_id type, const solvable_hash_type h) {
+			const auto num_entities = static_cast<unsigned>(entities.size());
+
+			auto& node = pools[type.get_index()];
+			node.hash = h;
+			node.first_entity = next_first_entity;
+			node.num_entities = num_entities - next_first_entity;
+
+			next_first_entity = num_entities;
+		}
+	);
+}
+
+void solvable_hash_tree::rebuild(const cosmos& cosm) {
+	hash(cosm, false);
+
+	/* The dirty tracking was left untouched, so nothing can be reused later. */
+	hashed_cosmos = std::nullopt;
+}
+
+void solvable_hash_tree::update(const cosmos& cosm) {
+	const bool reuse_leaves = 
+		hashed_cosmos == cosm.get_cosmos_id()
+		&& hashed_generation == cosm.get_dirty_entities().get_hashing_generation()
+	;
+
+	hash(cosm, reuse_leaves);
+
+	hashed_cosmos = cosm.get_cosmos_id();
+	hashed_generation = cosm.clear_unhashed_entities();
+}
+
+/* Descends into two versions of the same pool, given as ranges of entity nodes and their component hashes. */
+
+static solvable_hash_divergence find_divergence_in_pool(
+	const entity_type_id type,
+	const solvable_hash_tree::entity_node* const expected_entities,
+	const unsigned num_expected,
+	const std::vector<solvable_hash_type>& expected_components,
+	const solvable_hash_tree::entity_node* const actual_entities,
+	const unsigned num_actual,
+	const std::vector<solvable_hash_type>& actual_components
+) {
+	solvable_hash_divergence result;
+	result.type = type;
+
+	const auto num_common = std::min(num_expected, num_actual);
+
+	for (unsigned i = 0; i < num_common; ++i) {
+		const auto& ee = expected_entities[i];
+		const auto& ae = actual_entities[i];
+
+		if (ee.id != ae.id) {
+			result.entity = ee.id;
+			result.different_ids = true;
+			return result;
+		}
+
+		if (ee.hash == ae.hash) {
+			continue;
+		}
+
+		result.entity = ee.id;
+
+		for (unsigned c = 0; c < ee.num_components; ++c) {
+			const auto eh = expected_components[ee.first_component + c];
+			const auto ah = actual_components[ae.first_component + c];
+
+			if (eh != ah) {
+				result.component_index = c;
+				break;
+			}
+		}
+
+		return result;
+	}
+
+	/* One of the pools has more entities, but the common ones are the same. */
+
+	if (num_expected == num_actual) {
+		/* Only possible if the pools were hashed from different entity counts. */
+		return result;
+	}
+
+	result.different_ids = true;
+
+	if (num_expected > num_common) {
+		result.entity = expected_entities[num_common].id;
+	}
+	else {
+		result.entity = actual_entities[num_common].id;
+	}
+
+	return result;
+}
+
+std::optional<solvable_hash_divergence> find_divergence(
+	const solvable_hash_tree& expected,
+	const solvable_hash_tree& actual
+) {
+	if (expected.get_root() == actual.get_root()) {
+		return std::nullopt;
+	}
+
+	for (std::size_t p = 0; p < solvable_hash_tree::num_pools_v; ++p) {
+		const auto& ep = expected.get_pools()[p];
+		const auto& ap = actual.get_pools()[p];
+
+		if (ep.hash == ap.hash) {
+			continue;
+		}
+
+		return find_divergence_in_pool(
+			entity_type_id(static_cast<entity_type_id::index_type>(p)),
+			expected.get_entities().data() + ep.first_entity,
+			ep.num_entities,
+			expected.get_component_hashes(p),
+			actual.get_entities().data() + ap.first_entity,
+			ap.num_entities,
+			actual.get_component_hashes(p)
+		);
+	}
+
+	return solvable_hash_divergence();
+}
+
+std::optional<solvable_hash_divergence> find_divergence(
+	const solvable_hash_subtree& expected,
+	const solvable_hash_tree& actual
+) {
+	if (!expected.type.is_set()) {
+		return std::nullopt;
+	}
+
+	const auto p = expected.type.get_index();
+	const auto& ap = actual.get_pools()[p];
+
+	const auto result = find_divergence_in_pool(
+		expected.type,
+		expected.entities.data(),
+		static_cast<unsigned>(expected.entities.size()),
+		expected.component_hashes,
+		actual.get_entities().data() + ap.first_entity,
+		ap.num_entities,
+		actual.get_component_hashes(p)
+	);
+
+	if (!result.entity.is_set()) {
+		return std::nullopt;
+	}
+
+	return result;
+}
+
+void solvable_hash_subtree::assign_from(
+	const solvable_hash_tree& tree,
+	const entity_type_id new_type,
+	const uint32_t new_step
+) {
+	step = new_step;
+	type = new_type;
+
+	entities.clear();
+	component_hashes.clear();
+
+	const auto p = type.get_index();
+	const auto& pool = tree.get_pools()[p];
+	const auto& all_components = tree.get_component_hashes(p);
+
+	for (unsigned i = 0; i < pool.num_entities; ++i) {
+		auto node = tree.get_entities()[pool.first_entity + i];
+
+		const auto first = all_components.begin() + node.first_component;
+		node.first_component = static_cast<unsigned>(component_hashes.size());
+
+		component_hashes.insert(component_hashes.end(), first, first + node.num_components);
+		entities.push_back(node);
+	}
+}
+
+std::optional<solvable_hash_divergence> find_divergence(
+	const solvable_pool_hashes& expected,
+	const solvable_hash_tree& actual
+) {
+	const auto& actual_pools = actual.get_pools();
+
+	for (std::size_t p = 0; p < solvable_hash_tree::num_pools_v; ++p) {
+		if (expected[p] != actual_pools[p].hash) {
+			solvable_hash_divergence result;
+			result.type = entity_type_id(static_cast<entity_type_id::index_type>(p));
+			return result;
+		}
+	}
+
+	return std::nullopt;
+}
+
+std::string solvable_hash_divergence::describe() const {
+	if (!type.is_set()) {
+		return "All entity pools match. The clock or the global solvable diverged.";
+	}
+
+	std::string type_name;
+	std::string component_name;
+
+	for_each_entity_type([&](auto e) {
+		using E = decltype(e);
+
+		if (type.is<E>()) {
+			type_name = get_type_name_strip_namespace<E>();
+
+			if (component_index) {
+				unsigned c = 0;
+
+				for_each_type_in_list<components_of<E>>([&](auto component) {
+					if (c++ == *component_index) {
+						component_name = get_type_name_strip_namespace<decltype(component)>();
+					}
+				});
+			}
+		}
+	});
+
+	if (!entity.is_set()) {
+		return typesafe_sprintf("Pool %x diverged.", type_name);
+	}
+
+	if (different_ids) {
+		return typesafe_sprintf("Pool %x holds different entities. First mismatch: %x", type_name, entity);
+	}
+
+	if (component_name.empty()) {
+		return typesafe_sprintf("Pool %x, entity %x: the meta diverged.", type_name, entity);
+	}
+
+	return typesafe_sprintf("Pool %x, entity %x: component %x diverged.", type_name, entity, component_name);
+}
@@ -0,0 +1,181 @@
+#pragma once
+#include <array>
+#include <string>
+#include <vector>
+#include <optional>
+#include <cstdint>
+
+#include "game/cosmos/entity_id.h"
+#include "game/cosmos/cosmos_id_type.h"
+
+class cosmos;
+
+/*
+	The hash of the significant solvable state, as sent by the server every state_hash_once_every_tick.
+
+	It is a Merkle-style hash:
+		- every component of every entity is hashed separately;
+		- the hash of an entity covers its id, its meta and the hashes of its components;
+		- the hash of a pool covers the hashes of all its entities, in the order of the pool;
+		- the root covers the clock, the global solvable, the entity count and the hashes of all pools.
+
+	calculate_solvable_hash streams everything through augs::crc32_stream and never allocates.
+	solvable_hash_tree additionally remembers every level of the tree,
+	so that two trees with differing roots can be descended to the exact diverging entity and component.
+*/
+
+using solvable_hash_type = uint32_t;
+
+solvable_hash_type calculate_solvable_hash(const cosmos&);
+
+class solvable_hash_tree {
+public:
+	static constexpr std::size_t num_pools_v = num_types_in_list_v<all_entity_types>;
+
+	struct entity_node {
+		entity_id id;
+		solvable_hash_type hash = 0;
+
+		/* Into get_component_hashes of the pool of this entity. */
+		unsigned first_component = 0;
+		unsigned num_components = 0;
+	};
+
+	struct pool_node {
+		solvable_hash_type hash = 0;
+		unsigned first_entity = 0;
+		unsigned num_entities = 0;
+	};
+
+private:
+	/* The hash of an entity, remembered under its indirection index. */
+	struct entity_leaf {
+		entity_id id;
+		solvable_hash_type hash = 0;
+	};
+
+	struct pool_leaves {
+		std::vector<entity_leaf> entities;
+		std::vector<solvable_hash_type> component_hashes;
+	};
+
+	solvable_hash_type root = 0;
+	std::array<pool_node, num_pools_v> pools = {};
+	std::array<pool_leaves, num_pools_v> leaves;
+	std::vector<entity_node> entities;
+
+	/* What update has last hashed, to tell if the leaves can be reused. */
+	std::optional<cosmos_id_type> hashed_cosmos;
+	uint64_t hashed_generation = 0;
+
+	std::size_t num_rehashed_entities = 0;
+
+	void hash(const cosmos&, bool reuse_leaves);
+
+public:
+	/* 
+		Hashes every entity. 
+		Reuses the storage of the previous build, so it does not allocate once warmed up.
+	*/
+
+	void rebuild(const cosmos&);
+
+	/*
+		Rehashes only the entities that the dirty tracking of the cosmos has marked 
+		since this tree last hashed the same cosmos, and folds the pool and root hashes anew.
+		Falls back to rebuild when the leaves cannot be trusted, e.g. when another tree has hashed the cosmos since.
+
+		The resulting tree is always identical to the one built by rebuild.
+	*/
+
+	void update(const cosmos&);
+
+	auto get_root() const {
+		return root;
+	}
+
+	auto get_pool_hashes() const {
+		std::array<solvable_hash_type, num_pools_v> result;
+
+		for (std::size_t i = 0; i < num_pools_v; ++i) {
+			result[i] = pools[i].hash;
+		}
+
+		return result;
+	}
+
+	const auto& get_pools() const {
+		return pools;
+	}
+
+	const auto& get_entities() const {
+		return entities;
+	}
+
+	const auto& get_component_hashes(const std::size_t pool_index) const {
+		return leaves[pool_index].component_hashes;
+	}
+
+	/* How many entities the last rebuild or update had to hash. */
+	auto get_num_rehashed_entities() const {
+		return num_rehashed_entities;
+	}
+};
+
+/* 
+	The hashes of all entities and components of a single pool.
+	Sent by the server to a client that has found the pool to diverge,
+	so that the client can tell the exact entity and component.
+*/
+
+struct solvable_hash_subtree {
+	uint32_t step = 0;
+	entity_type_id type;
+
+	/* first_component indexes into component_hashes of this subtree. */
+	std::vector<solvable_hash_tree::entity_node> entities;
+	std::vector<solvable_hash_type> component_hashes;
+
+	void assign_from(const solvable_hash_tree&, entity_type_id, uint32_t step);
+};
+
+/* The top level of the tree below the root - small enough to be sent over the network. */
+using solvable_pool_hashes = std::array<solvable_hash_type, solvable_hash_tree::num_pools_v>;
+
+struct solvable_hash_divergence {
+	/* Unset if all pools match and only the clock or the global solvable diverged. */
+	entity_type_id type;
+
+	/* The first entity of the pool whose id or contents diverged. Unset if only the pool hashes were compared. */
+	entity_id entity;
+
+	/* True if the pools hold different entities at this position, not just different contents. */
+	bool different_ids = false;
+
+	/* Index into components_of<E>. Unset if only the entity meta diverged. */
+	std::optional<unsigned> component_index;
+
+	std::string describe() const;
+};
+
+std::optional<solvable_hash_divergence> find_divergence(
+	const solvable_hash_tree& expected,
+	const solvable_hash_tree& actual
+);
+
+/* 
+	When only the pool hashes of the other side are known, e.g. as sent by the server,
+	only the diverging pool can be found.
+*/
+
+std::optional<solvable_hash_divergence> find_divergence(
+	const solvable_pool_hashes& expected,
+	const solvable_hash_tree& actual
+);
+
+/* When the server has sent the subtree of the pool that diverged. */
+
+std::optional<solvable_hash_divergence> find_divergence(
+	const solvable_hash_subtree& expected,
+	const solvable_hash_tree& actual
+);
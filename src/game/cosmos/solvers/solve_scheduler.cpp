@@ -0,0 +1,256 @@
+#include "augs/log.h"
+#include "augs/templates/thread_pool.h"
+#include "augs/templates/remove_cref.h"
+#include "game/organization/all_messages_includes.h"
+
+#include "game/cosmos/solvers/solve_scheduler.h"
+#include "game/cosmos/logic_step.h"
+
+system_schedule::system_schedule(std::vector<scheduled_system> new_systems) : systems(std::move(new_systems)) {
+	for (std::size_t i = 0; i < systems.size(); ++i) {
+		const auto& candidate = systems[i].access;
+
+		const bool fits_current = [&]() {
+			if (batches.empty()) {
+				return false;
+			}
+
+			for (const auto j : batches.back()) {
+				if (candidate.conflicts_with(systems[j].access)) {
+					return false;
+				}
+			}
+
+			return true;
+		}();
+
+		if (fits_current) {
+			batches.back().push_back(i);
+		}
+		else {
+			batches.push_back({ i });
+		}
+	}
+}
+
+std::optional<std::size_t> solve_scheduler::find_undeclared_post(
+	const system_access& access,
+	const seeded_sizes& before,
+	const all_message_queues& after
+) {
+	std::optional<std::size_t> found;
+
+	after.for_each_queue([&](const std::size_t q_idx, const auto& q) {
+		if (!found && !access.written_messages.test(q_idx) && q.size() > before[q_idx]) {
+			found = q_idx;
+		}
+	});
+
+	return found;
+}
+
+solve_scheduler::seeded_sizes solve_scheduler::sizes_of(const all_message_queues& queues) {
+	seeded_sizes sizes;
+
+	queues.for_each_queue([&](const std::size_t q_idx, const auto& q) {
+		sizes[q_idx] = q.size();
+	});
+
+	return sizes;
+}
+
+static void check_declared_posts(
+	const scheduled_system& system,
+	const solve_scheduler::seeded_sizes& before,
+	const all_message_queues& after
+) {
+#if !IS_PRODUCTION_BUILD
+	if (const auto undeclared = solve_scheduler::find_undeclared_post(system.access, before, after)) {
+		LOG("%x posted to the message queue %x without declaring it.", system.name, *undeclared);
+		ensure(false && "A scheduled system posted a message it did not declare.");
+	}
+#else
+	(void)system;
+	(void)before;
+	(void)after;
+#endif
+}
+
+void solve_scheduler::run_batch(
+	const logic_step step,
+	const std::vector<scheduled_system>& systems,
+	const std::vector<std::size_t>& batch,
+	augs::thread_pool& pool
+) {
+	if (contexts.size() < batch.size()) {
+		contexts.resize(batch.size());
+	}
+
+	const auto& main_messages = step.transient.messages;
+
+	for (std::size_t t = 0; t < batch.size(); ++t) {
+		auto& ctx = contexts[t];
+		const auto& access = systems[batch[t]].access;
+
+		ctx.transient.clear();
+		ctx.result = {};
+
+		ctx.transient.messages.for_each_queue([&](const std::size_t q_idx, auto& q) {
+			using M = typename remove_cref<decltype(q)>::value_type;
+
+			if (access.read_messages.test(q_idx)) {
+				q = main_messages.template get_queue<M>();
+			}
+
+			ctx.seeded[q_idx] = q.size();
+		});
+	}
+
+	augs::task_group group;
+
+	for (std::size_t t = 0; t < batch.size(); ++t) {
+		auto& ctx = contexts[t];
+		const auto run = systems[batch[t]].run;
+
+		pool.run(group, [run, step, &ctx]() {
+			run(step.with_transient(ctx.transient, ctx.result));
+		});
+	}
+
+	pool.wait(group);
+
+	auto& merged_messages = step.transient.messages;
+
+	for (std::size_t t = 0; t < batch.size(); ++t) {
+		const auto& ctx = contexts[t];
+
+		check_declared_posts(systems[batch[t]], ctx.seeded, ctx.transient.messages);
+
+		merged_messages.for_each_queue([&](const std::size_t q_idx, auto& q) {
+			using M = typename remove_cref<decltype(q)>::value_type;
+
+			const auto& posted = ctx.transient.messages.template get_queue<M>();
+			q.insert(q.end(), posted.begin() + ctx.seeded[q_idx], posted.end());
+		});
+
+		if (ctx.result.state_inconsistent) {
+			step.result.state_inconsistent = true;
+		}
+	}
+}
+
+void solve_scheduler::run(
+	const logic_step step,
+	const system_schedule& schedule
+) {
+	const auto& systems = schedule.get_systems();
+	const auto pool = step.get_settings().parallelization.pool;
+
+	for (const auto& batch : schedule.get_batches()) {
+		if (pool == nullptr || batch.size() == 1) {
+			for (const auto i : batch) {
+#if !IS_PRODUCTION_BUILD
+				const auto before = sizes_of(step.transient.messages);
+				systems[i].run(step);
+				check_declared_posts(systems[i], before, step.transient.messages);
+#else
+				systems[i].run(step);
+#endif
+			}
+
+			continue;
+		}
+
+		run_batch(step, systems, batch, *pool);
+	}
+}
+
+#if BUILD_UNIT_TESTS
+#include <Catch/single_include/catch2/catch.hpp>
+#include "augs/misc/randomization.h"
+#include "game/cosmos/cosmos.h"
+
+namespace {
+	void post_ring(const logic_step step, const float x) {
+		auto msg = messages::exploding_ring_effect(always_predictable_v);
+		msg.payload.center = vec2(x, 0.f);
+		step.post_message(std::move(msg));
+	}
+
+	void post_two_rings(const logic_step step) {
+		post_ring(step, 1.f);
+		post_ring(step, 2.f);
+	}
+
+	void post_thunder_and_ring(const logic_step step) {
+		step.post_message(messages::thunder_effect(always_predictable_v));
+		post_ring(step, 3.f);
+	}
+
+	/* Reads the rings of the previous batch, so it must see exactly what the serial run would. */
+	void count_rings(const logic_step step) {
+		const auto rings = step.get_queue<messages::exploding_ring_effect>().size();
+
+		for (std::size_t i = 0; i < rings; ++i) {
+			post_ring(step, 10.f + static_cast<float>(rings));
+		}
+	}
+}
+
+TEST_CASE("SolveScheduler SerialEquivalence") {
+	const auto schedule = system_schedule({
+		{ "post_two_rings", system_access().posts<messages::exploding_ring_effect>(), post_two_rings },
+		{ "post_thunder_and_ring", system_access().posts<messages::thunder_effect, messages::exploding_ring_effect>(), post_thunder_and_ring },
+		{ "count_rings", system_access().reads_messages<messages::exploding_ring_effect>().posts<messages::exploding_ring_effect>(), count_rings }
+	});
+
+	REQUIRE(schedule.get_batches().size() == 2);
+	REQUIRE(schedule.get_batches()[0].size() == 2);
+
+	cosmos cosm;
+	const auto entropy = cosmic_entropy();
+	auto pool = augs::thread_pool(3);
+
+	auto solve = [&](augs::thread_pool* const used_pool) {
+		auto settings = solve_settings();
+		settings.parallelization.pool = used_pool;
+
+		data_living_one_step transient;
+		auto rng = randomization(0);
+		solve_result result;
+
+		solve_scheduler().run(logic_step({ cosm, entropy, settings }, transient, rng, result), schedule);
+
+		std::vector<float> centers;
+
+		for (const auto& r : transient.messages.get_queue<messages::exploding_ring_effect>()) {
+			centers.push_back(r.payload.center.x);
+		}
+
+		REQUIRE(transient.messages.get_queue<messages::thunder_effect>().size() == 1);
+
+		return centers;
+	};
+
+	const auto serial = solve(nullptr);
+	const auto parallel = solve(&pool);
+
+	const auto expected = std::vector<float> { 1.f, 2.f, 3.f, 13.f, 13.f, 13.f };
+
+	REQUIRE(serial == expected);
+	REQUIRE(parallel == serial);
+}
+
+TEST_CASE("SolveScheduler UndeclaredPosts") {
+	all_message_queues queues;
+	const auto before = solve_scheduler::sizes_of(queues);
+
+	queues.post(messages::thunder_effect(always_predictable_v));
+
+	const auto ring_only = system_access().posts<messages::exploding_ring_effect>();
+	const auto with_thunder = system_access().posts<messages::exploding_ring_effect, messages::thunder_effect>();
+
+	REQUIRE(solve_scheduler::find_undeclared_post(ring_only, before, queues) == all_message_queues::index_of_v<messages::thunder_effect>);
+	REQUIRE(solve_scheduler::find_undeclared_post(with_thunder, before, queues) == std::nullopt);
+}
+#endif
@@ -0,0 +1,95 @@
+#pragma once
+#include <array>
+#include <vector>
+#include <optional>
+
+#include "game/cosmos/step_declaration.h"
+#include "game/cosmos/data_living_one_step.h"
+#include "game/cosmos/solvers/solve_structs.h"
+#include "game/cosmos/solvers/system_access.h"
+
+namespace augs {
+	class thread_pool;
+}
+
+struct scheduled_system {
+	using function_type = void(*)(logic_step);
+
+	const char* name = "";
+	system_access access;
+	function_type run = nullptr;
+};
+
+/*
+	An ordered list of systems, partitioned once into batches of consecutive systems
+	whose declared accesses do not conflict with each other.
+*/
+
+class system_schedule {
+	std::vector<scheduled_system> systems;
+	std::vector<std::vector<std::size_t>> batches;
+
+public:
+	system_schedule(std::vector<scheduled_system> systems);
+
+	const auto& get_systems() const {
+		return systems;
+	}
+
+	const auto& get_batches() const {
+		return batches;
+	}
+};
+
+/*
+	Runs a system_schedule of stateless systems,
+	dispatching consecutive non-conflicting systems concurrently to a thread pool.
+
+	Batches are always contiguous ranges of the serial order,
+	so two conflicting systems always execute in the order in which they were declared.
+
+	Each system that runs concurrently posts its messages into a private set of queues,
+	seeded with copies of the queues it declared to read.
+	Once the batch completes, newly posted messages are appended to the step's queues
+	in the declaration order, reproducing exactly what the serial run would have posted.
+*/
+
+class solve_scheduler {
+public:
+	using seeded_sizes = std::array<std::size_t, all_message_queues::num_queues_v>;
+
+	/* 
+		The first queue that grew past its seeded size even though the access does not declare posting to it.
+		Outside production builds, every scheduled system is checked with it after it runs.
+	*/
+
+	static std::optional<std::size_t> find_undeclared_post(
+		const system_access&,
+		const seeded_sizes& before,
+		const all_message_queues& after
+	);
+
+	static seeded_sizes sizes_of(const all_message_queues&);
+
+private:
+	struct task_context {
+		data_living_one_step transient;
+		seeded_sizes seeded;
+		solve_result result;
+	};
+
+	std::vector<task_context> contexts;
+
+	void run_batch(
+		const logic_step step,
+		const std::vector<scheduled_system>& systems,
+		const std::vector<std::size_t>& batch,
+		augs::thread_pool& pool
+	);
+
+public:
+	void run(
+		const logic_step step,
+		const system_schedule& schedule
+	);
+};
@@ -2,12 +2,42 @@
 #include "game/cosmos/entity_id.h"
 #include "game/detail/view_input/predictability_info.h"
 
+namespace augs {
+	class thread_pool;
+}
+
 struct solve_result {
 	bool state_inconsistent = false;
 };
 
+struct solve_parallelization {
+	/* 
+		If null, all systems run serially on the calling thread.
+		The pool must not be used by anything else during the solve.
+	*/
+
+	augs::thread_pool* pool = nullptr;
+
+	/*
+		Re-runs every step serially on a copy of the cosmos 
+		and compares the resulting solvable hashes. Very slow, for debugging only.
+	*/
+
+	bool verify_against_serial = false;
+};
+
 struct solve_settings {
 	effect_prediction_settings effect_prediction;
 	entity_id disable_knockouts;
 	bool simulate_decorative_organisms = true;
+
+	/*
+		If false, nothing purely audiovisual is generated during the solve -
+		no particles, sounds, thunders or exploding rings.
+		The significant state stays exactly the same as with the full solve.
+		Meant for dedicated servers that have nobody to show the effects to.
+	*/
+
+	bool generate_audiovisual_messages = true;
+	solve_parallelization parallelization;
 };
@@ -2,6 +2,8 @@
 #include "game/organization/all_component_includes.h"
 
 #include "game/cosmos/solvers/standard_solver.h"
+#include "game/cosmos/solvers/solve_scheduler.h"
+#include "game/cosmos/solvable_hash.h"
 #include "game/cosmos/cosmos.h"
 #include "game/cosmos/cosmic_functions.h"
 #include "game/cosmos/entity_handle.h"
@@ -37,13 +39,83 @@
 #include "game/stateless_systems/animation_system.h"
 #include "game/stateless_systems/remnant_system.h"
 
+#include "augs/log.h"
+#include "augs/templates/remove_cref.h"
+
 #define STRESS_TEST_REINFERENCES 0
 
 #if STRESS_TEST_REINFERENCES
 #include <random>
 #endif
 
+/*
+	Systems that are scheduled through solve_scheduler, with their declared access.
+	Everything that is not listed here runs serially, directly in standard_solve.
+
+	Before adding a system here, audit every code path it reaches -
+	a declaration that underestimates the access will break determinism between machines.
+*/
+
+static const auto post_physics_systems = system_schedule({
+	{
+		"lengthen_sprites_of_traces",
+		system_access().writes<components::trace>(),
+		[](const logic_step step) { trace_system().lengthen_sprites_of_traces(step); }
+	},
+	{
+		"integrate_crosshair_recoils",
+		system_access().writes<components::crosshair, components::sentience>(),
+		[](const logic_step step) { crosshair_system().integrate_crosshair_recoils(step); }
+	}
+});
+
+static const auto effect_systems = system_schedule({
+	{
+		"play_particles_from_events",
+		system_access()
+			.reads<components::rigid_body, components::transform, components::position, components::sender, components::item, components::sentience>()
+			.reads_messages<messages::gunshot_message, messages::damage_message, messages::health_event, messages::exhausted_cast>()
+			.posts<messages::start_particle_effect, messages::stop_particle_effect, messages::exploding_ring_effect, messages::thunder_effect>()
+		,
+		[](const logic_step step) {
+			if (step.get_settings().generate_audiovisual_messages) {
+				particles_existence_system().play_particles_from_events(step);
+			}
+		}
+	},
+	{
+		"displace_streams",
+		system_access()
+			.reads<components::rigid_body, components::transform, components::position, components::overridden_geo, components::sprite>()
+			.writes<components::continuous_particles>()
+			.uses_step_rng()
+		,
+		[](const logic_step step) { particles_existence_system().displace_streams(step); }
+	},
+	{
+		"play_sounds_from_events",
+		system_access()
+			.reads<components::rigid_body, components::transform, components::position, components::sender, components::item, components::sentience>()
+			.reads_messages<messages::collision_message, messages::gunshot_message, messages::damage_message, messages::health_event, messages::exhausted_cast>()
+			.posts<messages::start_sound_effect, messages::start_multi_sound_effect, messages::stop_sound_effect>()
+			.uses_step_rng()
+		,
+		[](const logic_step step) {
+			/*
+				Safe to skip even though it draws from the step rng:
+				nothing significant draws from it later in the step.
+			*/
+
+			if (step.get_settings().generate_audiovisual_messages) {
+				sound_existence_system().play_sounds_from_events(step);
+			}
+		}
+	}
+});
+
 void standard_solve(const logic_step step) {
+	thread_local solve_scheduler scheduler;
+
 	auto& cosm = step.get_cosmos();
 	auto& performance = cosm.profiler;
 	auto& global = cosm.get_global_solvable();
@@ -164,9 +236,7 @@ void standard_solve(const logic_step step) {
 
 	physics_system().post_and_clear_accumulated_collision_messages(step);
 
-	trace_system().lengthen_sprites_of_traces(step);
-
-	crosshair_system().integrate_crosshair_recoils(step);
+	scheduler.run(step, post_physics_systems);
 
 	item_system().pick_up_touching_items(step);
 
@@ -176,6 +246,7 @@ void standard_solve(const logic_step step) {
 		missile_system().ricochet_missiles(step);
 		missile_system().detonate_colliding_missiles(step);
 		missile_system().detonate_expired_missiles(step);
+		missile_system().advance_lightweight_projectiles(step);
 	}
 
 	destruction_system().generate_damages_from_forceful_collisions(step);
@@ -194,9 +265,7 @@ void standard_solve(const logic_step step) {
 	driver_system().assign_drivers_who_touch_wheels(step);
 	driver_system().release_drivers_due_to_ending_contact_with_wheel(step);
 
-	particles_existence_system().play_particles_from_events(step);
-	particles_existence_system().displace_streams(step);
-	sound_existence_system().play_sounds_from_events(step);
+	scheduler.run(step, effect_systems);
 
 #if TODO_VISIBILITY
 	{
@@ -241,3 +310,54 @@ void standard_solve(const logic_step step) {
 
 	ensure_eq(queued_at_end_num, queued_before_marking_num);
 }
+
+void standard_solve_verified_against_serial(const logic_step step) {
+	auto& cosm = step.get_cosmos();
+
+	auto serial_settings = step.get_settings();
+	serial_settings.parallelization = {};
+
+	const auto serial_cosm = std::make_unique<cosmos>(cosm);
+	auto serial_queues = step.transient;
+	auto serial_rng = step.step_rng;
+	auto serial_result = step.result;
+
+	standard_solve(logic_step(
+		{ *serial_cosm, step.get_entropy(), serial_settings }, 
+		serial_queues, 
+		serial_rng, 
+		serial_result
+	));
+
+	standard_solve(step);
+
+	const auto serial_hash = serial_cosm->calculate_solvable_signi_hash<uint32_t>();
+	const auto scheduled_hash = cosm.calculate_solvable_signi_hash<uint32_t>();
+
+	if (serial_hash != scheduled_hash) {
+		LOG("Scheduled solve diverged from the serial solve at step %x. Hashes: %x (serial) vs %x (scheduled)", cosm.get_total_steps_passed(), serial_hash, scheduled_hash);
+
+		solvable_hash_tree serial_tree;
+		solvable_hash_tree scheduled_tree;
+
+		serial_tree.rebuild(*serial_cosm);
+		scheduled_tree.rebuild(cosm);
+
+		if (const auto divergence = find_divergence(serial_tree, scheduled_tree)) {
+			LOG(divergence->describe());
+		}
+
+		step.result.state_inconsistent = true;
+	}
+
+	serial_queues.messages.for_each_queue([&](const std::size_t q_idx, const auto& serial_q) {
+		using M = typename remove_cref<decltype(serial_q)>::value_type;
+
+		const auto scheduled_num = step.get_queue<M>().size();
+
+		if (serial_q.size() != scheduled_num) {
+			LOG("Scheduled solve posted %x messages to queue %x, but the serial solve posted %x.", scheduled_num, q_idx, serial_q.size());
+			step.result.state_inconsistent = true;
+		}
+	});
+}
@@ -10,6 +10,7 @@
 #include "game/organization/all_messages_includes.h"
 
 void standard_solve(const logic_step step);
+void standard_solve_verified_against_serial(const logic_step step);
 
 struct standard_solver {
 	template <class C>
@@ -27,7 +28,14 @@ struct standard_solver {
 
 		cosmic::increment_step(input.cosm);
 		callbacks.pre_solve(step);
-		standard_solve(step);
+
+		if (input.settings.parallelization.verify_against_serial) {
+			standard_solve_verified_against_serial(step);
+		}
+		else {
+			standard_solve(step);
+		}
+
 		callbacks.post_solve(const_logic_step(step));
 		step.perform_deletions();
 		callbacks.post_cleanup(const_logic_step(step));
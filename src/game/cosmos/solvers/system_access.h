@@ -0,0 +1,99 @@
+#pragma once
+#include <bitset>
+
+#include "augs/templates/type_list.h"
+#include "augs/templates/folded_finders.h"
+#include "game/organization/all_components_declaration.h"
+#include "game/organization/all_messages_declaration.h"
+#include "augs/entity_system/storage_for_message_queues.h"
+
+/*
+	Declares what a stateless system touches during a single logic step.
+
+	The scheduler only ever lets two systems run concurrently if their declarations do not conflict,
+	so a declaration must be a superset of what the system actually does.
+	When in doubt, declare the system exclusive - it will then act as a barrier and run alone,
+	exactly where it would run in the serial order.
+
+	Rules for non-exclusive systems:
+		- they may write components in-place but must never create, delete or transfer entities;
+		- they may only append to the message queues they write, never erase or reorder messages;
+		- they must not step or query-and-modify the physics world;
+		- if they draw from step.step_rng, they must declare it with uses_step_rng().
+*/
+
+using component_access_set = std::bitset<num_types_in_list_v<component_list_t<type_list>>>;
+using message_access_set = std::bitset<all_message_queues::num_queues_v>;
+
+struct system_access {
+	component_access_set read_components;
+	component_access_set written_components;
+
+	message_access_set read_messages;
+	message_access_set written_messages;
+
+	bool step_rng = false;
+	bool exclusive = false;
+
+	template <class... C>
+	auto& reads() {
+		(read_components.set(index_in_list_v<C, component_list_t<type_list>>), ...);
+		return *this;
+	}
+
+	template <class... C>
+	auto& writes() {
+		(written_components.set(index_in_list_v<C, component_list_t<type_list>>), ...);
+		return *this;
+	}
+
+	template <class... M>
+	auto& reads_messages() {
+		(read_messages.set(all_message_queues::index_of_v<M>), ...);
+		return *this;
+	}
+
+	template <class... M>
+	auto& posts() {
+		(written_messages.set(all_message_queues::index_of_v<M>), ...);
+		return *this;
+	}
+
+	auto& uses_step_rng() {
+		step_rng = true;
+		return *this;
+	}
+
+	bool conflicts_with(const system_access& b) const {
+		if (exclusive || b.exclusive) {
+			return true;
+		}
+
+		if (step_rng && b.step_rng) {
+			return true;
+		}
+
+		const auto components_conflict =
+			(written_components & (b.written_components | b.read_components)).any()
+			|| (b.written_components & read_components).any()
+		;
+
+		/* 
+			Two systems may post to the same queue concurrently,
+			since the posted messages are later merged in the serial order anyway.
+		*/
+
+		const auto messages_conflict =
+			(written_messages & b.read_messages).any()
+			|| (b.written_messages & read_messages).any()
+		;
+
+		return components_conflict || messages_conflict;
+	}
+
+	static auto make_exclusive() {
+		system_access out;
+		out.exclusive = true;
+		return out;
+	}
+};
@@ -1,6 +1,7 @@
 #pragma once
 #include "augs/templates/folded_finders.h"
 #include "augs/templates/for_each_std_get.h"
+#include "augs/templates/for_each_type.h"
 
 #include "game/cosmos/component_synchronizer.h"
 #include "game/cosmos/entity_pools.h"
@@ -23,7 +24,7 @@ private:
 	using E = entity_type_of<derived_handle_type>;
 	static constexpr bool is_const = is_handle_const_v<derived_handle_type>;
 
-	using subject_reference = maybe_const_ref_t<is_const, entity_solvable<E>>;
+	using subject_reference = maybe_const_ref_t<is_const, entity_subject_t<E>>;
 
 	subject_reference subject;
 	const unsigned iteration_index;
@@ -90,7 +91,7 @@ private:
 	static constexpr bool is_const = is_handle_const_v<derived_handle_type>;
 
 	using id_type = typed_entity_id<E>;
-	using subject_pointer = maybe_const_ptr_t<is_const, entity_solvable<E>>;
+	using subject_pointer = maybe_const_ptr_t<is_const, entity_subject_t<E>>;
 
 protected:
 	const subject_pointer subject;
@@ -161,7 +162,7 @@ private:
 
 	using id_type = typed_entity_id<E>;
 
-	using subject_reference = maybe_const_ref_t<is_const, entity_solvable<E>>;
+	using subject_reference = maybe_const_ref_t<is_const, entity_subject_t<E>>;
 	const subject_reference subject;
 	
 	const id_type stored_id;
@@ -270,12 +271,27 @@ public:
 private:
 	owner_reference owner;
 
+	template <class T>
+	maybe_const_ref_t<is_const, T> get_raw_component_impl() const {
+		if constexpr(is_soa_entity_v<entity_type>) {
+			auto& pool = owner.get_solvable({}).significant.template get_pool<entity_type>();
+			return pool.template get<T>(get_subject());
+		}
+		else {
+			return get_subject().template get<T>();
+		}
+	}
+
 	template <class T>
 	maybe_const_ptr_t<is_const, T> find_component_ptr() const {
 		if constexpr(subject_type::template has<T>()) {
 			ensure_alive();
 
-			return std::addressof(get_subject().template get<T>());
+			if constexpr(!is_const) {
+				owner.mark_modified(this->get_id());
+			}
+
+			return std::addressof(get_raw_component_impl<T>());
 		}
 
 		return nullptr;
@@ -298,10 +314,58 @@ public:
 		return static_cast<const entity_solvable_meta&>(get_subject());
 	};
 
+	/* Hides the provider's accessor so that raw writes are dirty-tracked just like component writes. */
+	auto& get(cosmos_solvable_access key) const {
+		if constexpr(!is_const) {
+			owner.mark_modified(this->get_id());
+		}
+
+		return used_identifier_provider::get(key);
+	}
+
 	const auto& get_pool() const {
 		return get_cosmos().get_solvable().significant.template get_pool<entity_type>();
 	}
 
+	/* 
+		Access a component directly, bypassing its synchronizer.
+		Works regardless of the pool storage of the entity type.
+	*/
+
+	template <class T>
+	const T& get_raw_component() const {
+		static_assert(subject_type::template has<T>());
+
+		ensure_alive();
+		return std::as_const(get_raw_component_impl<T>());
+	}
+
+	template <class T>
+	auto& get_raw_component(cosmos_solvable_access) const {
+		static_assert(subject_type::template has<T>());
+
+		ensure_alive();
+
+		if constexpr(!is_const) {
+			owner.mark_modified(this->get_id());
+		}
+
+		return get_raw_component_impl<T>();
+	}
+
+	/* A copy of the whole entity, e.g. to be restored later with cosmic::undo_delete_entity. */
+	auto assemble_solvable() const {
+		ensure_alive();
+
+		if constexpr(is_soa_entity_v<entity_type>) {
+			const auto& pool = get_pool();
+			return pool.assemble_nth(static_cast<decltype(pool.size())>(std::addressof(get_subject()) - pool.data()));
+		}
+		else {
+			return subject_type(get_subject());
+		}
+	}
+
 	template <class T>
 	static constexpr bool has() {
 		return has_all_of_v<entity_type, T>;
@@ -399,12 +463,21 @@ public:
 	template <class F>
 	void for_each_component(F&& callback) const {
 		ensure_alive();
-		const auto& immutable_subject = get_subject();
 
-		for_each_through_std_get(
-			immutable_subject.component_state, 
-			std::forward<F>(callback)
-		);
+		if constexpr(is_soa_entity_v<entity_type>) {
+			for_each_type_in_list<components_of<entity_type>>([&](auto tag) {
+				using T = decltype(tag);
+				callback(std::as_const(get_raw_component_impl<T>()));
+			});
+		}
+		else {
+			const auto& immutable_subject = get_subject();
+
+			for_each_through_std_get(
+				immutable_subject.component_state, 
+				std::forward<F>(callback)
+			);
+		}
 	}
 
 	/* For compatibility with the general handle */
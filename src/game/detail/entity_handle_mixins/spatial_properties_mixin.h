@@ -28,20 +28,19 @@ public:
 
 		if constexpr(E::is_specific) {
 			const auto& handle = *static_cast<const entity_handle_type*>(this);
-			auto& components = handle.get(keys...).component_state;
 
 			if constexpr(E::template has<components::rigid_body>()) {
 				if (!has_independent_transform()) {
 					return;
 				}
 
-				callback(std::get<components::rigid_body>(components).physics_transforms);
+				callback(handle.template get_raw_component<components::rigid_body>(keys...).physics_transforms);
 			}
 			else if constexpr(E::template has<components::transform>()) {
-				callback(std::get<components::transform>(components));
+				callback(handle.template get_raw_component<components::transform>(keys...));
 			}
 			else if constexpr(E::template has<components::position>()) {
-				callback(std::get<components::position>(components));
+				callback(handle.template get_raw_component<components::position>(keys...));
 			}
 		}
 		else {
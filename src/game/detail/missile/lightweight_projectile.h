@@ -0,0 +1,38 @@
+#pragma once
+#include <vector>
+
+#include "augs/math/vec2.h"
+#include "augs/misc/timing/stepped_timing.h"
+
+#include "game/components/sender_component.h"
+#include "game/components/missile_component.h"
+#include "game/components/cartridge_component.h"
+
+/*
+	A round fired by a gun with invariants::gun::fires_lightweight_projectiles set.
+
+	It is neither an entity nor a Box2D body.
+	All projectiles live in a flat array in the global solvable,
+	and missile_system::advance_lightweight_projectiles sweeps each of them every step
+	with a ray cast against the physics world.
+
+	Everything that does not change in flight is read from the round flavour.
+*/
+
+struct lightweight_projectile {
+	// GEN INTROSPECTOR struct lightweight_projectile
+	invariants::cartridge::round_flavour_type round_flavour;
+	components::sender sender;
+
+	vec2 pos;
+	vec2 vel;
+
+	int damage_charges_before_destruction = 1;
+	real32 power_multiplier_of_sender = 1.f;
+
+	augs::stepped_timestamp when_fired;
+	augs::stepped_timestamp when_last_ricocheted;
+	// END GEN INTROSPECTOR
+};
+
+using lightweight_projectiles_type = std::vector<lightweight_projectile>;
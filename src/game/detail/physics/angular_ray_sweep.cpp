@@ -0,0 +1,350 @@
+#include <algorithm>
+
+#include "3rdparty/Box2D/Box2D.h"
+
+#include "game/detail/physics/angular_ray_sweep.h"
+
+/*
+	Widens the angular spans of the fixtures,
+	so that the rays grazing their silhouettes are tested against them despite the rounding errors.
+	A fixture tested needlessly is only a wasted test, never a wrong hit.
+*/
+
+static constexpr real32 span_epsilon_v = 0.0005f;
+
+bool angular_ray_sweep::event::operator<(const event& b) const {
+	if (angle != b.angle) {
+		return angle < b.angle;
+	}
+
+	if (type != b.type) {
+		return type < b.type;
+	}
+
+	return index < b.index;
+}
+
+void angular_ray_sweep::reset(const vec2 origin_meters) {
+	origin = origin_meters;
+
+	fixtures.clear();
+	fixture_events.clear();
+	initially_active.clear();
+	always_active.clear();
+}
+
+void angular_ray_sweep::add_fixture(const b2Fixture& f) {
+	const auto& shape = *f.GetShape();
+
+	if (shape.GetType() != b2Shape::e_polygon) {
+		return;
+	}
+
+	const auto fixture_index = static_cast<int>(fixtures.size());
+	fixtures.push_back(std::addressof(f));
+
+	if (f.TestPoint(b2Vec2(origin))) {
+		/*
+			Rays starting inside a polygon never hit it,
+			but let the actual ray cast decide about the ones starting right at its boundary.
+		*/
+
+		always_active.push_back(fixture_index);
+		return;
+	}
+
+	const auto& poly = static_cast<const b2PolygonShape&>(shape);
+	const auto xf = f.GetBody()->GetTransform();
+
+	/*
+		The origin is outside of the convex polygon,
+		so the polygon spans less than a half-turn as seen from the origin.
+		Measure the span relatively to the first vertex so that it can be found even if it crosses (-2, 2].
+	*/
+
+	const auto first_angle = comparable_angle(vec2(b2Mul(xf, poly.GetVertex(0))) - origin);
+
+	real32 min_delta = 0.f;
+	real32 max_delta = 0.f;
+
+	for (int i = 1; i < poly.GetVertexCount(); ++i) {
+		auto delta = comparable_angle(vec2(b2Mul(xf, poly.GetVertex(i))) - origin) - first_angle;
+
+		if (delta > 2.f) {
+			delta -= 4.f;
+		}
+		else if (delta <= -2.f) {
+			delta += 4.f;
+		}
+
+		min_delta = std::min(min_delta, delta);
+		max_delta = std::max(max_delta, delta);
+	}
+
+	const auto lower = first_angle + min_delta - span_epsilon_v;
+	const auto upper = first_angle + max_delta + span_epsilon_v;
+
+	if (upper - lower >= 2.f) {
+		/* Only possible if the origin is practically at the boundary. */
+		always_active.push_back(fixture_index);
+		return;
+	}
+
+	auto add_event = [&](const real32 angle, const event_type type) {
+		fixture_events.push_back({ angle, type, fixture_index });
+	};
+
+	if (upper > 2.f) {
+		initially_active.push_back(fixture_index);
+		add_event(upper - 4.f, event_type::REMOVE_FIXTURE);
+		add_event(lower, event_type::ADD_FIXTURE);
+	}
+	else if (lower < -2.f) {
+		initially_active.push_back(fixture_index);
+		add_event(upper, event_type::REMOVE_FIXTURE);
+		add_event(lower + 4.f, event_type::ADD_FIXTURE);
+	}
+	else {
+		add_event(lower, event_type::ADD_FIXTURE);
+		add_event(upper, event_type::REMOVE_FIXTURE);
+	}
+}
+
+void angular_ray_sweep::activate(const int fixture_index) {
+	auto& idx = index_in_active[fixture_index];
+
+	if (idx == -1) {
+		idx = static_cast<int>(active.size());
+		active.push_back(fixture_index);
+	}
+}
+
+void angular_ray_sweep::deactivate(const int fixture_index) {
+	auto& idx = index_in_active[fixture_index];
+
+	if (idx != -1) {
+		const auto moved = active.back();
+
+		active[idx] = moved;
+		index_in_active[moved] = idx;
+		active.pop_back();
+
+		idx = -1;
+	}
+}
+
+void angular_ray_sweep::ray_cast(
+	const std::vector<vec2>& destinations_meters,
+	std::vector<physics_raycast_output>& outputs
+) {
+	outputs.clear();
+	outputs.resize(destinations_meters.size());
+
+	events = fixture_events;
+
+	for (std::size_t i = 0; i < destinations_meters.size(); ++i) {
+		const auto diff = destinations_meters[i] - origin;
+
+		if (!(diff.length_sq() > 0.f)) {
+			/* physics_world_cache::ray_cast doesn't hit anything with such rays either. */
+			continue;
+		}
+
+		events.push_back({ comparable_angle(diff), event_type::CAST_RAY, static_cast<int>(i) });
+	}
+
+	std::sort(events.begin(), events.end());
+
+	active.clear();
+	index_in_active.assign(fixtures.size(), -1);
+
+	for (const auto f : initially_active) {
+		activate(f);
+	}
+
+	b2RayCastInput input;
+	input.p1 = b2Vec2(origin);
+
+	auto test = [&](const int fixture_index, physics_raycast_output& output) {
+		const auto& fixture = *fixtures[fixture_index];
+
+		b2RayCastOutput result;
+
+		/* Clip the ray to the closest hit so far, like b2World::RayCast does. */
+
+		if (fixture.RayCast(&result, input, 0)) {
+			const auto fraction = result.fraction;
+			const auto point = (1.0f - fraction) * input.p1 + fraction * input.p2;
+
+			output.hit = true;
+			output.intersection = point;
+			output.normal = result.normal;
+			output.what_entity = fixture.GetBody()->GetUserData();
+
+			input.maxFraction = fraction;
+		}
+	};
+
+	for (const auto& e : events) {
+		switch (e.type) {
+			case event_type::ADD_FIXTURE:
+				activate(e.index);
+				break;
+
+			case event_type::REMOVE_FIXTURE:
+				deactivate(e.index);
+				break;
+
+			case event_type::CAST_RAY: {
+				auto& output = outputs[e.index];
+
+				input.p2 = b2Vec2(destinations_meters[e.index]);
+				input.maxFraction = 1.f;
+
+				for (const auto f : always_active) {
+					test(f, output);
+				}
+
+				for (const auto f : active) {
+					test(f, output);
+				}
+
+				break;
+			}
+
+			default: break;
+		}
+	}
+}
+
+void angular_ray_sweep::ray_cast_all_intersections(
+	const vec2 p1_meters,
+	const vec2 p2_meters,
+	std::vector<physics_raycast_output>& outputs
+) const {
+	outputs.clear();
+
+	if (!((p1_meters - p2_meters).length_sq() > 0.f)) {
+		return;
+	}
+
+	b2RayCastInput input;
+	input.p1 = b2Vec2(p1_meters);
+	input.p2 = b2Vec2(p2_meters);
+	input.maxFraction = 1.f;
+
+	for (const auto f : fixtures) {
+		b2RayCastOutput result;
+
+		if (f->RayCast(&result, input, 0)) {
+			const auto fraction = result.fraction;
+
+			physics_raycast_output output;
+			output.hit = true;
+			output.intersection = (1.0f - fraction) * input.p1 + fraction * input.p2;
+			output.normal = result.normal;
+			output.what_entity = f->GetBody()->GetUserData();
+
+			outputs.push_back(output);
+		}
+	}
+}
+
+#if BUILD_UNIT_TESTS
+#include <Catch/single_include/catch2/catch.hpp>
+#include "augs/misc/randomization.h"
+#include "game/detail/physics/make_crowded_b2world.h"
+
+TEST_CASE("AngularRaySweep SameHitsAsWorldRayCast") {
+	b2World world(b2Vec2(0.f, 0.f));
+	make_crowded_b2world(world, 400);
+
+	for (int i = 0; i < 30; ++i) {
+		world.Step(1 / 60.f, 8, 3);
+	}
+
+	struct closest_polygon_hit : b2RayCastCallback {
+		bool hit = false;
+		b2Vec2 point;
+
+		bool ShouldRaycast(b2Fixture* const f) override {
+			return f->GetShape()->GetType() == b2Shape::e_polygon;
+		}
+
+		float32 ReportFixture(b2Fixture*, const b2Vec2& p, const b2Vec2&, const float32 fraction) override {
+			hit = true;
+			point = p;
+			return fraction;
+		}
+	};
+
+	struct all_fixtures : b2QueryCallback {
+		std::vector<const b2Fixture*> found;
+
+		bool ReportFixture(b2Fixture* const f) override {
+			found.push_back(f);
+			return true;
+		}
+	};
+
+	auto rng = randomization(1337);
+	angular_ray_sweep sweep;
+
+	std::vector<vec2> destinations;
+	std::vector<physics_raycast_output> outputs;
+
+	for (int o = 0; o < 20; ++o) {
+		const auto origin = vec2(rng.randval(-9.f, 9.f), rng.randval(-9.f, 9.f));
+
+		b2AABB aabb;
+		aabb.lowerBound = b2Vec2(origin - vec2(15.f, 15.f));
+		aabb.upperBound = b2Vec2(origin + vec2(15.f, 15.f));
+
+		all_fixtures query;
+		world.QueryAABB(&query, aabb);
+
+		sweep.reset(origin);
+		destinations.clear();
+
+		for (const auto f : query.found) {
+			sweep.add_fixture(*f);
+
+			if (f->GetShape()->GetType() == b2Shape::e_polygon) {
+				/* Rays grazing the silhouettes are the hardest to get right. */
+
+				const auto& poly = static_cast<const b2PolygonShape&>(*f->GetShape());
+				const auto xf = f->GetBody()->GetTransform();
+
+				for (int v = 0; v < poly.GetVertexCount(); ++v) {
+					const auto vert = vec2(b2Mul(xf, poly.GetVertex(v)));
+					const auto dir = (vert - origin).normalize();
+
+					destinations.push_back(origin + dir * 14.f);
+					destinations.push_back(origin + (dir + dir.perpendicular_cw() * 0.0001f).normalize() * 14.f);
+					destinations.push_back(origin + (dir - dir.perpendicular_cw() * 0.0001f).normalize() * 14.f);
+				}
+			}
+		}
+
+		for (int r = 0; r < 500; ++r) {
+			destinations.push_back(origin + vec2::from_degrees(rng.randval(0.f, 360.f)) * rng.randval(0.1f, 14.f));
+		}
+
+		sweep.ray_cast(destinations, outputs);
+
+		REQUIRE(outputs.size() == destinations.size());
+
+		for (std::size_t i = 0; i < destinations.size(); ++i) {
+			closest_polygon_hit expected;
+			world.RayCast(&expected, b2Vec2(origin), b2Vec2(destinations[i]));
+
+			REQUIRE(outputs[i].hit == expected.hit);
+
+			if (expected.hit) {
+				REQUIRE(outputs[i].intersection.x == expected.point.x);
+				REQUIRE(outputs[i].intersection.y == expected.point.y);
+			}
+		}
+	}
+}
+#endif
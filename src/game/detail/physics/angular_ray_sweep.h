@@ -0,0 +1,91 @@
+#pragma once
+#include <vector>
+#include "augs/math/vec2.h"
+#include "augs/math/repro_math.h"
+#include "game/inferred_caches/physics_world_cache.h"
+
+class b2Fixture;
+
+/*
+	Thanks to:
+	https://stackoverflow.com/questions/16542042/fastest-way-to-sort-vectors-by-angle-without-actually-computing-that-angle
+
+	Monotonic in the actual angle, in the range of (-2, 2].
+	Opposite directions always differ by exactly 2.
+*/
+
+FORCE_INLINE auto comparable_angle(const vec2 diff) {
+	return repro::copysignf(
+		1 - diff.x / (repro::fabs(diff.x) + repro::fabs(diff.y)), diff.y
+	);
+}
+
+/*
+	Casts many rays from a single origin against a fixed set of fixtures,
+	without going through the broadphase of the b2World for every ray.
+
+	The fixtures and the rays are swept together in the order of their angles around the origin,
+	so every ray is tested only against the fixtures whose angular span contains it.
+	The test itself is the same b2Fixture::RayCast that b2World::RayCast performs,
+	so the closest hits are the same as if every ray was cast through the world.
+
+	Fixtures can overlap each other, so the active ones are not ordered by their distance -
+	a ray is tested against all of them, which in practice is only a few.
+*/
+
+class angular_ray_sweep {
+	enum class event_type {
+		// Ordered so that a ray at the exact angle where a fixture's span ends is still tested against it.
+		ADD_FIXTURE,
+		CAST_RAY,
+		REMOVE_FIXTURE
+	};
+
+	struct event {
+		real32 angle;
+		event_type type;
+		int index;
+
+		bool operator<(const event& b) const;
+	};
+
+	vec2 origin;
+
+	std::vector<const b2Fixture*> fixtures;
+	std::vector<event> fixture_events;
+	std::vector<event> events;
+
+	std::vector<int> initially_active;
+	std::vector<int> always_active;
+
+	std::vector<int> active;
+	std::vector<int> index_in_active;
+
+	void activate(int fixture_index);
+	void deactivate(int fixture_index);
+
+public:
+	void reset(vec2 origin_meters);
+
+	/* Only polygon fixtures are supported. */
+	void add_fixture(const b2Fixture&);
+
+	std::size_t get_num_fixtures() const {
+		return fixtures.size();
+	}
+
+	/* Writes the closest hit of the ray from the origin to each destination. */
+
+	void ray_cast(
+		const std::vector<vec2>& destinations_meters,
+		std::vector<physics_raycast_output>& outputs
+	);
+
+	/* Like physics_world_cache::ray_cast_all_intersections, but only against the added fixtures. */
+
+	void ray_cast_all_intersections(
+		vec2 p1_meters,
+		vec2 p2_meters,
+		std::vector<physics_raycast_output>& outputs
+	) const;
+};
@@ -0,0 +1,91 @@
+#pragma once
+#include <cmath>
+#include <cstring>
+#include "3rdparty/Box2D/Box2D.h"
+
+/*
+	A closed box densely filled with small bodies pushed against each other by gravity,
+	so that stepping it keeps thousands of contacts alive.
+
+	Used to measure and test cloning of the b2World.
+*/
+
+inline void make_crowded_b2world(b2World& world, const unsigned num_bodies) {
+	auto make_def = [](const b2BodyType type, const b2Vec2 pos, const float angle) {
+		b2BodyDef def;
+		def.type = type;
+		def.transform.Set(pos, angle);
+
+		def.sweep.localCenter.SetZero();
+		def.sweep.c0 = def.sweep.c = pos;
+		def.sweep.a0 = def.sweep.a = angle;
+		def.sweep.alpha0 = 0.f;
+
+		return def;
+	};
+
+	world.SetGravity(b2Vec2(0.f, -10.f));
+
+	const auto half_size = 0.5f * std::sqrt(static_cast<float>(num_bodies));
+
+	{
+		const auto def = make_def(b2_staticBody, b2Vec2(0.f, 0.f), 0.f);
+		const auto walls = world.CreateBody(&def);
+
+		b2PolygonShape wall;
+
+		wall.SetAsBox(half_size, 1.f, b2Vec2(0.f, -half_size), 0.f);
+		walls->CreateFixture(&wall, 0.f);
+		wall.SetAsBox(half_size, 1.f, b2Vec2(0.f, half_size), 0.f);
+		walls->CreateFixture(&wall, 0.f);
+		wall.SetAsBox(1.f, half_size, b2Vec2(-half_size, 0.f), 0.f);
+		walls->CreateFixture(&wall, 0.f);
+		wall.SetAsBox(1.f, half_size, b2Vec2(half_size, 0.f), 0.f);
+		walls->CreateFixture(&wall, 0.f);
+	}
+
+	const auto per_row = static_cast<unsigned>(std::sqrt(static_cast<float>(num_bodies))) + 1;
+	const auto spacing = (2 * half_size - 2.f) / per_row;
+
+	for (unsigned i = 0; i < num_bodies; ++i) {
+		const auto pos = b2Vec2(
+			-half_size + 1.f + spacing * (i % per_row + 0.5f),
+			-half_size + 1.f + spacing * (i / per_row + 0.5f)
+		);
+
+		auto def = make_def(b2_dynamicBody, pos, 0.1f * i);
+		def.linearVelocity.Set(static_cast<float>(i % 7) - 3.f, static_cast<float>(i % 5) - 2.f);
+
+		const auto body = world.CreateBody(&def);
+
+		if (i % 2) {
+			b2CircleShape shape;
+			shape.m_radius = 0.45f * spacing;
+			body->CreateFixture(&shape, 1.f);
+		}
+		else {
+			b2PolygonShape shape;
+			shape.SetAsBox(0.4f * spacing, 0.4f * spacing);
+			body->CreateFixture(&shape, 1.f);
+		}
+	}
+}
+
+/* Compares the transforms and velocities of all bodies bit by bit. */
+
+inline bool b2world_bodies_identical(const b2World& a, const b2World& b) {
+	auto ba = a.GetBodyList();
+	auto bb = b.GetBodyList();
+
+	for (; ba != nullptr && bb != nullptr; ba = ba->GetNext(), bb = bb->GetNext()) {
+		if (std::memcmp(&ba->GetTransform(), &bb->GetTransform(), sizeof(b2Transform))) {
+			return false;
+		}
+
+		if (std::memcmp(&ba->GetLinearVelocity(), &bb->GetLinearVelocity(), sizeof(b2Vec2))) {
+			return false;
+		}
+	}
+
+	return ba == nullptr && bb == nullptr && a.GetContactCount() == b.GetContactCount();
+}
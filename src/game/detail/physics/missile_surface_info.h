@@ -19,12 +19,36 @@ public:
 		const A missile,
 		const B surface
 	) {
-		const auto& missile_sender = missile.template get<components::sender>();
+		calc(
+			missile.template get<components::sender>(),
+			missile.template has<components::missile>(),
+			missile.template has<components::melee>(),
+			surface
+		);
+	}
+
+	/* For lightweight projectiles, which behave like missiles but have no entity. */
 
-		if ((missile.template has<components::missile>() 
+	template <class B>
+	missile_surface_info(
+		const components::sender& projectile_sender,
+		const B surface
+	) {
+		calc(projectile_sender, true, false, surface);
+	}
+
+private:
+	template <class B>
+	void calc(
+		const components::sender& missile_sender,
+		const bool missile_is_missile,
+		const bool missile_is_melee,
+		const B surface
+	) {
+		if ((missile_is_missile
 			&& surface.template has<components::missile>())
 			||
-			(missile.template has<components::melee>() 
+			(missile_is_melee
 			&& surface.template has<components::melee>())
 		) {
 			/* Prevent bullets coming from the same weapon or character from colliding with each other */
@@ -57,6 +81,8 @@ public:
 		is_fly_through = surface_is_missile || ignore_altogether || surface_is_lying_item || surface.template get<invariants::fixtures>().bullets_fly_through;
 	}
 
+public:
+
 	bool should_ignore_altogether() const {
 		return ignore_altogether;
 	}
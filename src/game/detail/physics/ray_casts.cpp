@@ -1,3 +1,5 @@
+#include <algorithm>
+
 #include "game/inferred_caches/physics_world_cache.h"
 #include "game/cosmos/cosmos.h"
 #include "game/cosmos/entity_handle.h"
@@ -64,6 +66,78 @@ std::vector<physics_raycast_output> physics_world_cache::ray_cast_all_intersecti
 	return callback.outputs;
 }
 
+struct sweep_input : public b2RayCastCallback {
+	b2Filter subject_filter;
+	std::vector<physics_sweep_hit>& hits;
+
+	sweep_input(const b2Filter subject_filter, std::vector<physics_sweep_hit>& hits) :
+		subject_filter(subject_filter),
+		hits(hits)
+	{}
+
+	bool ShouldRaycast(b2Fixture* const fixture) override {
+		return b2ContactFilter::ShouldCollide(&subject_filter, &fixture->GetFilterData());
+	}
+
+	float32 ReportFixture(
+		b2Fixture* const fixture, 
+		const b2Vec2& point,
+		const b2Vec2& normal, 
+		const float32 fraction
+	) override {
+		physics_sweep_hit hit;
+
+		hit.fraction = fraction;
+		hit.intersection = point;
+		hit.normal = normal;
+		hit.what_entity = fixture->GetBody()->GetUserData();
+		hit.what_fixture.convex_shape_index = static_cast<std::size_t>(fixture->index_in_component);
+
+		hits.push_back(hit);
+		return 1.f;
+	}
+};
+
+void physics_world_cache::sweep_segment(
+	const vec2 p1_meters, 
+	const vec2 p2_meters, 
+	const b2Filter filter, 
+	std::vector<physics_sweep_hit>& hits
+) const {
+	hits.clear();
+
+	if (!((p1_meters - p2_meters).length_sq() > 0.f)) {
+		return;
+	}
+
+	sweep_input callback(filter, hits);
+	b2world->RayCast(&callback, b2Vec2(p1_meters), b2Vec2(p2_meters));
+
+	auto ordering = [](const physics_sweep_hit& a, const physics_sweep_hit& b) {
+		if (a.fraction != b.fraction) {
+			return a.fraction < b.fraction;
+		}
+
+		const auto at = a.what_entity.type_id.get_index();
+		const auto bt = b.what_entity.type_id.get_index();
+
+		if (at != bt) {
+			return at < bt;
+		}
+
+		const auto ai = a.what_entity.raw.indirection_index;
+		const auto bi = b.what_entity.raw.indirection_index;
+
+		if (ai != bi) {
+			return ai < bi;
+		}
+
+		return a.what_fixture.convex_shape_index < b.what_fixture.convex_shape_index;
+	};
+
+	std::sort(hits.begin(), hits.end(), ordering);
+}
+
 float physics_world_cache::get_closest_wall_intersection(
 	const si_scaling si,
 	const vec2 position, 
@@ -267,7 +267,9 @@ void standard_explosion_input::instantiate(
 		);
 	}
 
-	// TODO_PERFORMANCE: This code is unnecessary for the server
+	if (step.skips_messages_of_type<messages::exploding_ring_effect>()) {
+		return;
+	}
 
 	{
 		auto msg = messages::exploding_ring_effect(predictability);
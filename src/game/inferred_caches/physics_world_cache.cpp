@@ -213,11 +213,32 @@ physics_world_cache& physics_world_cache::operator=(const physics_world_cache&)
 	return *this;
 }
 
-void physics_world_cache::clone_from(const physics_world_cache& source_cache, cosmos& target_cosm, const cosmos& source_cosm) {
-	ensure(std::addressof(target_cosm) != std::addressof(source_cosm));
-	ensure(this != std::addressof(source_cache));
+struct b2world_pointer_migrations {
+	b2world_clone_method method = b2world_clone_method::ARENA;
 
-	accumulated_messages = source_cache.accumulated_messages;
+	b2BlockRelocation arena;
+	std::unordered_map<const void*, void*> per_object;
+
+	void* migrate(const void* const source) const {
+		if (method == b2world_clone_method::ARENA) {
+			return arena.Relocate(source);
+		}
+
+		return per_object.at(source);
+	}
+};
+
+void physics_world_cache::clone_b2world_from(const physics_world_cache& source_cache, const b2world_clone_method method) {
+	b2world_pointer_migrations pointer_migrations;
+	clone_b2world_from(source_cache, method, pointer_migrations);
+}
+
+void physics_world_cache::clone_b2world_from(
+	const physics_world_cache& source_cache, 
+	const b2world_clone_method method,
+	b2world_pointer_migrations& pointer_migrations
+) {
+	ensure(this != std::addressof(source_cache));
 
 	b2World& migrated_b2World = *b2world.get();
 	migrated_b2World.~b2World();
@@ -263,7 +284,29 @@ void physics_world_cache::clone_from(const physics_world_cache& source_cache, co
 	migrated_b2World.m_contactManager.m_contactFilter = &migrated_b2World.defaultFilter;
 	migrated_b2World.m_contactManager.m_contactListener = &migrated_b2World.defaultListener;
 
-	std::unordered_map<const void*, void*> pointer_migrations;
+	pointer_migrations.method = method;
+
+	if (method == b2world_clone_method::ARENA) {
+		ensure(source_b2World.m_blockAllocator.IsRelocatable());
+		migrated_b2World.CloneObjectsFrom(source_b2World, pointer_migrations.arena);
+	}
+	else {
+		clone_objects_one_by_one(migrated_b2World, pointer_migrations);
+	}
+
+#if DEBUG_PHYSICS_SYSTEM_COPY
+	// ensure that all allocations have been migrated
+
+	ensure_eq(
+		migrated_b2World.m_blockAllocator.m_numAllocatedObjects, 
+		source_b2World.m_blockAllocator.m_numAllocatedObjects
+	);
+#endif
+}
+
+void physics_world_cache::clone_objects_one_by_one(b2World& migrated_b2World, b2world_pointer_migrations& migrations) {
+	auto& pointer_migrations = migrations.per_object;
+
 	std::unordered_map<const void*, bool> contact_edge_a_or_b_in_contacts;
 	std::unordered_map<const void*, bool> joint_edge_a_or_b_in_joints;
 
@@ -533,6 +576,26 @@ void physics_world_cache::clone_from(const physics_world_cache& source_cache, co
 		as for every existing b2FixtureProxy we have manually migrated the correspondent userdata
 		inside the loop that migrated all bodies and fixtures.
 	*/
+}
+
+void physics_world_cache::clone_from(const physics_world_cache& source_cache, cosmos& target_cosm, const cosmos& source_cosm) {
+	ensure(std::addressof(target_cosm) != std::addressof(source_cosm));
+
+	accumulated_messages = source_cache.accumulated_messages;
+
+	/*
+		Only a world with an allocation that did not fit into the block allocator's chunks
+		(e.g. a fixture of a chain shape with very many children) has to be cloned one object at a time.
+	*/
+
+	const auto method = 
+		source_cache.get_b2world().m_blockAllocator.IsRelocatable() 
+		? b2world_clone_method::ARENA
+		: b2world_clone_method::PER_OBJECT
+	;
+
+	b2world_pointer_migrations pointer_migrations;
+	clone_b2world_from(source_cache, method, pointer_migrations);
 
 	target_cosm.for_each_having<invariants::fixtures>(
 		[&](const auto& typed_collider) {
@@ -551,7 +614,7 @@ void physics_world_cache::clone_from(const physics_world_cache& source_cache, co
 
 						for (const auto& f : source_cache.constructed_fixtures) {
 							migrated_cache.constructed_fixtures.emplace_back(
-								reinterpret_cast<b2Fixture*>(pointer_migrations.at(reinterpret_cast<const void*>(f.get())))
+								reinterpret_cast<b2Fixture*>(pointer_migrations.migrate(reinterpret_cast<const void*>(f.get())))
 							);
 						}
 					}
@@ -565,7 +628,7 @@ void physics_world_cache::clone_from(const physics_world_cache& source_cache, co
 						static_assert(sizeof(migrated_cache) == sizeof(augs::propagate_const<b2Body*>));
 
 						if (b_body) {
-							migrated_cache.body = reinterpret_cast<b2Body*>(pointer_migrations.at(reinterpret_cast<const void*>(b_body)));
+							migrated_cache.body = reinterpret_cast<b2Body*>(pointer_migrations.migrate(reinterpret_cast<const void*>(b_body)));
 						}
 						else {
 							migrated_cache.body = nullptr;
@@ -584,17 +647,59 @@ void physics_world_cache::clone_from(const physics_world_cache& source_cache, co
 		const auto b_joint = source_cache.joint_caches[it.first].joint.get();
 
 		if (b_joint) {
-			joint_caches[i].joint = reinterpret_cast<b2Joint*>(pointer_migrations.at(reinterpret_cast<const void*>(b_joint)));
+			joint_caches[i].joint = reinterpret_cast<b2Joint*>(pointer_migrations.migrate(reinterpret_cast<const void*>(b_joint)));
 		}
 	}
 #endif
 
-#if DEBUG_PHYSICS_SYSTEM_COPY
-	// ensure that all allocations have been migrated
+}
 
-	ensure_eq(
-		migrated_allocator.m_numAllocatedObjects, 
-		source_b2World.m_blockAllocator.m_numAllocatedObjects
-	);
-#endif
+#if BUILD_UNIT_TESTS
+#include <Catch/single_include/catch2/catch.hpp>
+#include "game/detail/physics/make_crowded_b2world.h"
+
+TEST_CASE("PhysicsWorldCache ClonesStepIdentically") {
+	const auto dt = 1 / 60.f;
+
+	auto step = [dt](physics_world_cache& cache, const unsigned steps) {
+		for (unsigned i = 0; i < steps; ++i) {
+			cache.get_b2world().Step(dt, 8, 3);
+		}
+	};
+
+	for (const auto method : { b2world_clone_method::ARENA, b2world_clone_method::PER_OBJECT }) {
+		physics_world_cache original;
+		make_crowded_b2world(original.get_b2world(), 400);
+		step(original, 30);
+
+		REQUIRE(original.get_b2world().GetContactCount() > 400);
+
+		physics_world_cache clone;
+		clone.clone_b2world_from(original, method);
+		REQUIRE(b2world_bodies_identical(original.get_b2world(), clone.get_b2world()));
+
+		step(original, 60);
+		step(clone, 60);
+		REQUIRE(b2world_bodies_identical(original.get_b2world(), clone.get_b2world()));
+
+		/* A clone of a clone, whose chunks all lie in one arena */
+
+		physics_world_cache second_clone;
+		second_clone.clone_b2world_from(clone, method);
+
+		step(original, 60);
+		step(second_clone, 60);
+		REQUIRE(b2world_bodies_identical(original.get_b2world(), second_clone.get_b2world()));
+
+		/* Restoring over an already populated world */
+
+		clone.clone_b2world_from(original, method);
+
+		while (const auto b = original.get_b2world().GetBodyList()) {
+			original.get_b2world().DestroyBody(b);
+		}
+
+		REQUIRE(clone.get_b2world().GetBodyCount() == 401);
+	}
 }
+#endif
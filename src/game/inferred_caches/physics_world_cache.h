@@ -20,6 +20,15 @@ class b2Fixture;
 class b2Body;
 class b2World;
 
+struct b2world_pointer_migrations;
+
+enum class b2world_clone_method {
+	// Copies all chunks of the block allocator at once, then relocates pointers by their offsets in the chunks.
+	ARENA,
+	// Allocates and copies every object separately, remembering each pointer in a hash map.
+	PER_OBJECT
+};
+
 #if TODO_JOINTS
 struct joint_cache {
 	augs::propagate_const<b2Joint*> joint = nullptr;
@@ -39,6 +48,14 @@ struct physics_raycast_output {
 	unversioned_entity_id what_entity;
 };
 
+struct physics_sweep_hit {
+	real32 fraction = 0.f;
+	vec2 intersection;
+	vec2 normal;
+	unversioned_entity_id what_entity;
+	b2Fixture_index_in_component what_fixture;
+};
+
 class physics_world_cache {
 	friend rigid_body_cache;
 	friend colliders_cache;
@@ -54,6 +71,9 @@ class physics_world_cache {
 		const colliders_connection&
 	);
 
+	void clone_b2world_from(const physics_world_cache& source, b2world_clone_method, b2world_pointer_migrations&);
+	static void clone_objects_one_by_one(b2World& migrated, b2world_pointer_migrations&);
+
 public:
 	template <class E>
 	struct concerned_with {
@@ -76,6 +96,9 @@ public:
 
 	void clone_from(const physics_world_cache& source_world, cosmos& target_cosmos, const cosmos& source_cosmos);
 
+	/* Clones the b2World alone, leaving the rigid body and colliders caches of the entities untouched. */
+	void clone_b2world_from(const physics_world_cache& source_world, b2world_clone_method);
+
 	std::vector<physics_raycast_output> ray_cast_all_intersections(
 		const vec2 p1_meters,
 		const vec2 p2_meters, 
@@ -97,6 +120,21 @@ public:
 		const b2Filter filter, 
 		const entity_id ignore_entity = entity_id()
 	) const;
+
+	/*
+		Every fixture crossed by the segment, sorted from the closest.
+		Ties are broken by the entity and the fixture index,
+		so the order does not depend on the shape of the broadphase tree.
+
+		Reuses the passed vector, so it does not allocate once warmed up.
+	*/
+
+	void sweep_segment(
+		const vec2 p1_meters,
+		const vec2 p2_meters,
+		const b2Filter filter,
+		std::vector<physics_sweep_hit>& hits
+	) const;
 	
 	vec2 push_away_from_walls(
 		const si_scaling, 
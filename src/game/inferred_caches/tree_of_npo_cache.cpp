@@ -1,3 +1,5 @@
+#include <atomic>
+
 #include "game/cosmos/logic_step.h"
 #include "game/cosmos/cosmos.h"
 #include "game/cosmos/entity_handle.h"
@@ -8,6 +10,12 @@
 
 using npo_entities = entity_types_passing<tree_of_npo_cache::concerned_with>;
 
+uint64_t next_tree_of_npo_revision() {
+	/* Cosmoses might be solved on other threads. */
+	static std::atomic<uint64_t> last_revision = 0;
+	return ++last_revision;
+}
+
 tree_of_npo_cache::tree& tree_of_npo_cache::get_tree(const cache& c) {
 	return trees[static_cast<std::size_t>(c.type)];
 }
@@ -24,6 +32,8 @@ void tree_of_npo_cache::destroy_cache_of(const entity_handle& e) {
 		if (const auto cache = find_tree_of_npo_cache(handle)) {
 			cache->clear(*this);
 		}
+
+		bump_revision_of<entity_type_of<decltype(handle)>>();
 	});
 }
 
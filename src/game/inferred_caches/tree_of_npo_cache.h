@@ -13,6 +13,7 @@
 #include "game/detail/entities_with_render_layer.h"
 #include "game/cosmos/entity_type_traits.h"
 #include "game/cosmos/entity_id.h"
+#include "game/cosmos/per_entity_type.h"
 #include "game/inferred_caches/tree_of_npo_cache_data.h"
 
 /* NPO stands for "non-physical objects" */
@@ -49,9 +50,13 @@ class tree_of_npo_cache {
 	};
 
 	augs::enum_array<tree, tree_of_npo_type> trees;
+	per_entity_type_array<uint64_t> revisions = {};
 
 	tree& get_tree(const cache&);
 
+	template <class E>
+	void bump_revision_of();
+
 public:
 	template <class E>
 	struct concerned_with {
@@ -92,6 +97,17 @@ public:
 		tree.nodes.Query(&aabb_listener, input);
 	}
 
+	/*
+		Changes whenever a cache of an entity of the given type is inferred or destroyed.
+		The values are unique across all cosmoses,
+		so the view can tell whether anything it has retained from the entities of this type is out of date.
+	*/
+
+	template <class E>
+	uint64_t get_revision_of() const {
+		return revisions[index_in_list_v<E, all_entity_types>];
+	}
+
 	void reserve_caches_for_entities(const size_t n);
 
 	void infer_all(cosmos&);
@@ -53,10 +53,19 @@ std::optional<tree_of_npo_node_input> create_default_for(const E& handle) {
 	return std::nullopt;
 }
 
+uint64_t next_tree_of_npo_revision();
+
+template <class E>
+void tree_of_npo_cache::bump_revision_of() {
+	revisions[index_in_list_v<E, all_entity_types>] = ::next_tree_of_npo_revision();
+}
+
 template <class E>
 void tree_of_npo_cache::specific_infer_cache_for(const E& handle) {
 	const auto id = handle.get_id().to_unversioned();
 
+	bump_revision_of<entity_type_of<E>>();
+
 	auto& cache = get_corresponding<tree_of_npo_cache_data>(handle);
 	const bool cache_existed = cache.is_constructed();
 
@@ -8,6 +8,7 @@ namespace messages {
 		transformr muzzle_transform;
 
 		std::vector<entity_id> spawned_rounds;
+		std::vector<invariants::cartridge::round_flavour_type> spawned_lightweight_rounds;
 		entity_id capability;
 	};
 }
@@ -3,6 +3,7 @@
 
 #include "game/organization/all_components_declaration.h"
 #include "game/organization/all_entity_types_declaration.h"
+#include "game/cosmos/entity_pool_storage.h"
 
 struct items_of_slots_cache;
 struct rigid_body_cache;
@@ -370,6 +371,13 @@ struct complex_decoration {
 	static constexpr std::size_t statically_allocated_entities = 2000;
 	static constexpr std::size_t statically_allocated_flavours = 300;
 
+	/* 
+		Animation and movement path systems sweep every complex decoration each step,
+		touching only one or two of its components.
+	*/
+
+	static constexpr entity_pool_storage pool_storage = entity_pool_storage::STRUCT_OF_ARRAYS;
+
 	using invariant_list = type_list<
 		invariants::sprite,
 		invariants::animation,
@@ -1,4 +1,5 @@
 #pragma once
+#include "augs/templates/folded_finders.h"
 #include "game/detail/inventory/item_slot_transfer_request_declaration.h"
 
 namespace augs {
@@ -65,3 +66,23 @@ using all_message_queues = augs::storage_for_message_queues<
 
 	messages::game_notification
 >;
+
+/* 
+	Messages that only the audiovisual state ever reads.
+	They are not posted at all if solve_settings::generate_audiovisual_messages is false.
+*/
+
+template <class T>
+constexpr bool is_audiovisual_message_v = is_one_of_v<
+	T,
+
+	messages::start_particle_effect,
+	messages::stop_particle_effect,
+
+	messages::start_sound_effect,
+	messages::start_multi_sound_effect,
+	messages::stop_sound_effect,
+
+	messages::thunder_effect,
+	messages::exploding_ring_effect
+>;
@@ -24,6 +24,7 @@
 #include "game/components/sender_component.h"
 #include "game/components/transform_component.h"
 #include "game/components/gun_component.h"
+#include "game/detail/missile/lightweight_projectile.h"
 
 #include "game/detail/inventory/item_slot_transfer_request.h"
 #include "game/detail/inventory/perform_transfer.h"
@@ -48,6 +49,21 @@
 
 #include "augs/log.h"
 
+/* 
+	Rounds that explode or home in on targets need an entity,
+	so they are spawned as one even if the gun fires lightweight projectiles.
+*/
+
+template <class F>
+static bool can_fly_as_lightweight_projectile(const F& round_flavour) {
+	if constexpr(F::template has<invariants::explosive>() || !F::template has<components::missile>()) {
+		return false;
+	}
+	else {
+		return round_flavour.template get<invariants::missile>().homing_towards_hostile_strength <= 0.f;
+	}
+}
+
 template <class T>
 bool gun_try_to_fire_and_reset(
 	const cosmos_clock& clk,
@@ -779,7 +795,70 @@ void gun_system::launch_shots_due_to_pressed_triggers(const logic_step step) {
 										if (const auto round_flavour = cartridge_def.round_flavour; round_flavour.is_set()) {
 											const auto& num_rounds = cartridge_def.num_rounds_spawned;
 
+											const bool lightweight_rounds = 
+												gun_def.fires_lightweight_projectiles
+												&& cosm.on_flavour(round_flavour, [](const auto& f) { return ::can_fly_as_lightweight_projectile(f); })
+											;
+
+											auto calc_considered_muzzle_transform = [&](const std::optional<real32> rotational_offset) {
+												auto o = muzzle_transform;
+
+												if (rotational_offset.has_value()) {
+													o.rotation += *rotational_offset;
+												}
+
+												if (cartridge_rotational_offset.has_value()) {
+													o.rotation += *cartridge_rotational_offset;
+												}
+
+												return o;
+											};
+
+											auto fire_lightweight_round = [&](const std::optional<real32> rotational_offset) {
+												const auto& missile_def = *cosm.on_flavour(
+													round_flavour,
+													[](const auto& f) {
+														return std::addressof(f.template get<invariants::missile>());
+													}
+												);
+
+												total_recoil += missile_def.recoil_multiplier * gun_def.recoil_multiplier / num_rounds;
+
+												const auto considered_muzzle_transform = calc_considered_muzzle_transform(rotational_offset);
+												const auto muzzle_randomized_vel = stack_rng.randval(gun_def.muzzle_velocity);
+
+												lightweight_projectile projectile;
+
+												projectile.round_flavour = round_flavour;
+												projectile.sender.set(gun_entity);
+
+												projectile.pos = considered_muzzle_transform.pos;
+												projectile.vel = 
+													considered_muzzle_transform.get_direction()
+													* missile_def.muzzle_velocity_mult
+													* muzzle_randomized_vel
+												;
+
+												projectile.damage_charges_before_destruction = cosm.on_flavour(
+													round_flavour,
+													[](const auto& f) {
+														return f.template get<components::missile>().damage_charges_before_destruction;
+													}
+												);
+
+												projectile.power_multiplier_of_sender = gun_def.damage_multiplier;
+												projectile.when_fired = cosm.get_timestamp();
+
+												cosm.get_global_solvable().lightweight_projectiles.push_back(projectile);
+												response.spawned_lightweight_rounds.push_back(round_flavour);
+											};
+
 											auto create_round = [&](const std::optional<real32> rotational_offset) {
+												if (lightweight_rounds) {
+													fire_lightweight_round(rotational_offset);
+													return;
+												}
+
 												cosmic::create_entity(cosm, round_flavour, [&](const auto round_entity, auto&&...) {
 #if !ENABLE_RECOIL
 													LOG("ROUND CREATED");
@@ -795,19 +874,7 @@ void gun_system::launch_shots_due_to_pressed_triggers(const logic_step step) {
 													const auto& missile_def = round_entity.template get<invariants::missile>();
 													total_recoil += missile_def.recoil_multiplier * gun_def.recoil_multiplier / num_rounds;
 
-													const auto considered_muzzle_transform = [&]() {
-														auto o = muzzle_transform;
-
-														if (rotational_offset.has_value()) {
-															o.rotation += *rotational_offset;
-														}
-
-														if (cartridge_rotational_offset.has_value()) {
-															o.rotation += *cartridge_rotational_offset;
-														}
-
-														return o;
-													}();
+													const auto considered_muzzle_transform = calc_considered_muzzle_transform(rotational_offset);
 
 													round_entity.set_logic_transform(considered_muzzle_transform);
 
@@ -39,6 +39,9 @@
 #include "game/detail/explosive/detonate.h"
 #include "game/detail/melee/like_melee.h"
 #include "game/messages/thunder_effect.h"
+#include "game/detail/missile/lightweight_projectile.h"
+#include "game/inferred_caches/physics_world_cache.h"
+#include "augs/templates/hash_templates.h"
 
 #define USER_RICOCHET_COOLDOWNS 0
 #define LOG_RICOCHETS 0
@@ -406,4 +409,420 @@ void missile_system::detonate_expired_missiles(const logic_step step) {
 			}
 		}
 	);
-}
\ No newline at end of file
+}
+
+/*
+	Lightweight projectiles follow the rules of missile_ricochet.h and missile_collision.h,
+	adapted to a sweep of the path travelled in a step:
+
+		- surfaces that missile_surface_info ignores altogether are passed through;
+		- a ricochetable surface hit at a shallow enough angle reflects the projectile;
+		- any other surface receives a damage message.
+		  If the missile would detonate against it, one damage charge is spent
+		  and the projectile penetrates the surface while charges remain.
+		  Surfaces the missile flies through cost nothing.
+
+	The sweep never reports the same contact twice,
+	so there is no need for the ricochet cooldown that protects missile entities against persisting contacts.
+*/
+
+static constexpr int max_lightweight_projectile_segments_v = 4;
+
+template <class E>
+static bool ricochet_lightweight_projectile(
+	const logic_step step,
+	lightweight_projectile& p,
+	const invariants::missile& missile_def,
+	const E& surface_handle,
+	const vec2 normal,
+	const vec2 point
+) {
+	const auto& clk = step.get_cosmos().get_clock();
+
+	const auto impact_speed = p.vel.length();
+	const auto impact_dir = p.vel / impact_speed;
+
+	if (impact_dir.dot(normal) >= 0.f) {
+		return false;
+	}
+
+	const auto hit_facing = impact_dir.degrees_between(normal);
+	const auto max_ricochet_angle = surface_handle.template get<invariants::fixtures>().max_ricochet_angle;
+
+	const auto left_b = 90 - max_ricochet_angle;
+	const auto right_b = 90 + max_ricochet_angle;
+
+	if (!(hit_facing > left_b && hit_facing < right_b)) {
+		return false;
+	}
+
+	if (clk.lasts(missile_def.ricochet_born_cooldown_ms, p.when_fired)) {
+		return false;
+	}
+
+	const auto angle = std::min(hit_facing - left_b, right_b - hit_facing);
+	const auto angle_mult = angle / max_ricochet_angle;
+
+	const auto reflected_dir = vec2(impact_dir).reflect(normal);
+
+	p.when_last_ricocheted = clk.now;
+	p.pos = point;
+	p.vel = reflected_dir * impact_speed;
+
+	const auto effect_transform = transformr(point, reflected_dir.degrees());
+
+	missile_def.ricochet_particles.start(
+		step,
+		particle_effect_start_input::fire_and_forget(effect_transform),
+		always_predictable_v
+	);
+
+	{
+		auto effect = missile_def.ricochet_sound;
+		effect.modifier.pitch = 0.7f + angle_mult / 1.5f;
+		effect.modifier.max_distance = 3000.f;
+		effect.modifier.reference_distance = 1000.f;
+
+		effect.start(
+			step,
+			sound_effect_start_input::fire_and_forget(effect_transform),
+			always_predictable_v
+		);
+	}
+
+	return true;
+}
+
+static bool advance_lightweight_projectile(
+	const logic_step step,
+	lightweight_projectile& p,
+	const unsigned index,
+	std::vector<physics_sweep_hit>& hits
+) {
+	auto& cosm = step.get_cosmos();
+	const auto& physics = cosm.get_solvable_inferred().physics;
+	const auto si = cosm.get_si();
+	const auto now = cosm.get_timestamp();
+	const auto& delta = step.get_delta();
+
+	const auto& missile_def = *cosm.on_flavour(
+		p.round_flavour,
+		[](const auto& flavour) {
+			return std::addressof(flavour.template get<invariants::missile>());
+		}
+	);
+
+	const auto filter = cosm.on_flavour(
+		p.round_flavour,
+		[](const auto& flavour) -> b2Filter {
+			if (const auto fixtures = flavour.template find<invariants::fixtures>()) {
+				return fixtures->filter;
+			}
+
+			return filters[predefined_filter_type::FLYING_BULLET];
+		}
+	);
+
+	if (missile_def.constrain_lifetime) {
+		const auto lifetime_steps = static_cast<uint32_t>(missile_def.max_lifetime_ms / delta.in_milliseconds());
+
+		if (now.step >= p.when_fired.step + lifetime_steps) {
+			return false;
+		}
+	}
+
+	auto remaining_secs = delta.in_seconds();
+	entity_id ricocheted_from;
+
+	for (int segment = 0; segment < max_lightweight_projectile_segments_v; ++segment) {
+		const auto target_pos = p.pos + p.vel * remaining_secs;
+
+		physics.sweep_segment(si.get_meters(p.pos), si.get_meters(target_pos), filter, hits);
+
+		std::optional<real32> ricocheted_at_fraction;
+
+		for (const auto& hit : hits) {
+			const auto surface_handle = cosm[hit.what_entity];
+
+			if (surface_handle.dead() || surface_handle.get_id() == ricocheted_from) {
+				continue;
+			}
+
+			const auto info = missile_surface_info(p.sender, surface_handle);
+
+			if (info.should_ignore_altogether()) {
+				continue;
+			}
+
+			const auto point = si.get_pixels(hit.intersection);
+			const auto normal = vec2(hit.normal).normalize();
+
+			if (info.is_ricochetable()) {
+				if (::ricochet_lightweight_projectile(step, p, missile_def, surface_handle, normal, point)) {
+					ricocheted_from = surface_handle.get_id();
+					ricocheted_at_fraction = hit.fraction;
+					break;
+				}
+			}
+
+			const bool solid = !info.ignore_standard_impulse();
+
+			if (!missile_def.damage_upon_collision || p.damage_charges_before_destruction <= 0) {
+				if (solid) {
+					return false;
+				}
+
+				continue;
+			}
+
+			messages::damage_message damage_msg;
+			damage_msg.indices.subject = hit.what_fixture;
+			damage_msg.damage = missile_def.damage;
+			damage_msg.damage *= p.power_multiplier_of_sender;
+
+			const auto impact_dir = vec2(p.vel).normalize();
+			bool destroyed = false;
+
+			if (info.should_detonate() && missile_def.destroy_upon_damage) {
+				--p.damage_charges_before_destruction;
+
+				const auto& total_damage_amount = damage_msg.damage.base;
+
+				if (augs::is_positive_epsilon(total_damage_amount)) {
+					startle_nearby_organisms(cosm, point, total_damage_amount * 12.f, 27.f, startle_type::LIGHTER);
+					startle_nearby_organisms(cosm, point, total_damage_amount * 6.f, 50.f + total_damage_amount * 2.f, startle_type::IMMEDIATE, render_layer_filter::whitelist(render_layer::INSECTS));
+				}
+
+				if (p.damage_charges_before_destruction == 0) {
+					damage_msg.inflictor_destructed = true;
+					destroyed = true;
+
+					auto rng = randomization(augs::hash_multiple(now.step, index));
+
+					spawn_bullet_remnants(
+						step,
+						rng,
+						missile_def.remnant_flavours,
+						normal,
+						impact_dir,
+						point
+					);
+				}
+			}
+
+			/* 
+				There is no round entity to point to. 
+				The gun is what kill attribution and the damage handlers can still look up. 
+			*/
+
+			damage_msg.origin.cause.entity = p.sender.direct_sender;
+			damage_msg.origin.cause.flavour = p.round_flavour;
+			damage_msg.origin.sender = p.sender;
+			damage_msg.subject = surface_handle;
+			damage_msg.impact_velocity = p.vel;
+			damage_msg.point_of_impact = point;
+			step.post_message(damage_msg);
+
+			if (destroyed) {
+				return false;
+			}
+
+			if (solid && !missile_def.destroy_upon_damage) {
+				/* Nothing to penetrate the surface with. */
+				return false;
+			}
+		}
+
+		if (ricocheted_at_fraction == std::nullopt) {
+			p.pos = target_pos;
+			break;
+		}
+
+		remaining_secs *= 1.f - *ricocheted_at_fraction;
+	}
+
+	return true;
+}
+
+void missile_system::advance_lightweight_projectiles(const logic_step step) {
+	auto& cosm = step.get_cosmos();
+	auto& projectiles = cosm.get_global_solvable().lightweight_projectiles;
+
+	thread_local std::vector<physics_sweep_hit> hits;
+
+	std::size_t num_alive = 0;
+
+	for (std::size_t i = 0; i < projectiles.size(); ++i) {
+		if (::advance_lightweight_projectile(step, projectiles[i], static_cast<unsigned>(i), hits)) {
+			if (num_alive != i) {
+				projectiles[num_alive] = projectiles[i];
+			}
+
+			++num_alive;
+		}
+	}
+
+	projectiles.resize(num_alive);
+}
+
+#if BUILD_UNIT_TESTS && BUILD_TEST_SCENES
+#include <Catch/single_include/catch2/catch.hpp>
+#include "augs/misc/lua/lua_utils.h"
+#include <sol2/sol.hpp>
+#include "game/modes/test_mode.h"
+#include "game/cosmos/solvers/standard_solver.h"
+#include "test_scenes/test_scene_settings.h"
+#include "test_scenes/create_test_scene_entity.h"
+#include "application/intercosm.h"
+
+struct fired_round_outcome {
+	struct damage_entry {
+		entity_id subject;
+		real32 amount = 0.f;
+		bool inflictor_destructed = false;
+
+		bool operator==(const damage_entry& b) const {
+			return subject == b.subject && amount == b.amount && inflictor_destructed == b.inflictor_destructed;
+		}
+	};
+
+	std::vector<damage_entry> damages;
+
+	/* Unset if the round no longer exists. */
+	std::optional<vec2> final_direction;
+};
+
+/*
+	Fires the same round once as a missile entity and once as a lightweight projectile,
+	steps both worlds the same number of times and reports what happened.
+*/
+
+static auto fire_round_both_ways(
+	const cosmos& base,
+	const vec2 from,
+	const vec2 velocity,
+	const int damage_charges,
+	const unsigned steps
+) {
+	const auto round_flavour = to_entity_flavour_id(test_plain_missiles::PRO90_ROUND);
+
+	auto simulate = [&](const bool lightweight) {
+		const auto cosm = std::make_unique<cosmos>(base);
+
+		fired_round_outcome outcome;
+		entity_id round_entity;
+
+		if (lightweight) {
+			lightweight_projectile p;
+			p.round_flavour = round_flavour;
+			p.pos = from;
+			p.vel = velocity;
+			p.damage_charges_before_destruction = damage_charges;
+			p.when_fired = cosm->get_timestamp();
+
+			cosm->get_global_solvable().lightweight_projectiles.push_back(p);
+		}
+		else {
+			round_entity = create_test_scene_entity(*cosm, test_plain_missiles::PRO90_ROUND, [&](const auto handle, auto&&...) {
+				handle.set_logic_transform(transformr(from, velocity.degrees()));
+				handle.template get<components::missile>().damage_charges_before_destruction = damage_charges;
+				handle.template get<components::missile>().when_fired = cosm->get_timestamp();
+				handle.template get<components::rigid_body>().set_velocity(velocity);
+			}).get_id();
+		}
+
+		for (unsigned i = 0; i < steps; ++i) {
+			standard_solver()(
+				{ *cosm, cosmic_entropy(), solve_settings() },
+				solver_callbacks(
+					default_solver_callback(),
+					[&](const const_logic_step step) {
+						for (const auto& d : step.get_queue<messages::damage_message>()) {
+							outcome.damages.push_back({ d.subject, d.damage.base, d.inflictor_destructed });
+						}
+					}
+				)
+			);
+		}
+
+		if (lightweight) {
+			const auto& projectiles = cosm->get_global_solvable().lightweight_projectiles;
+
+			if (!projectiles.empty()) {
+				outcome.final_direction = vec2(projectiles.front().vel).normalize();
+			}
+		}
+		else if (const auto handle = (*cosm)[round_entity]) {
+			outcome.final_direction = vec2(handle.template get<components::rigid_body>().get_velocity()).normalize();
+		}
+
+		return outcome;
+	};
+
+	return std::make_pair(simulate(false), simulate(true));
+}
+
+TEST_CASE("MissileSystem LightweightProjectilesMatchEntityMissiles") {
+	auto lua = augs::create_lua_state();
+
+	auto scene = std::make_unique<intercosm>();
+	auto ruleset = test_mode_ruleset();
+
+	scene->make_test_scene(lua, { true, 60 }, ruleset);
+
+	auto& world = scene->world;
+
+	const auto first_wall = create_test_scene_entity(world, test_plain_sprited_bodies::BRICK_WALL, vec2(600, 0)).get_id();
+	const auto second_wall = create_test_scene_entity(world, test_plain_sprited_bodies::BRICK_WALL, vec2(1200, 0)).get_id();
+
+	const auto first_aabb = *world[first_wall].find_aabb();
+	const auto speed = 4000.f;
+	const unsigned steps = 30;
+
+	{
+		/* Head-on: one damage message against the first wall, then the round is gone. */
+
+		const auto [entity, lightweight] = fire_round_both_ways(world, vec2(0, 0), vec2(speed, 0), 1, steps);
+
+		REQUIRE(entity.damages.size() == 1);
+		REQUIRE(entity.damages[0].subject == first_wall);
+		REQUIRE(entity.damages[0].inflictor_destructed);
+		REQUIRE(!entity.final_direction.has_value());
+
+		REQUIRE(lightweight.damages == entity.damages);
+		REQUIRE(!lightweight.final_direction.has_value());
+	}
+
+	{
+		/* Penetration: two charges carry the round through the first wall into the second. */
+
+		const auto [entity, lightweight] = fire_round_both_ways(world, vec2(0, 0), vec2(speed, 0), 2, steps);
+
+		REQUIRE(entity.damages.size() == 2);
+		REQUIRE(entity.damages[0].subject == first_wall);
+		REQUIRE(!entity.damages[0].inflictor_destructed);
+		REQUIRE(entity.damages[1].subject == second_wall);
+		REQUIRE(entity.damages[1].inflictor_destructed);
+
+		REQUIRE(lightweight.damages == entity.damages);
+	}
+
+	{
+		/* Ricochet: graze the left face of the first wall well within its max_ricochet_angle. */
+
+		const auto dir = vec2::from_degrees(85.f);
+		const auto face_point = vec2(first_aabb.l, first_aabb.get_center().y);
+		const auto from = face_point - dir * 300.f;
+
+		const auto [entity, lightweight] = fire_round_both_ways(world, from, dir * speed, 1, 10);
+
+		REQUIRE(entity.damages.empty());
+		REQUIRE(entity.final_direction.has_value());
+		REQUIRE(entity.final_direction->x < 0.f);
+
+		REQUIRE(lightweight.damages.empty());
+		REQUIRE(lightweight.final_direction.has_value());
+		REQUIRE(lightweight.final_direction->dot(*entity.final_direction) > 0.99f);
+	}
+}
+#endif
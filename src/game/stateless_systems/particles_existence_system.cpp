@@ -111,6 +111,18 @@ void particles_existence_system::play_particles_from_events(const logic_step ste
 				}
 			}
 		}
+
+		for (const auto& f : g.spawned_lightweight_rounds) {
+			const auto& effect = cosm.on_flavour(f, [](const auto& typed_flavour) -> decltype(auto) {
+				return typed_flavour.template get<invariants::missile>().muzzle_leave_particles;
+			});
+
+			effect.start(
+				step,
+				particle_effect_start_input::orbit_absolute(cosm[g.subject], g.muzzle_transform),
+				predictability
+			);
+		}
 	}
 
 	for (const auto& d : damages) {
@@ -8,8 +8,10 @@
 #include "augs/math/math.h"
 #include "augs/templates/container_templates.h"
 #include "augs/templates/algorithm_templates.h"
+#include "augs/templates/hash_templates.h"
 #include "augs/misc/simple_pair.h"
 #include "game/detail/physics/physics_queries.h"
+#include "game/detail/physics/angular_ray_sweep.h"
 #include "game/debug_drawing_settings.h"
 
 #include "game/cosmos/cosmos.h"
@@ -53,17 +55,6 @@ void VIS_LOG(Args&&... args) {
 #define VIS_LOG_NVPS VIS_LOG
 #endif
 
-/*
-	Thanks to:
-	https://stackoverflow.com/questions/16542042/fastest-way-to-sort-vectors-by-angle-without-actually-computing-that-angle
-*/
-
-FORCE_INLINE auto comparable_angle(const vec2 diff) {
-	return repro::copysignf(
-		1 - diff.x / (repro::fabs(diff.x) + repro::fabs(diff.y)), diff.y 
-	);
-}
-
 using edge = visibility_information_response::edge;
 using discontinuity = visibility_information_response::discontinuity;
 using triangle = visibility_information_response::triangle;
@@ -167,10 +158,120 @@ bool visibility_information_request::valid() const {
 	return queried_rect.x > 1.f && queried_rect.y > 1.f;
 }
 
+static uint64_t hash_shape_geometry(const b2Shape& shape) {
+	auto h = augs::hash_multiple(static_cast<int32_t>(shape.GetType()), shape.m_radius);
+
+	auto combine_vertices = [&h](const b2Vec2* const vertices, const int32 count) {
+		for (int32 i = 0; i < count; ++i) {
+			augs::hash_combine(h, vertices[i].x, vertices[i].y);
+		}
+	};
+
+	switch (shape.GetType()) {
+		case b2Shape::e_circle: {
+			const auto& circle = static_cast<const b2CircleShape&>(shape);
+			augs::hash_combine(h, circle.m_p.x, circle.m_p.y);
+			break;
+		}
+		case b2Shape::e_edge: {
+			const auto& edge = static_cast<const b2EdgeShape&>(shape);
+			augs::hash_combine(h, edge.m_vertex1.x, edge.m_vertex1.y, edge.m_vertex2.x, edge.m_vertex2.y);
+			break;
+		}
+		case b2Shape::e_polygon: {
+			const auto& polygon = static_cast<const b2PolygonShape&>(shape);
+			combine_vertices(polygon.m_vertices, polygon.m_count);
+			break;
+		}
+		case b2Shape::e_chain: {
+			const auto& chain = static_cast<const b2ChainShape&>(shape);
+			combine_vertices(chain.m_vertices, chain.m_count);
+			break;
+		}
+		default: break;
+	}
+
+	return h;
+}
+
+uint64_t visibility_system::calc_obstacles_signature(
+	const cosmos& cosm,
+	const visibility_request& request
+) {
+	const auto si = cosm.get_si();
+	const auto& physics = cosm.get_solvable_inferred().physics;
+	const auto& settings = cosm.get_common_significant().visibility;
+
+	/*
+		The fixtures are combined regardless of their order,
+		because the order of the query results can change
+		when the broadphase is rebalanced after bodies move elsewhere.
+
+		The geometry is hashed too, because a reinferred fixture
+		can be reallocated at the same address with a different shape.
+	*/
+
+	uint64_t sum = 0;
+	uint64_t xored = 0;
+	uint32_t count = 0;
+
+	if (request.valid()) {
+		const auto ignored_entity = request.subject;
+
+		const vec2 eye_meters = si.get_meters(request.eye_transform.pos + request.offset);
+		const auto vision_meters = si.get_meters(request.queried_rect);
+
+		b2AABB aabb;
+		aabb.lowerBound = b2Vec2(eye_meters - vision_meters / 2);
+		aabb.upperBound = b2Vec2(eye_meters + vision_meters / 2);
+
+		physics.for_each_in_aabb_meters(
+			aabb, 
+			request.filter,
+			[&](const b2Fixture& f) {
+				if (get_body_entity_that_owns(f) == Userdata(ignored_entity)) {
+					return callback_result::CONTINUE;
+				}
+
+				const auto xf = f.GetBody()->GetTransform();
+				const auto& filter = f.GetFilterData();
+
+				const auto h = augs::hash_multiple(
+					static_cast<uint64_t>(reinterpret_cast<uintptr_t>(&f)),
+					xf.p.x,
+					xf.p.y,
+					xf.q.s,
+					xf.q.c,
+					filter.categoryBits,
+					filter.maskBits,
+					static_cast<int32_t>(filter.groupIndex),
+					hash_shape_geometry(*f.GetShape())
+				);
+
+				sum += h;
+				xored ^= h;
+				++count;
+
+				return callback_result::CONTINUE;
+			}
+		);
+	}
+
+	return augs::hash_multiple(
+		sum,
+		xored,
+		count,
+		settings.epsilon_ray_distance_variation,
+		settings.epsilon_distance_vertex_hit,
+		settings.epsilon_threshold_obstacle_hit
+	);
+}
+
 void visibility_system::calc_visibility(
 	const cosmos& cosm,
 	const visibility_request& request,
-	visibility_response& response
+	visibility_response& response,
+	const visibility_engine_type engine
 ) const {
 	const auto si = cosm.get_si();
 
@@ -211,10 +312,6 @@ void visibility_system::calc_visibility(
 	/* we'll need a reference to physics system for raycasting */
 	const auto& physics = cosm.get_solvable_inferred().physics;
 
-	struct ray_input {
-		vec2 destination;
-	};
-
 	using ray_output = physics_raycast_output;
 
 	const auto ignored_entity = request.subject;
@@ -241,6 +338,36 @@ void visibility_system::calc_visibility(
 	aabb.lowerBound = b2Vec2(eye_meters - vision_meters / 2);
 	aabb.upperBound = b2Vec2(eye_meters + vision_meters / 2);
 
+	thread_local angular_ray_sweep sweep;
+	const bool use_sweep = engine == visibility_engine_type::SWEEP;
+
+	if (use_sweep) {
+		/*
+			The rays go a few pixels beyond the visibility square,
+			so gather the fixtures from a slightly larger area.
+		*/
+
+		const auto margin = b2Vec2(vec2::square(si.get_meters(5.f)));
+
+		b2AABB sweep_aabb;
+		sweep_aabb.lowerBound = aabb.lowerBound - margin;
+		sweep_aabb.upperBound = aabb.upperBound + margin;
+
+		sweep.reset(eye_meters);
+
+		physics.for_each_in_aabb_meters(
+			sweep_aabb,
+			request.filter,
+			[&](const b2Fixture& f) {
+				if (get_body_entity_that_owns(f) != Userdata(ignored_entity)) {
+					sweep.add_fixture(f);
+				}
+
+				return callback_result::CONTINUE;
+			}
+		);
+	}
+
 	auto push_vertex_if_within_range = [
 		eye_meters, 
 		boundary = ltrb(aabb.lowerBound.x, aabb.lowerBound.y, aabb.upperBound.x, aabb.upperBound.y)
@@ -422,8 +549,17 @@ void visibility_system::calc_visibility(
 		/* raycast through the bounds to add another vertices where the shapes go beyond visibility square */
 		for (const auto& bound : b) {
 			/* have to raycast both directions because Box2D ignores the second side of the fixture */
-			const auto output1 = physics.ray_cast_all_intersections(bound.m_vertex1, bound.m_vertex2, request.filter, ignored_entity);
-			const auto output2 = physics.ray_cast_all_intersections(bound.m_vertex2, bound.m_vertex1, request.filter, ignored_entity);
+			thread_local std::vector<ray_output> output1;
+			thread_local std::vector<ray_output> output2;
+
+			if (use_sweep) {
+				sweep.ray_cast_all_intersections(bound.m_vertex1, bound.m_vertex2, output1);
+				sweep.ray_cast_all_intersections(bound.m_vertex2, bound.m_vertex1, output2);
+			}
+			else {
+				output1 = physics.ray_cast_all_intersections(bound.m_vertex1, bound.m_vertex2, request.filter, ignored_entity);
+				output2 = physics.ray_cast_all_intersections(bound.m_vertex2, bound.m_vertex1, request.filter, ignored_entity);
+			}
 
 			/* check for duplicates */
 			std::vector<vec2> output;
@@ -536,10 +672,10 @@ void visibility_system::calc_visibility(
 		lines.emplace_back(si.get_pixels(eye_meters), si.get_pixels(point), col);
 	};
 
-	thread_local std::vector<ray_input> all_ray_inputs;
+	thread_local std::vector<vec2> all_ray_destinations;
 
-	all_ray_inputs.clear();
-	all_ray_inputs.reserve(all_vertices_transformed.size());
+	all_ray_destinations.clear();
+	all_ray_destinations.reserve(all_vertices_transformed.size());
 
 	/* for every vertex to cast the ray to */
 	for (const auto& vertex : all_vertices_transformed) {
@@ -579,17 +715,16 @@ void visibility_system::calc_visibility(
 			}
 		}
 
-		ray_input new_ray_input;
-		new_ray_input.destination = vertex.is_on_a_bound ? vertex.pos : destination;
+		const auto new_ray_destination = vertex.is_on_a_bound ? vertex.pos : destination;
 
 #if LOG_VISIBILITY
 		{
 			const auto i = index_in(all_vertices_transformed, vertex);
-			VIS_LOG_NVPS(i, si.get_pixels(new_ray_input.destination), vertex.is_on_a_bound);
+			VIS_LOG_NVPS(i, si.get_pixels(new_ray_destination), vertex.is_on_a_bound);
 		}
 #endif
 
-		all_ray_inputs.push_back(new_ray_input);
+		all_ray_destinations.push_back(new_ray_destination);
 	}
 
 	thread_local std::vector<ray_output> all_ray_outputs;
@@ -597,17 +732,24 @@ void visibility_system::calc_visibility(
 	all_ray_outputs.clear();
 	all_ray_outputs.reserve(all_vertices_transformed.size());
 
-	/* All raycast inputs are processed at once to improve cache coherency. */
-	for (std::size_t j = 0; j < all_ray_inputs.size(); ++j) {
-		auto result = physics.ray_cast(eye_meters, all_ray_inputs[j].destination, request.filter, ignored_entity);
-		all_ray_outputs.emplace_back(std::move(result));
+	if (use_sweep) {
+		sweep.ray_cast(all_ray_destinations, all_ray_outputs);
+	}
+	else {
+		/* All raycast inputs are processed at once to improve cache coherency. */
+		for (std::size_t j = 0; j < all_ray_destinations.size(); ++j) {
+			auto result = physics.ray_cast(eye_meters, all_ray_destinations[j], request.filter, ignored_entity);
+			all_ray_outputs.emplace_back(std::move(result));
+		}
+	}
 
 #if LOG_VISIBILITY
-		if (DEBUG_DRAWING.draw_cast_rays) {
-			draw_line(all_ray_inputs[j].destination, pink);
+	if (DEBUG_DRAWING.draw_cast_rays) {
+		for (const auto& destination : all_ray_destinations) {
+			draw_line(destination, pink);
 		}
-#endif
 	}
+#endif
 
 	for (std::size_t i = 0; i < all_ray_outputs.size(); ++i) {
 		const auto& ray_callback = all_ray_outputs[i];
@@ -756,7 +898,7 @@ void visibility_system::calc_visibility(
 				for (const auto& bound : visibility_bounds) {
 					const auto ray_edge_output = segment_segment_intersection(
 						eye_meters, 
-						all_ray_inputs[i].destination,
+						all_ray_destinations[i],
 						bound.m_vertex1, 
 						bound.m_vertex2
 					);
@@ -981,4 +1123,48 @@ void visibility_system::calc_visibility(
 			lines.emplace_back(world_light_tri[2], world_light_tri[0], col);
 		}
 	}
-}
\ No newline at end of file
+}
+#if BUILD_UNIT_TESTS && BUILD_TEST_SCENES
+#include <Catch/single_include/catch2/catch.hpp>
+#include "augs/misc/lua/lua_utils.h"
+#include <sol2/sol.hpp>
+#include "game/modes/test_mode.h"
+#include "game/enums/filters.h"
+#include "test_scenes/test_scene_settings.h"
+#include "test_scenes/create_test_scene_entity.h"
+#include "application/intercosm.h"
+
+TEST_CASE("VisibilitySystem ReshapedFixtureChangesSignature") {
+	auto lua = augs::create_lua_state();
+
+	auto scene = std::make_unique<intercosm>();
+	auto ruleset = test_mode_ruleset();
+
+	scene->make_test_scene(lua, { true, 60 }, ruleset);
+
+	auto& world = scene->world;
+
+	const auto wall_pos = vec2(600, 0);
+	const auto wall = create_test_scene_entity(world, test_plain_sprited_bodies::BRICK_WALL, wall_pos).get_id();
+
+	visibility_request request;
+	request.eye_transform.pos = wall_pos - vec2(300, 0);
+	request.queried_rect = vec2(2000, 2000);
+	request.filter = predefined_queries::line_of_sight();
+
+	const auto original = visibility_system::calc_obstacles_signature(world, request);
+	REQUIRE(original == visibility_system::calc_obstacles_signature(world, request));
+
+	/* Same entity, same body transform and filter - only the shape differs. */
+
+	const auto original_size = world[wall].get_logical_size();
+	const auto reshaped_size = original_size / 2;
+
+	world[wall].set_logical_size(reshaped_size);
+	REQUIRE(world[wall].get_logical_size() == reshaped_size);
+	REQUIRE(world[wall].get_logic_transform().pos == wall_pos);
+
+	const auto reshaped = visibility_system::calc_obstacles_signature(world, request);
+	REQUIRE(reshaped != original);
+}
+#endif
@@ -1,10 +1,25 @@
 #pragma once
 #include <vector>
 #include "game/messages/visibility_information.h"
+#include "game/common_state/visibility_settings.h"
 
 #include "game/debug_drawing_settings.h"
 #include "game/cosmos/step_declaration.h"
 
+/*
+	RAY_CAST casts every ray through the broadphase of the physics world.
+	SWEEP gathers the fixtures once per request and sweeps the rays against them by angle.
+	Both find the same hits, SWEEP just does it faster,
+	so the choice is not part of the significant state.
+*/
+
+enum class visibility_engine_type {
+	// GEN INTROSPECTOR enum class visibility_engine_type
+	RAY_CAST,
+	SWEEP
+	// END GEN INTROSPECTOR
+};
+
 using visibility_request = messages::visibility_information_request;
 using visibility_response = messages::visibility_information_response;
 
@@ -23,6 +38,17 @@ public:
 	void calc_visibility(
 		const cosmos&,
 		const visibility_request&,
-		visibility_response&
+		visibility_response&,
+		visibility_engine_type = visibility_engine_type::SWEEP
 	) const;
+
+	/*
+		Hashes everything that calc_visibility reads from the physics world for the request,
+		so a response can be reused for as long as the signature stays the same.
+	*/
+
+	static uint64_t calc_obstacles_signature(
+		const cosmos&,
+		const visibility_request&
+	);
 };
\ No newline at end of file
@@ -0,0 +1,101 @@
+#include <new>
+#include <atomic>
+#include <cstdlib>
+#include <clocale>
+#include <iostream>
+
+#include "augs/log.h"
+#include "augs/log_path_getters.h"
+#include "augs/filesystem/file.h"
+
+#if PLATFORM_WINDOWS
+#include <Windows.h>
+#undef MIN
+#undef MAX
+#endif
+
+#include "application/headless_benchmark.h"
+
+/*
+	Entry point of the Hypersomnia-Benchmark executable.
+	It links against the same objects as the game,
+	but never creates a window, an audio device or a GL context.
+*/
+
+#if PLATFORM_WINDOWS && !BUILD_IN_CONSOLE_MODE
+/* Referenced by the window framework which is linked in, but never used here. */
+HINSTANCE g_myhinst = nullptr;
+#endif
+
+static std::atomic<std::size_t> allocations_so_far = 0;
+
+void* operator new(const std::size_t size) {
+	allocations_so_far.fetch_add(1, std::memory_order_relaxed);
+
+	if (const auto p = std::malloc(size == 0 ? 1 : size)) {
+		return p;
+	}
+
+	throw std::bad_alloc();
+}
+
+void operator delete(void* const p) noexcept {
+	std::free(p);
+}
+
+void operator delete(void* const p, std::size_t) noexcept {
+	std::free(p);
+}
+
+static std::size_t count_allocations() {
+	return allocations_so_far.load(std::memory_order_relaxed);
+}
+
+static const char* const usage =
+"Usage: Hypersomnia-Benchmark [options]\n"
+"    --arena <name>     Arena to load. The testbed is used if none is given.\n"
+"    --players <n>      Number of scripted players (default: 10).\n"
+"    --steps <n>        Number of steps to simulate (default: 10000).\n"
+"    --seed <n>         Seed of the synthetic entropy (default: 1337).\n"
+;
+
+int main(const int argc, const char* const * const argv) {
+	std::setlocale(LC_ALL, "");
+	std::setlocale(LC_NUMERIC, "C");
+
+	auto settings = headless_benchmark_settings();
+	settings.count_allocations = count_allocations;
+
+	for (int i = 1; i < argc;) {
+		const auto a = std::string(argv[i++]);
+		const bool has_value = i < argc;
+
+		if (a == "--help" || a == "-h") {
+			std::cout << usage << std::endl;
+			return EXIT_SUCCESS;
+		}
+		else if (a == "--arena" && has_value) {
+			settings.arena = argv[i++];
+		}
+		else if (a == "--players" && has_value) {
+			settings.players = static_cast<unsigned>(std::atoi(argv[i++]));
+		}
+		else if (a == "--steps" && has_value) {
+			settings.steps = static_cast<unsigned>(std::atoi(argv[i++]));
+		}
+		else if (a == "--seed" && has_value) {
+			settings.seed = static_cast<unsigned>(std::atoi(argv[i++]));
+		}
+		else {
+			std::cout << "Unrecognized argument: " << a << "\n" << usage << std::endl;
+			return EXIT_FAILURE;
+		}
+	}
+
+	const bool success = perform_headless_benchmark(settings);
+
+	const auto logs = program_log::get_current().get_complete();
+	augs::save_as_text(success ? get_exit_success_path() : get_exit_failure_path(), logs);
+
+	return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -3426,6 +3426,7 @@ namespace test_flavours {
 			gun_def.action_mode = gun_action_type::AUTOMATIC;
 			gun_def.muzzle_velocity = {4100.f, 4200.f};
 			gun_def.shot_cooldown_ms = 61.f;
+			gun_def.fires_lightweight_projectiles = true;
 
 			gun_def.shell_angular_velocity = {10000.f, 40000.f};
 			gun_def.shell_spread_degrees = 20.f;
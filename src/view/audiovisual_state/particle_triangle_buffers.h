@@ -3,8 +3,8 @@
 #include "game/enums/particle_layer.h"
 
 struct particle_triangle_buffers {
-	per_particle_layer_t<augs::vertex_triangle_buffer> diffuse;
-	augs::vertex_triangle_buffer neons;
+	per_particle_layer_t<augs::vertex_quad_buffer> diffuse;
+	augs::vertex_quad_buffer neons;
 
 	void clear() {
 		for (auto& p : diffuse) {
@@ -0,0 +1,389 @@
+#include <cmath>
+#include <algorithm>
+
+#include "augs/drawing/make_sprite.h"
+#include "view/viewables/images_in_atlas_map.h"
+#include "view/audiovisual_state/systems/general_particles_soa.h"
+
+/*
+	The drawing is done in batches,
+	so that the intermediate results of every pass fit on the stack.
+*/
+
+static constexpr std::size_t draw_batch_size_v = 256;
+
+template <class F>
+void general_particles_soa::for_each_column(F callback) {
+	callback(pos_x);
+	callback(pos_y);
+	callback(vel_x);
+	callback(vel_y);
+	callback(acc_x);
+	callback(acc_y);
+	callback(rotation);
+	callback(rotation_speed);
+	callback(linear_damping);
+	callback(angular_damping);
+	callback(current_lifetime_ms);
+	callback(max_lifetime_ms);
+	callback(shrink_when_ms_remaining);
+	callback(unshrinking_time_ms);
+	callback(size_x);
+	callback(size_y);
+	callback(image_id);
+	callback(color);
+	callback(alpha_levels);
+}
+
+void general_particles_soa::push_back(const general_particle& p) {
+	if (full()) {
+		return;
+	}
+
+	const auto i = count++;
+
+	pos_x[i] = p.pos.x;
+	pos_y[i] = p.pos.y;
+	vel_x[i] = p.vel.x;
+	vel_y[i] = p.vel.y;
+	acc_x[i] = p.acc.x;
+	acc_y[i] = p.acc.y;
+	rotation[i] = p.rotation;
+	rotation_speed[i] = p.rotation_speed;
+	linear_damping[i] = p.linear_damping;
+	angular_damping[i] = p.angular_damping;
+	current_lifetime_ms[i] = p.current_lifetime_ms;
+	max_lifetime_ms[i] = p.max_lifetime_ms;
+	shrink_when_ms_remaining[i] = p.shrink_when_ms_remaining;
+	unshrinking_time_ms[i] = p.unshrinking_time_ms;
+	size_x[i] = p.size.x;
+	size_y[i] = p.size.y;
+	image_id[i] = p.image_id;
+	color[i] = p.color;
+	alpha_levels[i] = p.alpha_levels;
+}
+
+general_particle general_particles_soa::get(const std::size_t i) const {
+	general_particle p;
+
+	p.pos = { pos_x[i], pos_y[i] };
+	p.vel = { vel_x[i], vel_y[i] };
+	p.acc = { acc_x[i], acc_y[i] };
+	p.rotation = rotation[i];
+	p.rotation_speed = rotation_speed[i];
+	p.linear_damping = linear_damping[i];
+	p.angular_damping = angular_damping[i];
+	p.current_lifetime_ms = current_lifetime_ms[i];
+	p.max_lifetime_ms = max_lifetime_ms[i];
+	p.shrink_when_ms_remaining = shrink_when_ms_remaining[i];
+	p.unshrinking_time_ms = unshrinking_time_ms[i];
+	p.size = { size_x[i], size_y[i] };
+	p.image_id = image_id[i];
+	p.color = color[i];
+	p.alpha_levels = alpha_levels[i];
+
+	return p;
+}
+
+void general_particles_soa::integrate(const std::size_t from, const std::size_t to, const float dt) {
+	/* Same as generic_integrate_particle, with the branches turned into selects. */
+
+	const auto lifetime_step = dt * 1000;
+
+	for (std::size_t i = from; i < to; ++i) {
+		auto vx = vel_x[i] + acc_x[i] * dt;
+		auto vy = vel_y[i] + acc_y[i] * dt;
+
+		pos_x[i] += vx * dt;
+		pos_y[i] += vy * dt;
+
+		const auto amount = linear_damping[i] * dt;
+		const auto len = std::sqrt(vx * vx + vy * vy);
+		const auto mult = amount == 0.f ? 1.f : (len > amount ? (len - amount) / len : 0.f);
+
+		vel_x[i] = vx * mult;
+		vel_y[i] = vy * mult;
+
+		current_lifetime_ms[i] += lifetime_step;
+
+		rotation[i] += rotation_speed[i] * dt;
+
+		const auto rs = rotation_speed[i];
+		const auto angular_amount = angular_damping[i] * dt;
+
+		rotation_speed[i] =
+			rs > 0.f ? std::max(0.f, rs - angular_amount) :
+			rs < 0.f ? std::min(0.f, rs + angular_amount) :
+			rs
+		;
+	}
+}
+
+void general_particles_soa::draw(
+	const std::size_t from,
+	const std::size_t to,
+	const images_in_atlas_map& game_images,
+	augs::vertex_quad* const diffuse_quads,
+	augs::vertex_quad* const neon_quads
+) const {
+	std::array<int, draw_batch_size_v> w;
+	std::array<int, draw_batch_size_v> h;
+	std::array<bool, draw_batch_size_v> visible;
+
+	std::array<float, draw_batch_size_v> s;
+	std::array<float, draw_batch_size_v> c;
+
+	std::array<std::array<float, draw_batch_size_v>, 4> corner_x;
+	std::array<std::array<float, draw_batch_size_v>, 4> corner_y;
+
+	for (std::size_t batch_from = from; batch_from < to; batch_from += draw_batch_size_v) {
+		const auto n = std::min(draw_batch_size_v, to - batch_from);
+
+		/* Sizes, as in general_particle::draw_as_sprite */
+
+		for (std::size_t j = 0; j < n; ++j) {
+			const auto i = batch_from + j;
+
+			const auto current = current_lifetime_ms[i];
+			const auto shrink_when = shrink_when_ms_remaining[i];
+			const auto unshrinking_time = unshrinking_time_ms[i];
+
+			/* Clamped, as the particles may outlive their lifetime by up to a frame before they are removed. */
+			const auto alivity = std::max(0.f, std::min(1.f, (max_lifetime_ms[i] - current) / shrink_when));
+			const auto unshrinking = current / unshrinking_time;
+
+			/* Both are computed unconditionally so that the loop has no branches. */
+			const auto shrinking_mult = std::sqrt(alivity);
+			const auto unshrinking_mult = std::min(1.f, unshrinking * unshrinking);
+
+			const auto size_mult = 
+				(shrink_when > 0.f ? shrinking_mult : 1.f)
+				* (unshrinking_time > 0.f ? unshrinking_mult : 1.f)
+			;
+
+			/* Multiplying by 1 keeps the original size exactly, so there is no need to select it. */
+			const auto drawn_w = static_cast<int>(static_cast<float>(size_x[i]) * size_mult);
+			const auto drawn_h = static_cast<int>(static_cast<float>(size_y[i]) * size_mult);
+
+			w[j] = drawn_w;
+			h[j] = drawn_h;
+			visible[j] = (size_mult == 1.f) | (drawn_w * drawn_h > 1);
+		}
+
+		for (std::size_t j = 0; j < n; ++j) {
+			const auto radians = DEG_TO_RAD<float> * rotation[batch_from + j];
+
+			s[j] = std::sin(radians);
+			c[j] = std::cos(radians);
+		}
+
+		/* Corners, as in augs::make_rect_points */
+
+		for (std::size_t j = 0; j < n; ++j) {
+			const auto i = batch_from + j;
+
+			const auto left = static_cast<float>(-w[j] / 2);
+			const auto top = static_cast<float>(-h[j] / 2);
+			const auto right = left + static_cast<float>(w[j]);
+			const auto bottom = top + static_cast<float>(h[j]);
+
+			const auto px = pos_x[i];
+			const auto py = pos_y[i];
+
+			corner_x[0][j] = left * c[j] - top * s[j] + px;
+			corner_y[0][j] = left * s[j] + top * c[j] + py;
+
+			corner_x[1][j] = right * c[j] - top * s[j] + px;
+			corner_y[1][j] = right * s[j] + top * c[j] + py;
+
+			corner_x[2][j] = right * c[j] - bottom * s[j] + px;
+			corner_y[2][j] = right * s[j] + bottom * c[j] + py;
+
+			corner_x[3][j] = left * c[j] - bottom * s[j] + px;
+			corner_y[3][j] = left * s[j] + bottom * c[j] + py;
+		}
+
+		for (std::size_t j = 0; j < n; ++j) {
+			const auto i = batch_from + j;
+
+			auto& q = diffuse_quads[i - from];
+
+			if (!visible[j]) {
+				q = augs::vertex_quad();
+				continue;
+			}
+
+			const auto points = std::array<vec2, 4> {
+				vec2(corner_x[0][j], corner_y[0][j]),
+				vec2(corner_x[1][j], corner_y[1][j]),
+				vec2(corner_x[2][j], corner_y[2][j]),
+				vec2(corner_x[3][j], corner_y[3][j])
+			};
+
+			augs::write_sprite_quad(q, game_images.at(image_id[i]).diffuse, points, color[i]);
+		}
+
+		if (neon_quads == nullptr) {
+			continue;
+		}
+
+		/* Neon maps have their own sizes, so their corners are computed one by one. */
+
+		for (std::size_t j = 0; j < n; ++j) {
+			const auto i = batch_from + j;
+
+			auto& q = neon_quads[i - from];
+
+			const auto& entry = game_images.at(image_id[i]);
+
+			if (!visible[j] || !entry.neon_map.exists()) {
+				q = augs::vertex_quad();
+				continue;
+			}
+
+			const auto neon_size = vec2i(
+				vec2(entry.neon_map.get_original_size())
+				/ vec2(entry.diffuse.get_original_size())
+				* vec2(vec2i(w[j], h[j]))
+			);
+
+			const auto left = static_cast<float>(-neon_size.x / 2);
+			const auto top = static_cast<float>(-neon_size.y / 2);
+			const auto right = left + static_cast<float>(neon_size.x);
+			const auto bottom = top + static_cast<float>(neon_size.y);
+
+			const auto pos = vec2(pos_x[i], pos_y[i]);
+
+			auto rotated = [&](const float x, const float y) {
+				return vec2(x * c[j] - y * s[j], x * s[j] + y * c[j]) + pos;
+			};
+
+			const auto points = std::array<vec2, 4> {
+				rotated(left, top),
+				rotated(right, top),
+				rotated(right, bottom),
+				rotated(left, bottom)
+			};
+
+			augs::write_sprite_quad(q, entry.neon_map, points, color[i]);
+		}
+	}
+}
+
+void general_particles_soa::remove_dead() {
+	std::array<unsigned, max_count_v> survivors;
+	std::size_t survivors_n = 0;
+
+	for (std::size_t i = 0; i < count; ++i) {
+		survivors[survivors_n] = static_cast<unsigned>(i);
+		survivors_n += !(current_lifetime_ms[i] >= max_lifetime_ms[i]);
+	}
+
+	if (survivors_n == count) {
+		return;
+	}
+
+	for_each_column([&](auto& col) {
+		for (std::size_t i = 0; i < survivors_n; ++i) {
+			col[i] = col[survivors[i]];
+		}
+	});
+
+	count = survivors_n;
+}
+
+#if BUILD_UNIT_TESTS
+#include <memory>
+#include <Catch/single_include/catch2/catch.hpp>
+#include "augs/templates/container_templates.h"
+#include "augs/misc/randomization.h"
+#include "view/viewables/particle_types.hpp"
+
+TEST_CASE("GeneralParticlesSoa SameAsGeneralParticle") {
+	auto rng = randomization(1337);
+
+	std::vector<general_particle> expected;
+	auto soa = std::make_unique<general_particles_soa>();
+
+	for (int i = 0; i < 1000; ++i) {
+		general_particle p;
+
+		p.pos = { rng.randval(-1000.f, 1000.f), rng.randval(-1000.f, 1000.f) };
+		p.vel = vec2::from_degrees(rng.randval(0.f, 360.f)) * rng.randval(0.f, 2000.f);
+		p.acc = vec2::from_degrees(rng.randval(0.f, 360.f)) * rng.randval(0.f, 100.f);
+		p.size = { rng.randval(1, 30), rng.randval(1, 30) };
+		p.rotation = rng.randval(0.f, 360.f);
+		p.rotation_speed = rng.randval(-720.f, 720.f);
+		p.linear_damping = i % 4 == 0 ? 0.f : rng.randval(0.f, 3000.f);
+		p.angular_damping = i % 3 == 0 ? 0.f : rng.randval(0.f, 1000.f);
+		p.max_lifetime_ms = rng.randval(10.f, 400.f);
+		p.shrink_when_ms_remaining = i % 2 == 0 ? 0.f : rng.randval(0.f, 200.f);
+		p.unshrinking_time_ms = i % 5 == 0 ? rng.randval(0.f, 100.f) : 0.f;
+
+		expected.push_back(p);
+		soa->push_back(p);
+	}
+
+	auto approx = [](const float a, const float b) {
+		return std::abs(a - b) <= 0.001f * std::max(1.f, std::abs(b));
+	};
+
+	const auto dt = 1 / 60.f;
+
+	for (int step = 0; step < 40; ++step) {
+		for (auto& p : expected) {
+			p.integrate(dt);
+		}
+
+		soa->integrate(0, soa->size() / 2, dt);
+		soa->integrate(soa->size() / 2, soa->size(), dt);
+
+		erase_if(expected, [](const auto& p) { return p.is_dead(); });
+		soa->remove_dead();
+
+		REQUIRE(soa->size() == expected.size());
+
+		for (std::size_t i = 0; i < expected.size(); ++i) {
+			const auto& e = expected[i];
+			const auto a = soa->get(i);
+
+			REQUIRE(approx(a.pos.x, e.pos.x));
+			REQUIRE(approx(a.pos.y, e.pos.y));
+			REQUIRE(approx(a.vel.x, e.vel.x));
+			REQUIRE(approx(a.vel.y, e.vel.y));
+			REQUIRE(approx(a.rotation, e.rotation));
+			REQUIRE(approx(a.rotation_speed, e.rotation_speed));
+			REQUIRE(a.current_lifetime_ms == e.current_lifetime_ms);
+			REQUIRE(a.max_lifetime_ms == e.max_lifetime_ms);
+			REQUIRE(a.size == e.size);
+		}
+
+		if (step == 5) {
+			const auto images = std::make_unique<images_in_atlas_map>();
+			const auto anims = plain_animations_pool();
+
+			const std::size_t from = 7;
+			const auto n = soa->size() - from;
+
+			std::vector<augs::vertex_quad> quads(n);
+			soa->draw(from, soa->size(), *images, quads.data(), nullptr);
+
+			for (std::size_t i = 0; i < n; ++i) {
+				augs::vertex_quad q;
+
+				expected[from + i].draw_as_sprite<false>(q, *images, anims);
+
+				for (std::size_t v = 0; v < 4; ++v) {
+					REQUIRE(approx(quads[i].vertices[v].pos.x, q.vertices[v].pos.x));
+					REQUIRE(approx(quads[i].vertices[v].pos.y, q.vertices[v].pos.y));
+				}
+			}
+		}
+	}
+
+	REQUIRE(soa->size() < 1000);
+
+	soa->clear();
+	REQUIRE(soa->empty());
+}
+#endif
@@ -0,0 +1,97 @@
+#pragma once
+#include <array>
+#include <cstddef>
+
+#include "augs/math/vec2.h"
+#include "augs/graphics/rgba.h"
+#include "augs/graphics/vertex.h"
+#include "view/viewables/particle_types.h"
+
+class images_in_atlas_map;
+
+/*
+	General particles of a single layer, stored as a structure of arrays.
+
+	All of them are integrated and turned into a quad each every frame,
+	so every field lies in its own contiguous array
+	and the loops over them are written without branches, letting the compiler vectorize them.
+
+	Dead particles are removed by compacting all arrays at once, preserving the order.
+*/
+
+class general_particles_soa {
+public:
+	static constexpr std::size_t max_count_v = general_particle::statically_allocate;
+
+private:
+	template <class T>
+	using column = std::array<T, max_count_v>;
+
+	std::size_t count = 0;
+
+	/* Integrated every frame */
+	column<float> pos_x;
+	column<float> pos_y;
+	column<float> vel_x;
+	column<float> vel_y;
+	column<float> acc_x;
+	column<float> acc_y;
+	column<float> rotation;
+	column<float> rotation_speed;
+	column<float> linear_damping;
+	column<float> angular_damping;
+	column<float> current_lifetime_ms;
+	column<float> max_lifetime_ms;
+
+	/* Only read when drawing */
+	column<float> shrink_when_ms_remaining;
+	column<float> unshrinking_time_ms;
+	column<int> size_x;
+	column<int> size_y;
+	column<assets::image_id> image_id;
+	column<rgba> color;
+	column<int> alpha_levels;
+
+	template <class F>
+	void for_each_column(F callback);
+
+public:
+	std::size_t size() const {
+		return count;
+	}
+
+	bool empty() const {
+		return count == 0;
+	}
+
+	bool full() const {
+		return count == max_count_v;
+	}
+
+	void clear() {
+		count = 0;
+	}
+
+	/* Does nothing if full. */
+	void push_back(const general_particle&);
+
+	general_particle get(std::size_t index) const;
+
+	void integrate(std::size_t from, std::size_t to, float dt);
+
+	/*
+		Writes a quad for every particle in the range, starting at the passed ones.
+		Particles that shrank to nothing get degenerate quads.
+		If neon_quads is not null, the neon maps are written there as well.
+	*/
+
+	void draw(
+		std::size_t from,
+		std::size_t to,
+		const images_in_atlas_map& game_images,
+		augs::vertex_quad* diffuse_quads,
+		augs::vertex_quad* neon_quads
+	) const;
+
+	void remove_dead();
+};
@@ -174,13 +174,7 @@ void particles_simulation_system::clear() {
 }
 
 void particles_simulation_system::add_particle(const particle_layer l, const general_particle& p) {
-	auto& v = general_particles[l];
-
-	if (container_full(v)) {
-		return;
-	}
-
-	v.push_back(p);
+	general_particles[l].push_back(p);
 }
 
 void particles_simulation_system::add_particle(const particle_layer l, const animated_particle& p) {
@@ -343,7 +337,7 @@ void particles_simulation_system::remove_dead_particles(const cosmos& cosm) {
 	};
 
 	for (auto& particle_layer : general_particles) {
-		dead_particles_remover(particle_layer);
+		particle_layer.remove_dead();
 	}
 
 	for (auto& particle_layer : animated_particles) {
@@ -368,16 +362,15 @@ void particles_simulation_system::remove_dead_particles(const cosmos& cosm) {
 void particles_simulation_system::preallocate_particle_buffers(particle_triangle_buffers& buffers) const {
 	augs::for_each_enum_except_bounds([&](const particle_layer p) {
 		const auto total_on_layer = count_particles_on_layer(p);
-		const auto total_triangles_on_layer = total_on_layer * 2;
 
 		{
 			auto& target_buffer = buffers.diffuse[p];
-			target_buffer.resize(total_triangles_on_layer);
+			target_buffer.resize(total_on_layer);
 		}
 
 		if (p == particle_layer::NEONING_PARTICLES) {
 			auto& target_buffer = buffers.neons;
-			target_buffer.resize(total_triangles_on_layer);
+			target_buffer.resize(total_on_layer);
 		}
 	});
 }
@@ -397,58 +390,69 @@ void particles_simulation_system::integrate_and_draw_all_particles(const integra
 	const auto delta = in.dt.in_seconds();
 
 	auto generic_integrate = [&anims, delta](const particle_layer, auto& range, int, int from_i, const int till_i, auto&&... args) {
-		using P = typename remove_cref<decltype(range)>::value_type;
+		using R = remove_cref<decltype(range)>;
 
-		for (; from_i < till_i; ++from_i) {
-			auto& particle = range[from_i];
+		if constexpr(std::is_same_v<R, general_particles_soa>) {
+			range.integrate(from_i, till_i, delta);
+		}
+		else {
+			using P = typename R::value_type;
 
-			if constexpr(std::is_same_v<P, general_particle>) {
-				particle.integrate(delta);
-			}
-			else if constexpr(std::is_same_v<P, animated_particle>) {
-				particle.integrate(delta, anims);
-			}
-			else if constexpr(std::is_same_v<P, homing_animated_particle>) {
-				particle.integrate(delta, anims, std::forward<decltype(args)>(args)...);
-			}
-			else {
-				static_assert(always_false_v<P>, "Unimplemented!");
+			for (; from_i < till_i; ++from_i) {
+				auto& particle = range[from_i];
+
+				if constexpr(std::is_same_v<P, animated_particle>) {
+					particle.integrate(delta, anims);
+				}
+				else if constexpr(std::is_same_v<P, homing_animated_particle>) {
+					particle.integrate(delta, anims, std::forward<decltype(args)>(args)...);
+				}
+				else {
+					static_assert(always_false_v<P>, "Unimplemented!");
+				}
 			}
 		}
 	};
 
 	auto generic_draw = [&output_buffers, &game_images, &anims](const particle_layer p, auto& range, const int layer_index, const int from_i, const int till_i, auto&&...) {
-		{
-			auto& target_buffer = output_buffers.diffuse[p];
+		using R = remove_cref<decltype(range)>;
 
-			auto li = layer_index;
+		if constexpr(std::is_same_v<R, general_particles_soa>) {
+			const auto neon_quads = 
+				p == particle_layer::NEONING_PARTICLES 
+				? output_buffers.neons.data() + layer_index 
+				: nullptr
+			;
 
-			for (int i = from_i; i < till_i; ++i) {
-				auto& particle = range[i];
+			range.draw(from_i, till_i, game_images, output_buffers.diffuse[p].data() + layer_index, neon_quads);
+		}
+		else {
+			{
+				auto& target_buffer = output_buffers.diffuse[p];
 
-				auto& t1 = target_buffer[2 * li];
-				auto& t2 = target_buffer[2 * li + 1];
+				auto li = layer_index;
 
-				particle.template draw_as_sprite<false>(t1, t2, game_images, anims);
+				for (int i = from_i; i < till_i; ++i) {
+					auto& particle = range[i];
 
-				++li;
-			}
-		}
+					particle.template draw_as_sprite<false>(target_buffer[li], game_images, anims);
 
-		if (p == particle_layer::NEONING_PARTICLES) {
-			auto& target_buffer = output_buffers.neons;
+					++li;
+				}
+			}
 
-			auto li = layer_index;
+			if (p == particle_layer::NEONING_PARTICLES) {
+				auto& target_buffer = output_buffers.neons;
 
-			for (int i = from_i; i < till_i; ++i) {
-				auto& particle = range[i];
+				auto li = layer_index;
 
-				auto& t1 = target_buffer[2 * li];
-				auto& t2 = target_buffer[2 * li + 1];
+				for (int i = from_i; i < till_i; ++i) {
+					auto& particle = range[i];
 
-				particle.template draw_as_sprite<true>(t1, t2, game_images, anims);
+					particle.template draw_as_sprite<true>(target_buffer[li], game_images, anims);
 
-				++li;
+					++li;
+				}
 			}
 		}
 	};
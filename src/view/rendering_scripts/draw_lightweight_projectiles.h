@@ -0,0 +1,52 @@
+#pragma once
+#include "augs/drawing/drawing.hpp"
+#include "game/cosmos/cosmos.h"
+#include "game/components/sprite_component.h"
+#include "game/detail/missile/lightweight_projectile.h"
+#include "view/viewables/images_in_atlas_map.h"
+
+/*
+	Lightweight projectiles have no entity to draw,
+	so each is drawn as a streak of its round's sprite behind the current position.
+
+	The position is interpolated between the previous and the current step
+	with the same ratio that is used for entities.
+*/
+
+struct draw_lightweight_projectiles_in {
+	const augs::drawer output;
+	const images_in_atlas_map& game_images;
+	const double interpolation_ratio;
+};
+
+inline void draw_lightweight_projectiles(
+	const cosmos& cosm,
+	const draw_lightweight_projectiles_in in
+) {
+	const auto dt_secs = cosm.get_fixed_delta().in_seconds();
+	const auto ratio = static_cast<real32>(in.interpolation_ratio);
+
+	for (const auto& p : cosm.get_global_solvable().lightweight_projectiles) {
+		const auto speed = p.vel.length();
+
+		if (speed <= 0.f) {
+			continue;
+		}
+
+		cosm.on_flavour(p.round_flavour, [&](const auto& typed_flavour) {
+			if (const auto sprite = typed_flavour.template find<invariants::sprite>()) {
+				const auto dir = p.vel / speed;
+				const auto to = p.pos + p.vel * dt_secs * (ratio - 1.f);
+				const auto from = to - dir * sprite->size.x;
+
+				in.output.line(
+					in.game_images.at(sprite->image_id).diffuse,
+					from,
+					to,
+					static_cast<real32>(sprite->size.y),
+					sprite->color
+				);
+			}
+		});
+	}
+}
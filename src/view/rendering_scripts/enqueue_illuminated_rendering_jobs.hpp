@@ -47,8 +47,32 @@ void enqueue_illuminated_rendering_jobs(
 
 	const auto global_time_seconds = cosm.get_total_seconds_passed(in.interpolation_ratio);
 
+	/* 
+		Neons are drawn with additive blending, so the order in which they are drawn does not matter
+		and their sprites can be written as quads, to be drawn after the rest of their geometry.
+	*/
+
+	auto writes_quads = [](const D d) {
+		switch (d) {
+			case D::FLOOR_NEONS:
+			case D::BODY_NEONS:
+			case D::DECORATION_NEONS:
+			case D::NEONS_FRIENDLY_SENTIENCES:
+			case D::NEONS_ENEMY_SENTIENCES:
+				return true;
+			default:
+				return false;
+		}
+	};
+
 	auto get_drawer_for = [&](const D d) {
-		return augs::drawer_with_default { dedicated[d].triangles, necessarys.at(assets::necessary_image_id::BLANK) };
+		auto& buffers = dedicated[d];
+
+		return augs::drawer_with_default { 
+			buffers.triangles,
+			necessarys.at(assets::necessary_image_id::BLANK),
+			writes_quads(d) ? std::addressof(buffers.quads) : nullptr
+		};
 	};
 
 	auto make_drawing_input = [get_drawer_for, &game_images, global_time_seconds, &av, &interp, queried_cone](const D d) {
@@ -277,6 +301,15 @@ void enqueue_illuminated_rendering_jobs(
 			};
 		};
 
+		auto make_static_helper = [&](const D d) {
+			return helper_drawer {
+				visible,
+				cosm,
+				make_drawing_input(d),
+				std::addressof(in.static_layers)
+			};
+		};
+
 		{
 			auto job = [h1 = make_helper(D::WALL_LIGHTED_BODIES), h2 = make_helper(D::OVER_SENTIENCES), h3 = make_helper(D::NEON_OCCLUDING_DYNAMIC_BODY)]() {
 				h1.draw<
@@ -297,7 +330,7 @@ void enqueue_illuminated_rendering_jobs(
 		}
 
 		{
-			auto job = [h = make_helper(D::DECORATION_NEONS)]() {
+			auto job = [h = make_static_helper(D::DECORATION_NEONS)]() {
 				h.draw_neons<
 					render_layer::FLYING_BULLETS,
 					render_layer::WATER_COLOR_OVERLAYS,
@@ -334,7 +367,7 @@ void enqueue_illuminated_rendering_jobs(
 		}
 
 		{
-			auto job = [h1 = make_helper(D::FLOOR_NEONS), h2 = make_helper(D::FLOOR_NEON_OVERLAYS)]() {
+			auto job = [h1 = make_static_helper(D::FLOOR_NEONS), h2 = make_helper(D::FLOOR_NEON_OVERLAYS)]() {
 				h1.draw_neons<
 					render_layer::FLOOR_AND_ROAD,
 					render_layer::ON_FLOOR,
@@ -362,7 +395,7 @@ void enqueue_illuminated_rendering_jobs(
 		}
 
 		{
-			auto job = [h = make_helper(D::GROUND_FLOORS_DECORS)]() {
+			auto job = [h = make_static_helper(D::GROUND_FLOORS_DECORS)]() {
 				h.draw<
 					render_layer::UNDER_GROUND,
 					render_layer::GROUND,
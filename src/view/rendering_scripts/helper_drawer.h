@@ -2,14 +2,23 @@
 #include "view/rendering_scripts/draw_entity.h"
 #include "game/cosmos/cosmos.h"
 #include "game/detail/visible_entities.h"
+#include "view/rendering_scripts/static_layers_cache.h"
 
 struct helper_drawer {
 	const visible_entities& visible;
 	const cosmos& cosm;
 	const draw_renderable_input in;
 
+	/* If set, retained entities of every layer are appended from the cache before the rest of the layer. */
+	const static_layers_cache* const static_layers = nullptr;
+
 	template <render_layer... r>
 	void draw() const {
+		if (static_layers != nullptr) {
+			(draw_with_static<r>(), ...);
+			return;
+		}
+
 		visible.for_each<r...>(cosm, [&](const auto& handle) {
 			::draw_entity(handle, in);
 		});
@@ -17,11 +26,38 @@ struct helper_drawer {
 
 	template <render_layer... r>
 	void draw_neons() const {
+		if (static_layers != nullptr) {
+			(draw_neons_with_static<r>(), ...);
+			return;
+		}
+
 		visible.for_each<r...>(cosm, [&](const auto& handle) {
 			::draw_neon_map(handle, in);
 		});
 	}
 
+	template <render_layer r>
+	void draw_with_static() const {
+		static_layers->append_diffuse(r, in.cone, in.drawer.output_buffer);
+
+		visible.for_each<r>(cosm, [&](const auto& handle) {
+			if (!static_layers->is_retained(handle)) {
+				::draw_entity(handle, in);
+			}
+		});
+	}
+
+	template <render_layer r>
+	void draw_neons_with_static() const {
+		static_layers->append_neons(r, in.cone, in.drawer);
+
+		visible.for_each<r>(cosm, [&](const auto& handle) {
+			if (!static_layers->is_retained(handle)) {
+				::draw_neon_map(handle, in);
+			}
+		});
+	}
+
 	template <render_layer... r, class F>
 	void draw_border(F&& provider) const {
 		visible.for_each<r...>(cosm, [&](const auto& handle) {
@@ -27,6 +27,7 @@
 #include "view/rendering_scripts/illuminated_rendering.h"
 #include "view/rendering_scripts/helper_drawer.h"
 #include "view/rendering_scripts/draw_area_indicator.h"
+#include "view/rendering_scripts/draw_lightweight_projectiles.h"
 
 #include "view/viewables/all_viewables_declaration.h"
 #include "view/viewables/image_in_atlas.h"
@@ -152,11 +153,11 @@ void illuminated_rendering(const illuminated_rendering_input in) {
 	renderer.set_additive_blending();
 	
 	auto draw_particles = [&](const particle_layer layer) {
-		renderer.call_triangles(in.drawn_particles.diffuse[layer]);
+		renderer.call_quads(in.drawn_particles.diffuse[layer]);
 	};
 
 	auto draw_particles_neons = [&]() {
-		renderer.call_triangles(in.drawn_particles.neons);
+		renderer.call_quads(in.drawn_particles.neons);
 	};
 
 	draw_particles(particle_layer::DIM_SMOKES);
@@ -485,6 +486,9 @@ void illuminated_rendering(const illuminated_rendering_input in) {
 	
 	renderer.call_triangles(D::CAPTIONS_AND_BULLETS);
 
+	draw_lightweight_projectiles(cosm, { get_drawer(), game_images, in.interpolation_ratio });
+	renderer.call_and_clear_triangles();
+
 	if (settings.draw_crosshairs) {
 		auto draw_crosshair = [&](const auto it) {
 			if (const auto s = it.find_crosshair_def()) {
@@ -28,6 +28,7 @@ struct performance_settings;
 
 class images_in_atlas_map;
 class visible_entities;
+class static_layers_cache;
 
 /* Require all */
 
@@ -61,6 +62,7 @@ struct illuminated_rendering_input {
 	const std::vector<special_indicator>& special_indicators;
 	const special_indicator_meta& indicator_meta;
 	const particle_triangle_buffers& drawn_particles;
+	const static_layers_cache& static_layers;
 	
 	const std::vector<visibility_request>& light_requests;
 	augs::thread_pool& pool;
@@ -1,6 +1,7 @@
 #pragma once
 #include "view/rendering_scripts/vis_response_to_triangles.h"
 #include "game/enums/filters.h"
+#include "augs/templates/container_templates.h"
 
 inline void enqueue_visibility_jobs(
 	augs::thread_pool& pool,
@@ -21,26 +22,48 @@ inline void enqueue_visibility_jobs(
 		const auto& light_requests = cached_visibility.light_requests;
 		const auto lights_n = light_requests.size();
 
-		auto& light_responses = cached_visibility.light_responses;
-		light_responses.resize(lights_n);
+		auto& light_cache = cached_visibility.light_cache;
+		const auto current_frame = ++cached_visibility.current_frame;
 
 		auto& light_triangles_vectors = dedicated[DV::LIGHT_VISIBILITY];
 		light_triangles_vectors.resize(lights_n);
 
+		/*
+			All entries have to be inserted before any job starts,
+			so that the jobs can hold references to them.
+		*/
+
+		for (const auto& request : light_requests) {
+			light_cache[request.subject].last_used_frame = current_frame;
+		}
+
+		erase_if(light_cache, [current_frame](const auto& entry) {
+			return entry.second.last_used_frame != current_frame;
+		});
+
 		for (std::size_t i = 0; i < lights_n; ++i) {
 			const auto& request = light_requests[i];
-			auto& response = light_responses[i];
 
 			if (!request.valid()) {
-				response.clear();
 				continue;
 			}
 
+			auto& cached = light_cache.at(request.subject);
 			auto& triangles = light_triangles_vectors[i].triangles;
 
-			auto light_job = [&cosm, request, &response, &triangles]() {
-				visibility_system(DEBUG_FRAME_LINES).calc_visibility(cosm, request, response);
-				vis_response_to_triangles(response, triangles, request.color, request.eye_transform.pos);
+			auto light_job = [&cosm, request, &cached, &triangles]() {
+				const auto signature = visibility_system::calc_obstacles_signature(cosm, request);
+
+				if (!cached.is_up_to_date(request, signature)) {
+					visibility_system(DEBUG_FRAME_LINES).calc_visibility(cosm, request, cached.response);
+					vis_response_to_triangles(cached.response, cached.triangles, request.color, request.eye_transform.pos);
+
+					cached.request = request;
+					cached.obstacles_signature = signature;
+					cached.calculated = true;
+				}
+
+				triangles = cached.triangles;
 			};
 
 			pool.enqueue(light_job);
@@ -0,0 +1,252 @@
+#include <unordered_map>
+
+#include "augs/templates/container_templates.h"
+
+#include "game/cosmos/cosmos.h"
+#include "game/cosmos/entity_handle.h"
+#include "game/cosmos/for_each_entity.h"
+#include "game/detail/calc_render_layer.h"
+#include "view/audiovisual_state/systems/interpolation_system.h"
+
+#include "view/rendering_scripts/draw_entity.h"
+#include "view/rendering_scripts/static_layers_cache.h"
+
+template <class E>
+using is_sprite_decoration = std::is_same<E, sprite_decoration>;
+
+template <class H>
+static bool is_retainable(const H& typed_handle) {
+	if constexpr(is_sprite_decoration<entity_type_of<H>>::value) {
+		const auto& sprite = typed_handle.template get<invariants::sprite>();
+
+		/* Tiled sprites only generate the tiles visible in the camera. */
+
+		return
+			sprite.effect == augs::sprite_special_effect::NONE
+			&& !sprite.neon_intensity_vibration.is_enabled
+			&& !sprite.tile_excess_size
+		;
+	}
+	else {
+		(void)typed_handle;
+		return false;
+	}
+}
+
+bool static_layers_cache::is_retained(const const_entity_handle& handle) const {
+	return found_in(baked_entities, handle.get_id());
+}
+
+void static_layers_cache::update(const static_layers_cache_input in) {
+	const auto revision = in.cosm.get_solvable_inferred().tree_of_npo.get_revision_of<sprite_decoration>();
+
+	const bool up_to_date =
+		baked_revision == revision
+		&& baked_game_images_revision == in.game_images_revision
+	;
+
+	if (!up_to_date) {
+		rebuild(in);
+
+		baked_revision = revision;
+		baked_game_images_revision = in.game_images_revision;
+	}
+}
+
+void static_layers_cache::rebuild(const static_layers_cache_input in) {
+	tiles.clear();
+	baked_entities.clear();
+
+	std::unordered_map<vec2i, std::size_t> tile_indices;
+
+	auto make_input = [&](augs::vertex_triangle_buffer& output, augs::vertex_quad_buffer* const quad_output = nullptr) {
+		return draw_renderable_input {
+			{
+				augs::drawer { output, quad_output },
+				in.game_images,
+				0.0,
+				flip_flags(),
+				in.randomizing,
+				camera_cone(camera_eye(), vec2i())
+			},
+			in.interp
+		};
+	};
+
+	in.cosm.for_each_entity<is_sprite_decoration>([&](const auto& typed_handle) {
+		if (!::is_retainable(typed_handle)) {
+			return;
+		}
+
+		const auto aabb = typed_handle.find_aabb();
+
+		if (aabb == std::nullopt) {
+			return;
+		}
+
+		const auto center = aabb->get_center();
+
+		const auto coords = vec2i(
+			static_cast<int>(repro::floor(center.x / tile_size_v)),
+			static_cast<int>(repro::floor(center.y / tile_size_v))
+		);
+
+		auto& tile = [&]() -> auto& {
+			if (const auto found = mapped_or_nullptr(tile_indices, coords)) {
+				auto& existing = tiles[*found];
+				existing.bounds.contain(*aabb);
+
+				return existing;
+			}
+
+			tile_indices.emplace(coords, tiles.size());
+
+			auto& created = tiles.emplace_back();
+			created.bounds = *aabb;
+
+			return created;
+		}();
+
+		const auto layer = ::calc_render_layer(typed_handle);
+		const auto drawn = *in.cosm[typed_handle.get_id()];
+
+		::specific_draw_entity(drawn, make_input(tile.diffuse[layer]));
+		::specific_draw_neon_map(drawn, make_input(tile.neons[layer], std::addressof(tile.neon_quads[layer])));
+
+		baked_entities.emplace(typed_handle.get_id());
+	});
+}
+
+template <class F>
+void static_layers_cache::for_each_visible_tile(const camera_cone& cone, F callback) const {
+	const auto visible_aabb = cone.get_visible_world_rect_aabb();
+
+	for (const auto& t : tiles) {
+		if (t.bounds.hover(visible_aabb)) {
+			callback(t);
+		}
+	}
+}
+
+void static_layers_cache::append_diffuse(
+	const render_layer layer,
+	const camera_cone& cone,
+	augs::vertex_triangle_buffer& output
+) const {
+	for_each_visible_tile(cone, [&](const tile& t) {
+		const auto& source = t.diffuse[layer];
+		output.insert(output.end(), source.begin(), source.end());
+	});
+}
+
+void static_layers_cache::append_neons(
+	const render_layer layer,
+	const camera_cone& cone,
+	const augs::drawer& output
+) const {
+	for_each_visible_tile(cone, [&](const tile& t) {
+		const auto& source = t.neons[layer];
+		output.output_buffer.insert(output.output_buffer.end(), source.begin(), source.end());
+
+		const auto& source_quads = t.neon_quads[layer];
+
+		if (const auto quads = output.quad_output) {
+			quads->insert(quads->end(), source_quads.begin(), source_quads.end());
+		}
+		else {
+			for (const auto& q : source_quads) {
+				output.push_quad(q);
+			}
+		}
+	});
+}
+
+#if BUILD_UNIT_TESTS && BUILD_TEST_SCENES
+#include <Catch/single_include/catch2/catch.hpp>
+#include "augs/misc/lua/lua_utils.h"
+#include <sol2/sol.hpp>
+#include "game/cosmos/cosmic_functions.h"
+#include "game/modes/test_mode.h"
+#include "view/viewables/images_in_atlas_map.h"
+#include "view/audiovisual_state/systems/randomizing_system.h"
+#include "test_scenes/test_scene_settings.h"
+#include "test_scenes/create_test_scene_entity.h"
+#include "application/intercosm.h"
+
+TEST_CASE("StaticLayersCache RebuildsAfterDecorationChanges") {
+	auto lua = augs::create_lua_state();
+
+	auto scene = std::make_unique<intercosm>();
+	auto ruleset = test_mode_ruleset();
+
+	scene->make_test_scene(lua, { true, 60 }, ruleset);
+
+	auto& world = scene->world;
+
+	const auto images = std::make_unique<images_in_atlas_map>();
+	randomizing_system randomizing;
+	interpolation_system interp;
+
+	static_layers_cache cache;
+
+	auto update = [&]() {
+		cache.update({ world, *images, 0, randomizing, interp });
+	};
+
+	auto create_dune = [&](const vec2 pos) {
+		const auto handle = create_test_scene_entity(world, test_sprite_decorations::DUNE_SMALL, pos);
+		handle.set_logical_size(vec2(100, 100));
+		return handle.get_id();
+	};
+
+	auto num_retained_triangles_at = [&](const vec2 pos) {
+		augs::vertex_triangle_buffer output;
+		const auto cone = camera_cone(camera_eye(transformr(pos)), vec2i(200, 200));
+
+		cache.append_diffuse(render_layer::AQUARIUM_DUNES, cone, output);
+		return output.size();
+	};
+
+	const auto first_pos = vec2(0, 0);
+	const auto moved_pos = vec2(5000, 0);
+
+	const auto first = create_dune(first_pos);
+	update();
+
+	REQUIRE(cache.is_retained(world[first]));
+	REQUIRE(num_retained_triangles_at(first_pos) > 0);
+
+	{
+		/* A decoration created after the bake is drawn every frame until the next rebuild. */
+
+		const auto second = create_dune(vec2(-5000, 0));
+		REQUIRE(!cache.is_retained(world[second]));
+
+		update();
+		REQUIRE(cache.is_retained(world[second]));
+	}
+
+	{
+		/* Reinference */
+
+		world[first].set_logic_transform(transformr(moved_pos));
+		cosmic::infer_caches_for(world[first]);
+
+		update();
+
+		REQUIRE(cache.is_retained(world[first]));
+		REQUIRE(num_retained_triangles_at(first_pos) == 0);
+		REQUIRE(num_retained_triangles_at(moved_pos) > 0);
+	}
+
+	{
+		/* Destruction */
+
+		cosmic::delete_entity(world[first]);
+
+		update();
+
+		REQUIRE(num_retained_triangles_at(moved_pos) == 0);
+	}
+}
+#endif
@@ -0,0 +1,70 @@
+#pragma once
+#include <vector>
+#include <optional>
+#include <unordered_set>
+
+#include "augs/graphics/vertex.h"
+#include "augs/math/camera_cone.h"
+#include "game/cosmos/entity_id.h"
+#include "game/cosmos/entity_handle_declaration.h"
+#include "game/detail/visible_entities.h"
+
+namespace augs {
+	struct drawer;
+}
+
+class cosmos;
+class images_in_atlas_map;
+class interpolation_system;
+struct randomizing_system;
+
+struct static_layers_cache_input {
+	const cosmos& cosm;
+	const images_in_atlas_map& game_images;
+	const uint32_t game_images_revision;
+	randomizing_system& randomizing;
+	const interpolation_system& interp;
+};
+
+/*
+	Sprite decorations without any time-dependent effects look the same in every frame,
+	so their triangles are generated once and retained in square tiles of the world
+	until any sprite decoration changes or the atlas is regenerated.
+
+	Every decoration is retained in exactly one tile - the one containing the center of its AABB.
+	The bounds of a tile enclose the AABBs of all of its decorations,
+	so the tiles hovering the camera contain everything that would otherwise be drawn.
+	Decorations without an AABB are not baked and keep being drawn every frame.
+*/
+
+class static_layers_cache {
+	struct tile {
+		ltrb bounds;
+		per_render_layer_t<augs::vertex_triangle_buffer> diffuse;
+		per_render_layer_t<augs::vertex_triangle_buffer> neons;
+		per_render_layer_t<augs::vertex_quad_buffer> neon_quads;
+	};
+
+	std::vector<tile> tiles;
+	std::unordered_set<entity_id> baked_entities;
+
+	std::optional<uint64_t> baked_revision;
+	std::optional<uint32_t> baked_game_images_revision;
+
+	void rebuild(static_layers_cache_input);
+
+	template <class F>
+	void for_each_visible_tile(const camera_cone&, F callback) const;
+
+public:
+	static constexpr real32 tile_size_v = 1024.f;
+
+	void update(static_layers_cache_input);
+
+	/* Whether the entity was baked by the last rebuild, so it is drawn from this cache instead of every frame. */
+	bool is_retained(const const_entity_handle&) const;
+
+	void append_diffuse(render_layer, const camera_cone&, augs::vertex_triangle_buffer& output) const;
+	/* Neon sprites are retained as quads and written as triangles if the drawer has no quad output. */
+	void append_neons(render_layer, const camera_cone&, const augs::drawer& output) const;
+};
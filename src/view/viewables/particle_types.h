@@ -47,8 +47,7 @@ struct general_particle {
 
 	template <bool use_neon_maps, class M>
 	void draw_as_sprite(
-		augs::vertex_triangle& t1,
-		augs::vertex_triangle& t2,
+		augs::vertex_quad& q,
 		const M& manager,
 		const plain_animations_pool&
 	) const {
@@ -77,10 +76,10 @@ struct general_particle {
 
 		auto draw = [&](const vec2i drawn_size) {
 			if constexpr(use_neon_maps) {
-				augs::detail_write_neon_sprite(t1, t2, manager.at(image_id), drawn_size, pos, rotation, color);
+				augs::detail_write_neon_sprite(q, manager.at(image_id), drawn_size, pos, rotation, color);
 			}
 			else {
-				augs::detail_write_sprite(t1, t2, manager.at(image_id), drawn_size, pos, rotation, color);
+				augs::detail_write_sprite(q, manager.at(image_id), drawn_size, pos, rotation, color);
 			}
 		};
 
@@ -174,18 +173,17 @@ struct animated_particle {
 
 	template <bool use_neon_maps, class M>
 	void draw_as_sprite(
-		augs::vertex_triangle& t1,
-		augs::vertex_triangle& t2,
+		augs::vertex_quad& q,
 		const M& manager,
 		const plain_animations_pool& anims
 	) const {
 		const auto image_id = animation.get_image_id(anims);
 
 		if constexpr(use_neon_maps) {
-			augs::detail_write_neon_sprite(t1, t2, manager.at(image_id), pos, 0, color);
+			augs::detail_write_neon_sprite(q, manager.at(image_id), pos, 0, color);
 		}
 		else {
-			augs::detail_write_sprite(t1, t2, manager.at(image_id), pos, 0, color);
+			augs::detail_write_sprite(q, manager.at(image_id), pos, 0, color);
 		}
 	}
 
@@ -228,18 +226,17 @@ struct homing_animated_particle {
 
 	template <bool use_neon_maps, class M>
 	void draw_as_sprite(
-		augs::vertex_triangle& t1,
-		augs::vertex_triangle& t2,
+		augs::vertex_quad& q,
 		const M& manager,
 		const plain_animations_pool& anims
 	) const {
 		const auto image_id = animation.get_image_id(anims);
 
 		if constexpr(use_neon_maps) {
-			augs::detail_write_neon_sprite(t1, t2, manager.at(image_id), pos, 0, color);
+			augs::detail_write_neon_sprite(q, manager.at(image_id), pos, 0, color);
 		}
 		else {
-			augs::detail_write_sprite(t1, t2, manager.at(image_id), pos, 0, color);
+			augs::detail_write_sprite(q, manager.at(image_id), pos, 0, color);
 		}
 	}
 
@@ -68,13 +68,13 @@ void regenerate_and_gather_subjects(
 			static augs::thread_pool workers = 0;
 			workers.resize(num_workers);
 
+			augs::task_group regenerations;
+
 			for (const auto& d : in.image_definitions) {
-				workers.enqueue([&d, worker]() { worker(d); });
+				workers.run(regenerations, [&d, worker]() { worker(d); });
 			}
 
-			workers.submit();
-			workers.help_until_no_tasks();
-			workers.wait_for_all_tasks_to_complete();
+			workers.wait(regenerations);
 		}
 
 		for (const auto& d : in.image_definitions) {
@@ -326,6 +326,7 @@ void viewables_streaming::finalize_load(viewables_finalize_input in) {
 		general_atlas_progress = std::nullopt;
 
 		images_in_atlas = std::move(result.atlas_entries);
+		++images_in_atlas_revision;
 		necessary_images_in_atlas = std::move(result.necessary_atlas_entries);
 		loaded_gui_fonts = std::move(result.gui_fonts);
 
@@ -87,6 +87,7 @@ public:
 
 	loaded_sounds_map loaded_sounds;
 	images_in_atlas_map images_in_atlas;
+	uint32_t images_in_atlas_revision = 0;
 	avatars_in_atlas_map avatars_in_atlas;
 	necessary_images_in_atlas_map necessary_images_in_atlas;
 
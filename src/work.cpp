@@ -2,9 +2,19 @@
 #include <csignal>
 #endif
 
+#include <limits>
+#include <algorithm>
 #include <functional>
 
 #include "fp_consistency_tests.h"
+#include "application/entity_storage_benchmark.h"
+#include "application/physics_clone_benchmark.h"
+#include "application/thread_pool_benchmark.h"
+#include "application/server_step_benchmark.h"
+#include "application/visibility_benchmark.h"
+#include "application/reprediction_copy_benchmark.h"
+#include "application/sprite_vertices_benchmark.h"
+#include "application/authoritative_solve_test.h"
 
 #include "augs/log_path_getters.h"
 #include "augs/unit_tests.h"
@@ -62,6 +72,9 @@
 #include "application/gui/ingame_menu_gui.h"
 
 #include "application/masterserver/masterserver.h"
+#include "application/relay/spectator_relay.h"
+#include "application/relay/spectator_relay_test.h"
+#include "application/load_test/load_test_swarm.h"
 
 #include "application/network/network_common.h"
 #include "application/setups/all_setups.h"
@@ -92,6 +105,7 @@
 #include "application/setups/editor/editor_popup.h"
 #include "application/main/game_frame_buffer.h"
 #include "application/main/cached_visibility_data.h"
+#include "view/rendering_scripts/static_layers_cache.h"
 #include "augs/graphics/frame_num_type.h"
 #include "view/rendering_scripts/launch_visibility_jobs.h"
 #include "view/rendering_scripts/for_each_vis_request.h"
@@ -259,6 +273,48 @@ work_result work(const int argc, const char* const * const argv) try {
 		LOG("Unit tests were disabled.");
 	}
 
+	if (!params.benchmark.empty()) {
+		const auto amount = static_cast<unsigned>(params.benchmark_amount);
+
+		const std::pair<const char*, std::function<bool()>> benchmarks[] = {
+			{ "entity-storage", [&]() { return perform_entity_storage_benchmark(lua, amount); } },
+			{ "physics-clone", [&]() { return perform_physics_clone_benchmark(amount); } },
+			{ "thread-pool", [&]() { return perform_thread_pool_benchmark(amount); } },
+			{ "server-steps", [&]() { return perform_server_step_benchmark(amount); } },
+			{ "masterserver", [&]() { return perform_masterserver_benchmark(config, amount); } },
+			{ "visibility", [&]() { return perform_visibility_benchmark(lua, amount); } },
+			{ "sprite-vertices", [&]() { return perform_sprite_vertices_benchmark(lua, amount); } },
+			{ "reprediction-copy", [&]() { return perform_reprediction_copy_benchmark(lua, amount); } }
+		};
+
+		for (const auto& [name, run] : benchmarks) {
+			if (params.benchmark == name) {
+				return run() ? work_result::SUCCESS : work_result::FAILURE;
+			}
+		}
+
+		LOG("Unknown benchmark: --benchmark-%x", params.benchmark);
+		return work_result::FAILURE;
+	}
+
+	if (!params.measure_demo_steps.empty()) {
+		if (perform_step_coding_measurement(params.measure_demo_steps)) {
+			return work_result::SUCCESS;
+		}
+
+		return work_result::FAILURE;
+	}
+
+	if (params.test_authoritative_solve != -1) {
+		const auto steps = static_cast<unsigned>(params.test_authoritative_solve);
+
+		if (perform_authoritative_solve_test(lua, steps)) {
+			return work_result::SUCCESS;
+		}
+
+		return work_result::FAILURE;
+	}
+
 	LOG("Initializing ImGui.");
 
 	static const auto imgui_ini_path = std::string(USER_FILES_DIR) + "/" + get_preffix_for(current_app_type) + "imgui.ini";
@@ -438,6 +494,61 @@ work_result work(const int argc, const char* const * const argv) try {
 		return work_result::SUCCESS;
 	}
 
+	if (params.type == app_type::SPECTATOR_RELAY) {
+#if BUILD_NETWORKING
+		auto relay_settings = config.spectator_relay;
+
+		if (params.should_connect && !params.connect_address.empty()) {
+			relay_settings.upstream.address = params.connect_address;
+		}
+
+		perform_spectator_relay(lua, relay_settings);
+
+		return work_result::SUCCESS;
+#else
+		LOG("The spectator relay requires BUILD_NETWORKING.");
+		return work_result::FAILURE;
+#endif
+	}
+
+	if (params.load_test_clients != -1) {
+#if BUILD_NETWORKING
+		auto swarm_settings = config.load_test_swarm;
+
+		if (params.load_test_clients > 0) {
+			swarm_settings.num_clients = static_cast<unsigned>(params.load_test_clients);
+		}
+
+		if (params.should_connect && !params.connect_address.empty()) {
+			swarm_settings.target.address = params.connect_address;
+		}
+
+		if (perform_load_test_swarm(lua, config, swarm_settings)) {
+			return work_result::SUCCESS;
+		}
+
+		return work_result::FAILURE;
+#else
+		LOG("The load test requires BUILD_NETWORKING.");
+		return work_result::FAILURE;
+#endif
+	}
+
+	if (params.test_spectator_relay != -1) {
+#if BUILD_NETWORKING
+		const auto steps = static_cast<unsigned>(params.test_spectator_relay);
+
+		if (perform_spectator_relay_test(lua, config, steps)) {
+			return work_result::SUCCESS;
+		}
+
+		return work_result::FAILURE;
+#else
+		LOG("The spectator relay test requires BUILD_NETWORKING.");
+		return work_result::FAILURE;
+#endif
+	}
+
 	static auto chosen_server_port = [](){
 		return config.default_server_start.port;
 	};
@@ -616,26 +727,127 @@ work_result work(const int argc, const char* const * const argv) try {
 
 		auto& server = std::get<server_setup>(*current_setup);
 
-		while (server.is_running()) {
+		const auto num_arenas = std::max(1u, config.dedicated_server.num_arenas);
+
+		if (num_arenas == 1) {
+			while (server.is_running()) {
+				const auto zoom = 1.f;
+
+				if (handle_sigint()) {
+					return work_result::SUCCESS;
+				}
+
+				server.advance(
+					{
+						vec2i(),
+						config.input,
+						zoom,
+						get_detected_nat(),
+						network_performance,
+						server_stats
+					},
+					solver_callbacks()
+				);
+
+				server.sleep_until_next_tick();
+			}
+
+			return work_result::SUCCESS;
+		}
+
+		/*
+			Host the additional arenas at the consecutive ports.
+			They share this thread, the Lua state and the pool of logic workers.
+			Arenas on the same map also share the common significant state and logical assets.
+		*/
+
+		auto shared_logic_pool = augs::thread_pool(config.server.logic_workers);
+
+		std::vector<server_setup*> arenas = { std::addressof(server) };
+		std::vector<std::unique_ptr<server_setup>> additional_arenas;
+
+		for (unsigned i = 1; i < num_arenas; ++i) {
+			auto additional_start = start;
+			additional_start.port = static_cast<port_type>(bound_port + i);
+
+			LOG("Starting an additional arena at port: %x", additional_start.port);
+
+			additional_arenas.emplace_back(std::make_unique<server_setup>(
+				lua,
+				additional_start,
+				config.server,
+				config.server_solvable,
+				config.client,
+				config.private_server,
+				config.dedicated_server,
+
+				make_server_nat_traversal_input()
+			));
+
+			arenas.push_back(additional_arenas.back().get());
+		}
+
+		if (config.server.logic_workers > 0) {
+			LOG("Arenas share %x logic workers.", config.server.logic_workers);
+		}
+
+		const auto inv_tickrate = server.get_inv_tickrate();
+
+		for (unsigned i = 0; i < num_arenas; ++i) {
+			auto& arena = *arenas[i];
+
+			if (config.server.logic_workers > 0) {
+				arena.share_logic_pool(shared_logic_pool);
+			}
+
+			/* Spread the ticks evenly so that the arenas do not all wake up at once. */
+			arena.offset_ticks_by(inv_tickrate * i / num_arenas);
+
+			std::vector<const server_setup*> other_arenas;
+
+			for (const auto* const other : arenas) {
+				if (other != std::addressof(arena)) {
+					other_arenas.push_back(other);
+				}
+			}
+
+			arena.share_common_significant_with(std::move(other_arenas));
+		}
+
+		auto any_running = [&]() {
+			return std::any_of(arenas.begin(), arenas.end(), [](const auto* a) { return a->is_running(); });
+		};
+
+		while (any_running()) {
 			const auto zoom = 1.f;
 
 			if (handle_sigint()) {
 				return work_result::SUCCESS;
 			}
 
-			server.advance(
-				{
-					vec2i(),
-					config.input,
-					zoom,
-					get_detected_nat(),
-					network_performance,
-					server_stats
-				},
-				solver_callbacks()
-			);
+			auto next_tick_time = std::numeric_limits<net_time_t>::max();
+
+			for (auto* arena : arenas) {
+				if (!arena->is_running()) {
+					continue;
+				}
+
+				arena->advance(
+					{
+						vec2i(),
+						config.input,
+						zoom,
+						get_detected_nat(),
+						network_performance,
+						server_stats
+					},
+					solver_callbacks()
+				);
+
+				next_tick_time = std::min(next_tick_time, arena->get_next_tick_time());
+			}
 
-			server.sleep_until_next_tick();
+			server_setup::sleep_until(next_tick_time, config.server.sleep_mult);
 		}
 #endif
 
@@ -2082,6 +2294,7 @@ work_result work(const int argc, const char* const * const argv) try {
 	ImGui::GetIO().MousePos = { 0, 0 };
 
 	static cached_visibility_data cached_visibility;
+	static static_layers_cache static_layers;
 	static debug_details_summaries debug_summaries;
 
 	static auto game_thread_worker = []() {
@@ -2759,6 +2972,7 @@ work_result work(const int argc, const char* const * const argv) try {
 					special_indicators,
 					indicator_meta,
 					write_buffer.particle_buffers,
+					static_layers,
 					cached_visibility.light_requests,
 					thread_pool
 				};
@@ -2946,6 +3160,16 @@ work_result work(const int argc, const char* const * const argv) try {
 				);
 			};
 
+			if (non_zero_cosmos) {
+				static_layers.update({
+					viewed_cosmos,
+					streaming.images_in_atlas,
+					streaming.images_in_atlas_revision,
+					get_audiovisuals().randomizing,
+					get_audiovisuals().get<interpolation_system>()
+				});
+			}
+
 			const auto illuminated_input = make_illuminated_rendering_input(get_general_renderer(), new_viewing_config);
 
 			auto illuminated_rendering_job = [&]() {